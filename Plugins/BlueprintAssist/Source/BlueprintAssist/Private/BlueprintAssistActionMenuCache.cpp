@@ -0,0 +1,174 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "BlueprintAssistActionMenuCache.h"
+
+#if BA_UE_VERSION_OR_LATER(5, 1)
+
+#include "BlueprintActionDatabase.h"
+#include "Editor.h"
+#include "BlueprintAssistWidgets/BABlueprintActionMenu.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphSchema.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Misc/LazySingleton.h"
+
+FBAActionMenuContext::FBAActionMenuContext(UEdGraph* InGraph, UEdGraphPin* InPin, bool bInContextSensitive)
+{
+	bContextSensitive = bInContextSensitive;
+
+	if (InGraph)
+	{
+		Blueprint = FBlueprintEditorUtils::FindBlueprintForGraph(InGraph);
+
+		if (const UEdGraphSchema* Schema = InGraph->GetSchema())
+		{
+			GraphType = Schema->GetGraphType(InGraph);
+		}
+
+		if (GraphType != GT_Ubergraph)
+		{
+			Graph = InGraph;
+		}
+	}
+
+	if (InPin)
+	{
+		bHasPin = true;
+		PinNode = InPin->GetOwningNode();
+		PinId = InPin->PinId;
+		PinType = InPin->PinType;
+		PinDirection = InPin->Direction;
+	}
+}
+
+bool FBAActionMenuContext::operator==(const FBAActionMenuContext& Other) const
+{
+	return Blueprint == Other.Blueprint
+		&& Graph == Other.Graph
+		&& GraphType == Other.GraphType
+		&& bHasPin == Other.bHasPin
+		&& (!bHasPin || (PinNode == Other.PinNode && PinId == Other.PinId && PinType == Other.PinType && PinDirection == Other.PinDirection))
+		&& bContextSensitive == Other.bContextSensitive;
+}
+
+FBAActionMenuCache& FBAActionMenuCache::Get()
+{
+	return TLazySingleton<FBAActionMenuCache>::Get();
+}
+
+void FBAActionMenuCache::TearDown()
+{
+	TLazySingleton<FBAActionMenuCache>::TearDown();
+}
+
+void FBAActionMenuCache::Init()
+{
+	if (GEditor)
+	{
+		GEditor->OnBlueprintCompiled().AddRaw(this, &FBAActionMenuCache::OnBlueprintCompiled);
+	}
+
+	FModuleManager::Get().OnModulesChanged().AddRaw(this, &FBAActionMenuCache::OnModulesChanged);
+}
+
+void FBAActionMenuCache::BindActionDatabase()
+{
+	if (bBoundActionDatabase)
+	{
+		return;
+	}
+
+	// the database is created by the first menu build, until then there is nothing cached to invalidate
+	if (FBlueprintActionDatabase* ActionDatabase = FBlueprintActionDatabase::TryGet())
+	{
+		ActionDatabase->OnEntryUpdated().AddRaw(this, &FBAActionMenuCache::OnActionDatabaseEntryChanged);
+		ActionDatabase->OnEntryRemoved().AddRaw(this, &FBAActionMenuCache::OnActionDatabaseEntryChanged);
+		bBoundActionDatabase = true;
+	}
+}
+
+void FBAActionMenuCache::Cleanup()
+{
+	if (GEditor)
+	{
+		GEditor->OnBlueprintCompiled().RemoveAll(this);
+	}
+
+	FModuleManager::Get().OnModulesChanged().RemoveAll(this);
+
+	if (FBlueprintActionDatabase* ActionDatabase = FBlueprintActionDatabase::TryGet())
+	{
+		ActionDatabase->OnEntryUpdated().RemoveAll(this);
+		ActionDatabase->OnEntryRemoved().RemoveAll(this);
+	}
+
+	bBoundActionDatabase = false;
+	Entries.Empty();
+}
+
+TSharedPtr<const FBAActionMenuCache::FItemArray> FBAActionMenuCache::FindItems(const FBAActionMenuContext& Context)
+{
+	BindActionDatabase();
+
+	const int32 Index = Entries.IndexOfByPredicate([&Context](const FEntry& Entry) { return Entry.Context == Context; });
+	if (Index == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	// the blueprint, graph or pin node was destroyed, its actions may refer to it
+	if (!Context.Blueprint.IsValid() || (Context.GraphType != GT_Ubergraph && !Context.Graph.IsValid()) || (Context.bHasPin && !Context.PinNode.IsValid()))
+	{
+		Entries.RemoveAt(Index);
+		return nullptr;
+	}
+
+	FEntry Entry = Entries[Index];
+	Entries.RemoveAt(Index);
+	Entries.Add(Entry);
+
+	return Entry.Items;
+}
+
+void FBAActionMenuCache::AddItems(const FBAActionMenuContext& Context, TSharedRef<const FItemArray> Items)
+{
+	BindActionDatabase();
+
+	Entries.RemoveAll([&Context](const FEntry& Entry) { return Entry.Context == Context; });
+
+	if (Entries.Num() >= MaxEntries)
+	{
+		Entries.RemoveAt(0);
+	}
+
+	Entries.Add({ Context, Items });
+}
+
+void FBAActionMenuCache::Invalidate()
+{
+	if (Entries.Num() > 0)
+	{
+		UE_LOG(LogBlueprintAssist, Verbose, TEXT("Invalidated %d cached action menus"), Entries.Num());
+		Entries.Reset();
+	}
+}
+
+void FBAActionMenuCache::OnBlueprintCompiled()
+{
+	// any blueprint can add actions to other blueprints (functions, variables, events), so invalidate everything
+	Invalidate();
+}
+
+void FBAActionMenuCache::OnModulesChanged(FName ModuleName, EModuleChangeReason Reason)
+{
+	Invalidate();
+}
+
+void FBAActionMenuCache::OnActionDatabaseEntryChanged(UObject* ActionKey)
+{
+	// removed entries may destroy the node spawners referenced by our cached actions
+	Invalidate();
+}
+
+#endif
@@ -0,0 +1,335 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "BlueprintAssistAssetIndex.h"
+
+#include "BlueprintAssistGlobals.h"
+#include "BlueprintAssistMisc/BASearchIndex.h"
+#include "Async/Async.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "BlueprintAssistWidgets/BlueprintAssistOpenFileMenu.h"
+#include "Misc/LazySingleton.h"
+#include "Modules/ModuleManager.h"
+
+struct FBAPendingAssetEvent
+{
+	/* Removed first, empty if the event only adds an asset */
+	FString RemovedObjectPath;
+
+	/* Added after the removal, invalid if the event only removes an asset */
+	FAssetData AddedAsset;
+};
+
+FBAAssetIndex& FBAAssetIndex::Get()
+{
+	return TLazySingleton<FBAAssetIndex>::Get();
+}
+
+void FBAAssetIndex::TearDown()
+{
+	TLazySingleton<FBAAssetIndex>::TearDown();
+}
+
+void FBAAssetIndex::Init()
+{
+	BuildToken = MakeShared<int32>(0);
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.OnAssetAdded().AddRaw(this, &FBAAssetIndex::OnAssetAdded);
+	AssetRegistry.OnAssetRemoved().AddRaw(this, &FBAAssetIndex::OnAssetRemoved);
+	AssetRegistry.OnAssetRenamed().AddRaw(this, &FBAAssetIndex::OnAssetRenamed);
+
+	if (AssetRegistry.IsLoadingAssets())
+	{
+		AssetRegistry.OnFilesLoaded().AddRaw(this, &FBAAssetIndex::OnFilesLoaded);
+	}
+	else
+	{
+		StartBackgroundBuild();
+	}
+}
+
+void FBAAssetIndex::Cleanup()
+{
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnFilesLoaded().RemoveAll(this);
+		AssetRegistry.OnAssetAdded().RemoveAll(this);
+		AssetRegistry.OnAssetRemoved().RemoveAll(this);
+		AssetRegistry.OnAssetRenamed().RemoveAll(this);
+	}
+
+	// any background build still running will discard its result
+	BuildToken.Reset();
+
+	ItemIndices.Empty();
+	ItemObjectPaths.Empty();
+	Items.Reset();
+	SearchIndex.Reset();
+	PendingEvents.Empty();
+	bBuilt = false;
+	bBuildInProgress = false;
+}
+
+TSharedRef<const FBAAssetIndex::FItemArray> FBAAssetIndex::GetItems()
+{
+	if (!bBuilt)
+	{
+		// the menu was opened before the background build finished, build the index now and ignore the background result
+		if (BuildToken.IsValid())
+		{
+			++(*BuildToken);
+		}
+
+		TArray<FAssetData> Assets;
+		IAssetRegistry::GetChecked().GetAllAssets(Assets, false);
+
+		FBuiltItems BuiltItems;
+		BuildItems(Assets, BuiltItems);
+		ApplyBuiltItems(MoveTemp(BuiltItems));
+
+		PendingEvents.Reset();
+		bBuildInProgress = false;
+		bBuilt = true;
+	}
+
+	return Items.ToSharedRef();
+}
+
+TSharedRef<FBASearchIndex> FBAAssetIndex::GetSearchIndex()
+{
+	TSharedRef<const FItemArray> CurrentItems = GetItems();
+
+	// the index is reset whenever the items change, the trigrams are built by the first search
+	if (!SearchIndex.IsValid())
+	{
+		SearchIndex = MakeShared<FBASearchIndex>();
+		SearchIndex->Reset(CurrentItems->Num());
+		for (const TSharedPtr<FBAFileItem>& Item : *CurrentItems)
+		{
+			SearchIndex->AddItem(Item->GetSearchText(), Item->GetKeySearchText());
+		}
+	}
+
+	return SearchIndex.ToSharedRef();
+}
+
+void FBAAssetIndex::OnFilesLoaded()
+{
+	IAssetRegistry::GetChecked().OnFilesLoaded().RemoveAll(this);
+	StartBackgroundBuild();
+}
+
+void FBAAssetIndex::StartBackgroundBuild()
+{
+	if (bBuilt || bBuildInProgress || !BuildToken.IsValid())
+	{
+		return;
+	}
+
+	bBuildInProgress = true;
+
+	const int32 Generation = ++(*BuildToken);
+	TWeakPtr<int32> WeakToken = BuildToken;
+
+#if BA_UE_VERSION_OR_LATER(5, 0)
+	// the asset registry can be queried from any thread, so gather the assets in the background too
+	Async(EAsyncExecution::ThreadPool, [WeakToken, Generation]()
+	{
+		TArray<FAssetData> Assets;
+		IAssetRegistry::GetChecked().GetAllAssets(Assets, false);
+		BuildInBackground(Assets, WeakToken, Generation);
+	});
+#else
+	TArray<FAssetData> GameThreadAssets;
+	IAssetRegistry::GetChecked().GetAllAssets(GameThreadAssets, false);
+
+	Async(EAsyncExecution::ThreadPool, [WeakToken, Generation, Assets = MoveTemp(GameThreadAssets)]()
+	{
+		BuildInBackground(Assets, WeakToken, Generation);
+	});
+#endif
+}
+
+void FBAAssetIndex::BuildInBackground(const TArray<FAssetData>& Assets, TWeakPtr<int32> WeakToken, int32 Generation)
+{
+	FBuiltItems BuiltItems;
+	BuildItems(Assets, BuiltItems);
+
+	AsyncTask(ENamedThreads::GameThread, [WeakToken, Generation, BuiltItems = MoveTemp(BuiltItems)]() mutable
+	{
+		TSharedPtr<int32> Token = WeakToken.Pin();
+		if (Token.IsValid() && *Token == Generation)
+		{
+			FBAAssetIndex::Get().OnBackgroundBuildFinished(MoveTemp(BuiltItems));
+		}
+	});
+}
+
+void FBAAssetIndex::OnBackgroundBuildFinished(FBuiltItems&& BuiltItems)
+{
+	ApplyBuiltItems(MoveTemp(BuiltItems));
+	bBuildInProgress = false;
+	bBuilt = true;
+
+	// apply the changes which happened during the build, in case the gathered assets did not include them
+	for (const FBAPendingAssetEvent& Event : PendingEvents)
+	{
+		if (!Event.RemovedObjectPath.IsEmpty())
+		{
+			RemoveAsset(Event.RemovedObjectPath);
+		}
+
+		if (Event.AddedAsset.IsValid())
+		{
+			AddAsset(Event.AddedAsset);
+		}
+	}
+
+	PendingEvents.Empty();
+
+	UE_LOG(LogBlueprintAssist, Verbose, TEXT("Built asset index with %d items"), ItemIndices.Num());
+}
+
+void FBAAssetIndex::ApplyBuiltItems(FBuiltItems&& BuiltItems)
+{
+	ItemIndices = MoveTemp(BuiltItems.Indices);
+	ItemObjectPaths = MoveTemp(BuiltItems.ObjectPaths);
+	Items = MakeShared<FItemArray>(MoveTemp(BuiltItems.Items));
+	SearchIndex.Reset();
+}
+
+FBAAssetIndex::FItemArray& FBAAssetIndex::GetMutableItems()
+{
+	// the search index refers to the items by their order, so it is rebuilt by the next menu
+	SearchIndex.Reset();
+
+	// an open menu still holds the current items, copy them so the menu's list doesn't change under it
+	if (!Items.IsValid())
+	{
+		Items = MakeShared<FItemArray>();
+	}
+	else if (!Items.IsUnique())
+	{
+		Items = MakeShared<FItemArray>(*Items);
+	}
+
+	return *Items;
+}
+
+void FBAAssetIndex::OnAssetAdded(const FAssetData& AssetData)
+{
+	// the initial scan adds every asset, these are picked up by the build
+	if (!bBuilt && !bBuildInProgress)
+	{
+		return;
+	}
+
+	if (bBuildInProgress)
+	{
+		PendingEvents.Add({ FString(), AssetData });
+		return;
+	}
+
+	AddAsset(AssetData);
+}
+
+void FBAAssetIndex::OnAssetRemoved(const FAssetData& AssetData)
+{
+	if (bBuildInProgress)
+	{
+		PendingEvents.Add({ GetObjectPath(AssetData), FAssetData() });
+		return;
+	}
+
+	RemoveAsset(GetObjectPath(AssetData));
+}
+
+void FBAAssetIndex::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	if (bBuildInProgress)
+	{
+		PendingEvents.Add({ OldObjectPath, AssetData });
+		return;
+	}
+
+	RemoveAsset(OldObjectPath);
+	AddAsset(AssetData);
+}
+
+void FBAAssetIndex::AddAsset(const FAssetData& AssetData)
+{
+	if (!bBuilt || !ShouldIndexAsset(AssetData))
+	{
+		return;
+	}
+
+	FItemArray& MutableItems = GetMutableItems();
+	TSharedPtr<FBAFileItem> Item = MakeShared<FBAFileItem>(AssetData.AssetName.ToString());
+
+	const FString ObjectPath = GetObjectPath(AssetData);
+	if (const int32* ExistingIndex = ItemIndices.Find(ObjectPath))
+	{
+		MutableItems[*ExistingIndex] = Item;
+		return;
+	}
+
+	ItemIndices.Add(ObjectPath, MutableItems.Add(Item));
+	ItemObjectPaths.Add(ObjectPath);
+}
+
+void FBAAssetIndex::RemoveAsset(const FString& ObjectPath)
+{
+	int32 Index;
+	if (!ItemIndices.RemoveAndCopyValue(ObjectPath, Index))
+	{
+		return;
+	}
+
+	// swap the last item into the removed slot and update its index
+	GetMutableItems().RemoveAtSwap(Index);
+	ItemObjectPaths.RemoveAtSwap(Index);
+	if (ItemObjectPaths.IsValidIndex(Index))
+	{
+		ItemIndices.Add(ItemObjectPaths[Index], Index);
+	}
+}
+
+bool FBAAssetIndex::ShouldIndexAsset(const FAssetData& AssetData)
+{
+	return !AssetData.IsRedirector() && AssetData.IsUAsset();
+}
+
+FString FBAAssetIndex::GetObjectPath(const FAssetData& AssetData)
+{
+#if BA_UE_VERSION_OR_LATER(5, 1)
+	return AssetData.GetObjectPathString();
+#else
+	return AssetData.ObjectPath.ToString();
+#endif
+}
+
+void FBAAssetIndex::BuildItems(const TArray<FAssetData>& Assets, FBuiltItems& OutItems)
+{
+	OutItems.Indices.Reserve(Assets.Num());
+	OutItems.ObjectPaths.Reserve(Assets.Num());
+	OutItems.Items.Reserve(Assets.Num());
+
+	for (const FAssetData& AssetData : Assets)
+	{
+		if (!ShouldIndexAsset(AssetData))
+		{
+			continue;
+		}
+
+		FString ObjectPath = GetObjectPath(AssetData);
+		if (OutItems.Indices.Contains(ObjectPath))
+		{
+			continue;
+		}
+
+		OutItems.Indices.Add(ObjectPath, OutItems.Items.Add(MakeShared<FBAFileItem>(AssetData.AssetName.ToString())));
+		OutItems.ObjectPaths.Add(MoveTemp(ObjectPath));
+	}
+}
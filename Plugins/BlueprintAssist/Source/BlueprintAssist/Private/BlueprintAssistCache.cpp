@@ -4,6 +4,7 @@
 
 #include "BlueprintAssistGlobals.h"
 #include "BlueprintAssistModule.h"
+#include "BlueprintAssistNodeSizeChangeData.h"
 #include "BlueprintAssistSettings.h"
 #include "BlueprintAssistSettings_Advanced.h"
 #include "BlueprintAssistUtils.h"
@@ -103,6 +104,8 @@ void FBACache::LoadCache()
 	{
 		// clear the cache if our version doesn't match
 		CacheData.PackageData.Empty();
+		CacheData.BlueprintSymbols.Empty();
+		CacheData.NodeShapes.Empty();
 
 		CacheData.CacheVersion = CACHE_VERSION;
 	}
@@ -140,6 +143,8 @@ void FBACache::DeleteCache()
 {
 	FString CachePath = GetCachePath();
 	CacheData.PackageData.Empty();
+	CacheData.BlueprintSymbols.Empty();
+	CacheData.NodeShapes.Empty();
 
 	if (FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*CachePath))
 	{
@@ -185,6 +190,98 @@ void FBACache::CleanupFiles()
 			CacheData.PackageData.Remove(PackageGuid);
 		}
 	}
+
+	TArray<FName> SymbolPackageNames;
+	CacheData.BlueprintSymbols.GetKeys(SymbolPackageNames);
+	for (FName PackageName : SymbolPackageNames)
+	{
+		if (!CurrentPackageNames.Contains(PackageName))
+		{
+			CacheData.BlueprintSymbols.Remove(PackageName);
+		}
+	}
+
+	// Remove shapes no longer used by any node
+	TSet<FGuid> UsedShapes;
+	for (const TPair<FName, FBAPackageData>& PackageElem : CacheData.PackageData)
+	{
+		for (const TPair<FGuid, FBAGraphData>& GraphElem : PackageElem.Value.GraphData)
+		{
+			for (const TPair<FGuid, FBANodeData>& NodeElem : GraphElem.Value.NodeData)
+			{
+				if (NodeElem.Value.Shape.IsValid())
+				{
+					UsedShapes.Add(NodeElem.Value.Shape);
+				}
+			}
+		}
+	}
+
+	for (auto It = CacheData.NodeShapes.CreateIterator(); It; ++It)
+	{
+		if (!UsedShapes.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FBACache::ShareNodeShape(UEdGraphNode* Node, FBANodeData& NodeData)
+{
+	if (!UBASettings_Advanced::Get().bShareNodeSizesBetweenIdenticalNodes || NodeData.Shape.IsValid() || !NodeData.HasSize())
+	{
+		return;
+	}
+
+	const FGuid Shape = FBANodeSizeChangeData::GetNodeShape(Node);
+	if (!Shape.IsValid())
+	{
+		return;
+	}
+
+	FBANodeShapeData NodeShape;
+	NodeShape.SizeX = NodeData.SizeX;
+	NodeShape.SizeY = NodeData.SizeY;
+	NodeShape.PinOffsets.Reserve(Node->Pins.Num());
+	for (UEdGraphPin* Pin : Node->Pins)
+	{
+		NodeShape.PinOffsets.Add(NodeData.CachedPins.FindRef(Pin->PinId));
+	}
+
+	if (FBANodeShapeData* FoundShape = CacheData.NodeShapes.Find(Shape))
+	{
+		// the fresh measurement wins (e.g. the editor style changed), every node sharing the shape picks up the new size
+		if (!FoundShape->Matches(NodeShape))
+		{
+			UE_LOG(LogBlueprintAssist, Verbose, TEXT("Replaced shared node shape %s measured by %s"), *Shape.ToString(), *FBAUtils::GetNodeName(Node));
+			*FoundShape = MoveTemp(NodeShape);
+		}
+	}
+	else
+	{
+		CacheData.NodeShapes.Add(Shape, MoveTemp(NodeShape));
+	}
+
+	NodeData.ResetSize();
+	NodeData.Shape = Shape;
+}
+
+bool FBACache::TryApplyNodeShape(UEdGraphNode* Node, FBANodeData& NodeData)
+{
+	if (!UBASettings_Advanced::Get().bShareNodeSizesBetweenIdenticalNodes)
+	{
+		return false;
+	}
+
+	const FGuid Shape = FBANodeSizeChangeData::GetNodeShape(Node);
+	if (!Shape.IsValid() || !CacheData.NodeShapes.Contains(Shape))
+	{
+		return false;
+	}
+
+	NodeData.ResetSize();
+	NodeData.Shape = Shape;
+	return true;
 }
 
 FBAGraphData& FBACache::GetGraphData(UEdGraph* Graph)
@@ -268,9 +365,13 @@ void FBACache::SaveGraphDataToPackageMetaData(UEdGraph* Graph)
 			FBAGraphData& GraphData = GetGraphData(Graph);
 
 			GraphData.CleanupGraph(Graph);
+
+			// the shape table is only stored in the cache file
+			FBAGraphData ExpandedGraphData = GraphData;
+			ExpandedGraphData.ExpandNodeShapes(Graph);
 			
 			FString GraphDataAsString;
-			if (FJsonObjectConverter::UStructToJsonObjectString(GraphData, GraphDataAsString))
+			if (FJsonObjectConverter::UStructToJsonObjectString(ExpandedGraphData, GraphDataAsString))
 			{
 				MetaData->SetValue(Graph, NAME_BA_GRAPH_DATA, *GraphDataAsString);
 			}
@@ -375,6 +476,86 @@ FBANodeData& FBAGraphData::GetNodeData(UEdGraphNode* Node)
 	return NodeData.FindOrAdd(FBAUtils::GetNodeGuid(Node));
 }
 
+void FBAGraphData::ExpandNodeShapes(UEdGraph* Graph)
+{
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		FBANodeData* FoundNode = NodeData.Find(FBAUtils::GetNodeGuid(Node));
+		const FBANodeShapeData* NodeShape = FoundNode ? FoundNode->FindShape() : nullptr;
+		if (!NodeShape || NodeShape->PinOffsets.Num() != Node->Pins.Num())
+		{
+			continue;
+		}
+
+		FoundNode->ResetSize();
+		FoundNode->SizeX = NodeShape->SizeX;
+		FoundNode->SizeY = NodeShape->SizeY;
+		for (int32 i = 0; i < Node->Pins.Num(); ++i)
+		{
+			FoundNode->CachedPins.Add(Node->Pins[i]->PinId, NodeShape->PinOffsets[i]);
+		}
+	}
+}
+
+bool FBANodeShapeData::Matches(const FBANodeShapeData& Other) const
+{
+	if (SizeX != Other.SizeX || SizeY != Other.SizeY || PinOffsets.Num() != Other.PinOffsets.Num())
+	{
+		return false;
+	}
+
+	for (int32 i = 0; i < PinOffsets.Num(); ++i)
+	{
+		if (!FMath::IsNearlyEqual(PinOffsets[i], Other.PinOffsets[i], 0.5f))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool FBANodeData::HasSize() const
+{
+	return (SizeX != 0 && SizeY != 0) || FindShape() != nullptr;
+}
+
+FVector2D FBANodeData::GetSize() const
+{
+	if (const FBANodeShapeData* NodeShape = FindShape())
+	{
+		return FVector2D(NodeShape->SizeX, NodeShape->SizeY);
+	}
+
+	return FVector2D(SizeX, SizeY);
+}
+
+bool FBANodeData::FindPinOffset(const UEdGraphPin* Pin, float& OutOffset) const
+{
+	if (const float* FoundPinOffset = CachedPins.Find(Pin->PinId))
+	{
+		OutOffset = *FoundPinOffset;
+		return true;
+	}
+
+	if (const FBANodeShapeData* NodeShape = FindShape())
+	{
+		const int32 PinIndex = Pin->GetOwningNode()->Pins.IndexOfByKey(Pin);
+		if (NodeShape->PinOffsets.IsValidIndex(PinIndex))
+		{
+			OutOffset = NodeShape->PinOffsets[PinIndex];
+			return true;
+		}
+	}
+
+	return false;
+}
+
+const FBANodeShapeData* FBANodeData::FindShape() const
+{
+	return Shape.IsValid() ? FBACache::Get().FindNodeShape(Shape) : nullptr;
+}
+
 #if BA_UE_VERSION_OR_LATER(5, 0)
 void FBACache::OnObjectPreSave(UObject* Object, FObjectPreSaveContext Context)
 {
@@ -0,0 +1,106 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "BlueprintAssistFormatters/BANodeGeometry.h"
+
+#include "BlueprintAssistCache.h"
+#include "BlueprintAssistUtils.h"
+#include "EdGraph/EdGraphNode.h"
+
+FSlateRect FBANodeGeometryUtils::GetNodeBounds(IBANodeGeometry& Geometry, UEdGraphNode* Node, bool bWithCommentBubble)
+{
+	if (!Node)
+	{
+		return FSlateRect();
+	}
+
+	FVector2D Pos(Node->NodePosX, Node->NodePosY);
+
+	FVector2D Size(300, 150);
+	if (FBAUtils::IsKnotNode(Node))
+	{
+		Size = FBAUtils::GetKnotNodeSize();
+	}
+	else
+	{
+		Geometry.GetNodeSize(Node, Size);
+	}
+
+	// skip comment bubbles since when we access this function for comments, we are actually grabbing the title bar bounds
+	if (bWithCommentBubble && Node->bCommentBubbleVisible && !FBAUtils::IsCommentNode(Node))
+	{
+		FVector2D CommentBubbleSize;
+		if (Geometry.GetCommentBubbleSize(Node, CommentBubbleSize))
+		{
+			Pos.Y -= CommentBubbleSize.Y;
+			Size.Y += CommentBubbleSize.Y;
+			Size.X = FMath::Max(Size.X, CommentBubbleSize.X);
+		}
+	}
+
+	return FSlateRect::FromPointAndExtent(Pos, Size);
+}
+
+float FBANodeGeometryUtils::GetPinY(IBANodeGeometry& Geometry, const UEdGraphPin* Pin)
+{
+	if (!Pin)
+	{
+		return 0;
+	}
+
+	UEdGraphNode* OwningNode = Pin->GetOwningNode();
+	if (!OwningNode)
+	{
+		return 0;
+	}
+
+	float PinOffset = 0;
+	Geometry.GetPinOffset(Pin, PinOffset);
+	return OwningNode->NodePosY + PinOffset;
+}
+
+FVector2D FBANodeGeometryUtils::GetPinPos(IBANodeGeometry& Geometry, const UEdGraphPin* Pin)
+{
+	if (!Pin)
+	{
+		return FVector2D::ZeroVector;
+	}
+
+	const FSlateRect NodeBounds = GetNodeBounds(Geometry, Pin->GetOwningNode(), false);
+	return FVector2D(Pin->Direction == EGPD_Input ? NodeBounds.Left : NodeBounds.Right, GetPinY(Geometry, Pin));
+}
+
+const FBAGraphData* FBACachedNodeGeometry::GetGraphData() const
+{
+	UEdGraph* EdGraph = Graph.Get();
+	return EdGraph ? &FBACache::Get().GetGraphData(EdGraph) : nullptr;
+}
+
+bool FBACachedNodeGeometry::GetNodeSize(UEdGraphNode* Node, FVector2D& OutSize)
+{
+	const FBAGraphData* GraphData = GetGraphData();
+	if (!GraphData)
+	{
+		return false;
+	}
+
+	const FBANodeData* NodeData = GraphData->NodeData.Find(FBAUtils::GetNodeGuid(Node));
+	if (!NodeData || !NodeData->HasSize())
+	{
+		return false;
+	}
+
+	OutSize = NodeData->GetSize();
+	return true;
+}
+
+bool FBACachedNodeGeometry::GetPinOffset(const UEdGraphPin* Pin, float& OutOffset)
+{
+	const FBAGraphData* GraphData = GetGraphData();
+	if (!GraphData)
+	{
+		return false;
+	}
+
+	const FBANodeData* NodeData = GraphData->NodeData.Find(FBAUtils::GetNodeGuid(Pin->GetOwningNode()));
+	return NodeData && NodeData->FindPinOffset(Pin, OutOffset);
+}
@@ -0,0 +1,88 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "BlueprintAssistFormatters/BANodePositionBuffer.h"
+
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+
+bool FBANodePositionBuffer::Begin(UEdGraph* Graph)
+{
+	if (bActive || !Graph)
+	{
+		return false;
+	}
+
+	Reset();
+	bActive = true;
+
+	Nodes.Reserve(Graph->Nodes.Num());
+	StartPositions.Reserve(Graph->Nodes.Num());
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (Node)
+		{
+			Nodes.Add(Node);
+			StartPositions.Add(FIntPoint(Node->NodePosX, Node->NodePosY));
+		}
+	}
+
+	Committed.Init(false, Nodes.Num());
+	return true;
+}
+
+int32 FBANodePositionBuffer::Flush()
+{
+	if (!bActive)
+	{
+		return 0;
+	}
+
+	int32 NumModified = 0;
+	for (int32 i = 0; i < Nodes.Num(); ++i)
+	{
+		if (Committed[i])
+		{
+			continue;
+		}
+
+		UEdGraphNode* Node = Nodes[i].Get();
+		if (!Node)
+		{
+			continue;
+		}
+
+		const FIntPoint& StartPos = StartPositions[i];
+		const FIntPoint EndPos(Node->NodePosX, Node->NodePosY);
+		if (EndPos == StartPos)
+		{
+			continue;
+		}
+
+		// the transaction saves the node when it is modified, so modify it at the start position
+		Node->NodePosX = StartPos.X;
+		Node->NodePosY = StartPos.Y;
+		Node->Modify();
+		Node->NodePosX = EndPos.X;
+		Node->NodePosY = EndPos.Y;
+
+		Committed[i] = true;
+		++NumModified;
+	}
+
+	return NumModified;
+}
+
+int32 FBANodePositionBuffer::Commit()
+{
+	const int32 NumModified = Flush();
+	Reset();
+	return NumModified;
+}
+
+void FBANodePositionBuffer::Reset()
+{
+	Nodes.Reset();
+	StartPositions.Reset();
+	Committed.Reset();
+	bActive = false;
+}
@@ -19,7 +19,6 @@ FBehaviorTreeGraphFormatter::FBehaviorTreeGraphFormatter(
 void FBehaviorTreeGraphFormatter::FormatNode(UEdGraphNode* InNode)
 {
 	RootNode = InNode;
-	RootNode->Modify();
 
 	while (true)
 	{
@@ -357,7 +357,10 @@ void FBACommentContainsGraph::DrawBounds()
 			Ignored.Reset();
 			Param.Bounds = CommentBounds.GetValue();
 			Param.Color = FLinearColor::MakeRandomColor();
-			GraphHandler->GetGraphOverlay()->DrawBounds(Param);
+			if (auto Overlay = GraphHandler->GetGraphOverlay())
+			{
+				Overlay->DrawBounds(Param);
+			}
 		}
 	}
 }
@@ -452,7 +452,10 @@ void FCommentHandler::DrawBounds(const FLinearColor& Color)
 			FBAGraphOverlayBounds Params;
 			Params.Bounds = *Bounds;
 			Params.Color = Color;
-			GraphHandler->GetGraphOverlay()->DrawBounds(Params);
+			if (auto Overlay = GraphHandler->GetGraphOverlay())
+			{
+				Overlay->DrawBounds(Params);
+			}
 		}
 	}
 }
@@ -209,6 +209,7 @@ void FEdGraphFormatter::FormatNode(UEdGraphNode* InitialNode)
 		MainParameterFormatter = MakeShared<FEdGraphParameterFormatter>(GraphHandler, RootNode, SharedThis(this), NodeToKeepStill);
 		MainParameterFormatter->FormatNode(RootNode);
 		CommentHandler.BuildTree();
+		GraphHandler->GetNodePositionBuffer().Flush();
 		KnotTrackCreator.FormatKnotNodes();
 		return;
 	}
@@ -325,6 +326,8 @@ void FEdGraphFormatter::FormatNode(UEdGraphNode* InitialNode)
 	/** Format knot nodes */
 	if (UBASettings::Get().bCreateKnotNodes)
 	{
+		// the knot pass relinks pins which modifies the linked nodes, so modify the moved nodes at their start position first
+		GraphHandler->GetNodePositionBuffer().Flush();
 		KnotTrackCreator.FormatKnotNodes();
 
 		if (UBASettings::Get().bApplyCommentPadding && !UBASettings::HasDebugSetting("AfterKnots"))
@@ -364,10 +367,12 @@ void FEdGraphFormatter::FormatNode(UEdGraphNode* InitialNode)
 
 	if (bAreAllNodesSelected)
 	{
-		auto& SelectionManager = GraphHandler->GetGraphPanel()->SelectionManager;
-		for (auto Node : KnotTrackCreator.GetCreatedKnotNodes())
+		if (TSharedPtr<SGraphPanel> GraphPanel = GraphHandler->GetGraphPanel())
 		{
-			SelectionManager.SetNodeSelection(Node, true);
+			for (auto Node : KnotTrackCreator.GetCreatedKnotNodes())
+			{
+				GraphPanel->SelectionManager.SetNodeSelection(Node, true);
+			}
 		}
 	}
 
@@ -403,7 +408,6 @@ void FEdGraphFormatter::InitNodePool()
 	UEdGraphNode* RootNode = GetRootNode();
 
 	OutputNodeStack.Push(RootNode);
-	RootNode->Modify();
 
 	while (InputNodeStack.Num() > 0 || OutputNodeStack.Num() > 0)
 	{
@@ -446,8 +450,6 @@ void FEdGraphFormatter::InitNodePool()
 						continue;
 					}
 
-					LinkedNode->Modify();
-
 					FBAUtils::StraightenPin(GraphHandler, Pin, LinkedPin);
 
 					if (Dir == EGPD_Output)
@@ -709,7 +711,10 @@ void FEdGraphFormatter::DecideXParents(
 
 			if (BA_DEBUG("xPath") && bUseParameter)
 			{
-				GraphHandler->GetGraphOverlay()->DrawNodeInQueue(CurrentNode);
+				if (auto Overlay = GraphHandler->GetGraphOverlay())
+				{
+					Overlay->DrawNodeInQueue(CurrentNode);
+				}
 			}
 
 			FPinLink FirstInputLink;
@@ -1004,7 +1009,10 @@ TArray<FPinLink> FEdGraphFormatter::GetNodesToExpand()
 								// if (!CurrentInfo->Parent.IsValid() || LinkedNode != CurrentInfo->Parent->GetNode())
 								{
 									NodesToExpand.Add(CurrentInfo);
-									GraphHandler->GetGraphOverlay()->DrawNodeInQueue(CurrentInfo.GetNode());
+									if (auto Overlay = GraphHandler->GetGraphOverlay())
+									{
+										Overlay->DrawNodeInQueue(CurrentInfo.GetNode());
+									}
 								}
 							}
 						}
@@ -3298,10 +3306,13 @@ void FEdGraphFormatter::PostFormatting()
 
 	// draw path
 	// for (const FPinLink& Link : Path)
-	for (auto Node : NodePool)
+	if (auto Overlay = GraphHandler->GetGraphOverlay())
 	{
-		auto XInfo = GetFormatXInfo(Node);
-		GraphHandler->GetGraphOverlay()->DrawDebugPinLink("Path", XInfo->Link, FLinearColor::Green, 10.0f);
+		for (auto Node : NodePool)
+		{
+			auto XInfo = GetFormatXInfo(Node);
+			Overlay->DrawDebugPinLink("Path", XInfo->Link, FLinearColor::Green, 10.0f);
+		}
 	}
 }
 
@@ -601,8 +601,6 @@ void FEdGraphParameterFormatter::FormatX()
 			}
 			else
 			{
-				CurrentNode->Modify();
-
 				if (CurrentNode != RootNode)
 				{
 					FBAUtils::StraightenPin(GraphHandler, CurrentPinLink);
@@ -91,7 +91,10 @@ void FKnotTrackCreator::FormatKnotNodes()
 			// UE_LOG(LogKnotTrackCreator, Warning, TEXT("\t%s"), *Track->ToString());
 			if (UBASettings::HasDebugSetting("DebugTracks"))
 			{
-				GraphHandler->GetGraphOverlay()->DrawBounds(Track->GetTrackBounds(), Track->HasPinToAlignTo() ? FLinearColor::Yellow : FLinearColor::White);
+				if (auto Overlay = GraphHandler->GetGraphOverlay())
+				{
+					Overlay->DrawBounds(Track->GetTrackBounds(), Track->HasPinToAlignTo() ? FLinearColor::Yellow : FLinearColor::White);
+				}
 			}
 		}
 	}
@@ -1148,9 +1151,10 @@ void FKnotTrackCreator::AddNomadKnotsIntoComments()
 		const FMargin Padding = CommentHandler->GetCommentPadding(Comment);
 		FSlateRect CommentBounds = CommentHandler->GetCommentBounds(Comment).InsetBy(Padding);
 
-		if (UBASettings::HasDebugSetting("DebugNomadKnots"))
+		TSharedPtr<SBlueprintAssistGraphOverlay> DebugOverlay = UBASettings::HasDebugSetting("DebugNomadKnots") ? GraphHandler->GetGraphOverlay() : nullptr;
+		if (DebugOverlay)
 		{
-			GraphHandler->GetGraphOverlay()->DrawBounds(CommentBounds);
+			DebugOverlay->DrawBounds(CommentBounds);
 		}
 
 		for (TSharedPtr<FKnotNodeTrack> Track : KnotTracks)
@@ -1171,9 +1175,9 @@ void FKnotTrackCreator::AddNomadKnotsIntoComments()
 						// UE_LOG(LogTemp, Warning, TEXT("Added knot %s into %s"), *FBAUtils::GetNodeName(CreatedKnotNode), *FBAUtils::GetNodeName(Comment));
 						CommentHandler->AddNodeIntoComment(Comment, CreatedKnotNode);
 
-						if (UBASettings::HasDebugSetting("DebugNomadKnots"))
+						if (DebugOverlay)
 						{
-							GraphHandler->GetGraphOverlay()->DrawBounds(FSlateRect(KnotPos.X - 10.0f, KnotPos.Y - 10.0f, KnotPos.X + 10.0f, KnotPos.Y + 10.0f));
+							DebugOverlay->DrawBounds(FSlateRect(KnotPos.X - 10.0f, KnotPos.Y - 10.0f, KnotPos.X + 10.0f, KnotPos.Y + 10.0f));
 						}
 					}
 				}
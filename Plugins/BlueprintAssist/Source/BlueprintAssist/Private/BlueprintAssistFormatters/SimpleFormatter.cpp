@@ -309,7 +309,6 @@ void FSimpleFormatter::FormatX()
 		}
 
 		FormattedNodes.Add(CurrentNode);
-		CurrentNode->Modify();
 
 		// UE_LOG(LogBlueprintAssist, Warning, TEXT("Processing %s | %s"), *FBAUtils::GetNodeName(CurrentNode), *CurrentInfo->Link.ToString());
 		const int32 NewX = GetChildX(CurrentInfo->Link);
@@ -0,0 +1,31 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "BlueprintAssistFrameBudget.h"
+
+#include "HAL/PlatformTime.h"
+
+void FBAFrameBudget::BeginFrame(float BudgetMs)
+{
+	FrameStartTime = FPlatformTime::Seconds();
+	BudgetSeconds = BudgetMs / 1000.0;
+}
+
+bool FBAFrameBudget::HasTimeRemaining() const
+{
+	if (BudgetSeconds <= 0.0)
+	{
+		return true;
+	}
+
+	return (FPlatformTime::Seconds() - FrameStartTime) < BudgetSeconds;
+}
+
+float FBAPendingWorkProgress::GetSizeProgress() const
+{
+	if (InitialPendingSize > 0)
+	{
+		return 1.0f - (static_cast<float>(NumPendingSize) / static_cast<float>(InitialPendingSize));
+	}
+
+	return 0.0f;
+}
@@ -40,6 +40,8 @@
 #include "Misc/TransactionObjectEvent.h"
 #endif
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Redundant formats avoided"), STAT_GraphHandler_RedundantFormatsAvoided, STATGROUP_BA_EdGraphFormatter);
+
 FBAGraphHandler::FBAGraphHandler(
 	TWeakPtr<SDockTab> InTab,
 	TWeakPtr<SGraphEditor> InGraphEditor)
@@ -53,6 +55,21 @@ FBAGraphHandler::FBAGraphHandler(
 	check(GetWindow().IsValid());
 
 	FCoreUObjectDelegates::OnObjectTransacted.AddRaw(this, &FBAGraphHandler::OnObjectTransacted);
+	FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FBAGraphHandler::OnObjectModified);
+}
+
+FBAGraphHandler::FBAGraphHandler(UEdGraph* InGraph, TSharedRef<IBANodeGeometry> InGeometry)
+	: HeadlessGeometry(InGeometry)
+	, CachedEdGraph(InGraph)
+{
+	check(InGraph != nullptr);
+
+	NodeLookupCache.Init(InGraph);
+}
+
+TSharedRef<FBAGraphHandler> FBAGraphHandler::MakeHeadless(UEdGraph* InGraph, TSharedRef<IBANodeGeometry> InGeometry)
+{
+	return MakeShareable(new FBAGraphHandler(InGraph, InGeometry));
 }
 
 FBAGraphHandler::~FBAGraphHandler()
@@ -73,6 +90,7 @@ FBAGraphHandler::~FBAGraphHandler()
 	ResetTransactions();
 
 	FCoreUObjectDelegates::OnObjectTransacted.RemoveAll(this);
+	FCoreUObjectDelegates::OnObjectModified.RemoveAll(this);
 }
 
 void FBAGraphHandler::InitGraphHandler()
@@ -89,6 +107,8 @@ void FBAGraphHandler::InitGraphHandler()
 
 	NodeToReplace = nullptr;
 	bInitialZoomFinished = false;
+	bReleasedCaches = false;
+	LastFocusTime = FPlatformTime::Seconds();
 	NodeSizeTimeout = 0.f;
 	FocusedNode = nullptr;
 	bFullyZoomed = false;
@@ -100,6 +120,7 @@ void FBAGraphHandler::InitGraphHandler()
 	PendingFormatting.Reset();
 	PendingSize.Reset();
 	CommentBubbleSizeCache.Reset();
+	HitTestIndex.Reset();
 	FormatAllColumns.Reset();
 	FormatterMap.Reset();
 
@@ -109,6 +130,7 @@ void FBAGraphHandler::InitGraphHandler()
 
 	CachedEdGraph.Reset();
 	CachedEdGraph = GetFocusedEdGraph();
+	NodeLookupCache.Init(GetFocusedEdGraph());
 
 	GetGraphData().CleanupGraph(GetFocusedEdGraph());
 
@@ -157,21 +179,76 @@ void FBAGraphHandler::OnGraphInitializedDelayed()
 		CacheNodeSizes(GetFocusedEdGraph()->Nodes);
 	}
 
+	InitNodeSizeChangeData();
+
 	for (UEdGraphNode* Node : GetFocusedEdGraph()->Nodes)
 	{
-		NodeSizeChangeDataMap.Add(Node->NodeGuid, FBANodeSizeChangeData(Node));
-
 		const FBANodeData& NodeData = GetNodeData(Node);
 		if (NodeData.NodeGroup.IsValid())
 		{
 			// initialize the node groups
 			NodeGroups.FindOrAdd(NodeData.NodeGroup).Add(Node);
 		}
+
+		if (NodeData.bLocked)
+		{
+			LockedNodes.Add(Node);
+		}
+	}
+}
+
+void FBAGraphHandler::InitNodeSizeChangeData()
+{
+	NodeSizeChangeDataMap.Reserve(GetFocusedEdGraph()->Nodes.Num());
+	for (UEdGraphNode* Node : GetFocusedEdGraph()->Nodes)
+	{
+		NodeSizeChangeDataMap.Add(Node->NodeGuid, FBANodeSizeChangeData(Node));
+	}
+}
+
+void FBAGraphHandler::RefreshNodeSizeChangeData()
+{
+	for (UEdGraphNode* Node : GetFocusedEdGraph()->Nodes)
+	{
+		if (FBANodeSizeChangeData* ChangeData = NodeSizeChangeDataMap.Find(Node->NodeGuid))
+		{
+			if (ChangeData->HasNodeChanged(Node))
+			{
+				GetNodeData(Node).ResetSize();
+			}
+
+			ChangeData->UpdateNode(Node);
+		}
+		else
+		{
+			// the node was added or changed its guid in the background, we can't tell whether the cached size is still valid
+			GetNodeData(Node).ResetSize();
+			NodeSizeChangeDataMap.Add(Node->NodeGuid, FBANodeSizeChangeData(Node));
+		}
+	}
+
+	HitTestIndex.MarkDirty();
+
+	if (GraphOverlay)
+	{
+		GraphOverlay->InvalidateAllNodeBounds();
 	}
 }
 
 void FBAGraphHandler::OnGainFocus()
 {
+	LastFocusTime = FPlatformTime::Seconds();
+
+	if (bReleasedCaches)
+	{
+		bReleasedCaches = false;
+
+		if (FBAUtils::IsValidGraph(GetFocusedEdGraph()))
+		{
+			RefreshNodeSizeChangeData();
+		}
+	}
+
 	if (NodeSizeTimeout > 0)
 	{
 		ShowSizeTimeoutNotification();
@@ -195,6 +272,50 @@ void FBAGraphHandler::OnLoseFocus()
 	CancelActiveFormatting();
 }
 
+void FBAGraphHandler::ReleaseCaches()
+{
+	if (bReleasedCaches)
+	{
+		return;
+	}
+
+	bReleasedCaches = true;
+
+	// keep the node hashes so changes made in the background are detected when we regain focus
+	for (auto& Elem : NodeSizeChangeDataMap)
+	{
+		Elem.Value.ReleaseDebugData();
+	}
+	NodeSizeChangeDataMap.Shrink();
+
+	// the comment bubble sizes are only measured with the node size, unchanged nodes are not re-measured on focus so keep them
+	// use Empty to free the allocations as well
+	FormatterMap.Empty();
+	HitTestIndex.Reset();
+	NodeLookupCache.Init(GetFocusedEdGraph());
+}
+
+SIZE_T FBAGraphHandler::GetAllocatedSize() const
+{
+	SIZE_T Size = sizeof(FBAGraphHandler);
+
+	Size += NodeSizeChangeDataMap.GetAllocatedSize();
+	for (const auto& Elem : NodeSizeChangeDataMap)
+	{
+		// the element itself is already counted by the map allocation
+		Size += Elem.Value.GetAllocatedSize() - sizeof(FBANodeSizeChangeData);
+	}
+
+	Size += CommentBubbleSizeCache.GetAllocatedSize();
+	Size += FormatterMap.GetAllocatedSize();
+	Size += LastNodes.GetAllocatedSize();
+	Size += NodeGroups.GetAllocatedSize();
+	Size += PendingSize.GetAllocatedSize();
+	Size += PendingFormatting.GetAllocatedSize();
+
+	return Size;
+}
+
 void FBAGraphHandler::Cleanup()
 {
 	if (OnGraphChangedHandle.IsValid())
@@ -217,6 +338,12 @@ void FBAGraphHandler::Cleanup()
 	DelayedDetectGraphChanges.Cancel();
 
 	CancelActiveFormatting();
+
+	// restore any node widgets hidden by the overlay
+	if (GraphOverlay)
+	{
+		GraphOverlay->ExitLevelOfDetail();
+	}
 }
 
 void FBAGraphHandler::OnSelectionChanged(UEdGraphNode* PreviousNode, UEdGraphNode* NewNode)
@@ -459,6 +586,8 @@ void FBAGraphHandler::Tick(float DeltaTime)
 
 	DelayedClearReplaceTransaction.Tick();
 
+	FrameBudget.BeginFrame(UBASettings_Advanced::Get().DeferredWorkFrameBudget);
+
 	UpdateCachedNodeSize(DeltaTime);
 
 	UpdateSelectedNode();
@@ -866,7 +995,14 @@ void FBAGraphHandler::MoveUnrelatedNodes(TSharedPtr<FFormatterInterface> Formatt
 
 void FBAGraphHandler::OnGraphChanged(const FEdGraphEditAction& Action)
 {
+	HitTestIndex.MarkDirty();
+	NodeLookupCache.MarkDirty();
 	DelayedDetectGraphChanges.StartDelay(1);
+
+	if (GraphOverlay)
+	{
+		GraphOverlay->InvalidateAllNodeBounds();
+	}
 }
 
 void FBAGraphHandler::DetectGraphChanges()
@@ -1032,7 +1168,7 @@ void FBAGraphHandler::CacheNodeSizes(const TArray<UEdGraphNode*>& Nodes)
 		}
 
 		// if the node size hasn't been cached, add the node to be calculated
-		if (!PendingSize.Contains(Node) && !GetNodeData(Node).HasSize())
+		if (!PendingSize.Contains(Node) && !GetNodeData(Node).HasSize() && !TryApplyNodeShape(Node))
 		{
 			PendingSize.Emplace(Node);
 		}
@@ -1315,6 +1451,20 @@ void FBAGraphHandler::OnObjectTransacted(UObject* Object, const FTransactionObje
 {
 	static const FName NodesChangedName(TEXT("Nodes"));
 
+	// moving nodes is transacted, so this also catches nodes dragged by the editor
+	if (UEdGraphNode* Node = Cast<UEdGraphNode>(Object))
+	{
+		if (Node->GetGraph() == GetFocusedEdGraph())
+		{
+			HitTestIndex.MarkDirty();
+
+			if (GraphOverlay)
+			{
+				GraphOverlay->InvalidateNodeBounds(Node);
+			}
+		}
+	}
+
 	if (Event.GetEventType() == ETransactionObjectEventType::UndoRedo)
 	{
 		if ((Event.GetChangedProperties().Num() == 1) && Event.GetChangedProperties()[0].IsEqual(NodesChangedName))
@@ -1323,6 +1473,7 @@ void FBAGraphHandler::OnObjectTransacted(UObject* Object, const FTransactionObje
 			{
 				if (Graph == GetFocusedEdGraph())
 				{
+					NodeLookupCache.MarkDirty();
 					LastNodes = FBAMiscUtils::AsWeakObjectPtrArray(GetFocusedEdGraph()->Nodes);
 				}
 			}
@@ -1330,6 +1481,22 @@ void FBAGraphHandler::OnObjectTransacted(UObject* Object, const FTransactionObje
 	}
 }
 
+void FBAGraphHandler::OnObjectModified(UObject* Object)
+{
+	if (!GraphOverlay)
+	{
+		return;
+	}
+
+	if (UEdGraphNode* Node = Cast<UEdGraphNode>(Object))
+	{
+		if (Node->GetGraph() == GetFocusedEdGraph())
+		{
+			GraphOverlay->InvalidateNodeBounds(Node);
+		}
+	}
+}
+
 bool FBAGraphHandler::UpdateNodeSizesChanges(const TArray<UEdGraphNode*>& Nodes)
 {
 	bool bAddedSize = false;
@@ -1379,7 +1546,7 @@ bool FBAGraphHandler::UpdateNodeSizesChanges(const TArray<UEdGraphNode*>& Nodes)
 
 		// calculate size for all connected nodes which don't have a valid size
 		const bool bHasValidSize = GetNodeData(Node).HasSize();
-		if (!bHasValidSize && !PendingSize.Contains(Node))
+		if (!bHasValidSize && !PendingSize.Contains(Node) && !TryApplyNodeShape(Node))
 		{
 			PendingSize.Add(Node);
 			bAddedSize = true;
@@ -1796,9 +1963,9 @@ void FBAGraphHandler::PostFormatComments(const TArray<TSharedPtr<FFormatterInter
 			Comment->SetBounds(*Bounds);
 			bGraphPanelNeedsRefresh = true;
 
-			if (UBASettings::Get().bHighlightBadComments)
+			if (UBASettings::Get().bHighlightBadComments && GraphOverlay)
 			{
-				GetGraphOverlay()->DrawBounds(*Bounds, FLinearColor::Red, 0.5f);
+				GraphOverlay->DrawBounds(*Bounds, FLinearColor::Red, 0.5f);
 			}
 		}
 	}
@@ -1873,9 +2040,19 @@ TSet<UEdGraphNode*> FBAGraphHandler::GetNodeGroup(const FGuid& GroupID)
 
 void FBAGraphHandler::AddToNodeGroup(FGuid GroupID, UEdGraphNode* Node)
 {
+	if (GraphOverlay)
+	{
+		GraphOverlay->InvalidateNodeGroupBounds(GroupID);
+	}
+
 	FBANodeData& NodeData = GetNodeData(Node);
 	if (NodeData.NodeGroup.IsValid())
 	{
+		if (GraphOverlay)
+		{
+			GraphOverlay->InvalidateNodeGroupBounds(NodeData.NodeGroup);
+		}
+
 		// remove from old node group
 		if (auto Group = NodeGroups.Find(NodeData.NodeGroup))
 		{
@@ -1895,6 +2072,11 @@ void FBAGraphHandler::ClearNodeGroup(UEdGraphNode* Node)
 	FBANodeData& NodeData = GetNodeData(Node);
 	if (NodeData.NodeGroup.IsValid())
 	{
+		if (GraphOverlay)
+		{
+			GraphOverlay->InvalidateNodeGroupBounds(NodeData.NodeGroup);
+		}
+
 		// remove from old node group
 		if (auto Group = NodeGroups.Find(NodeData.NodeGroup))
 		{
@@ -1954,6 +2136,15 @@ void FBAGraphHandler::ToggleLockNodes(const TSet<UEdGraphNode*>& NodeSet)
 	{
 		FBANodeData& NodeData = GetNodeData(SelectedNode);
 		NodeData.bLocked = bAnyUnlocked; 
+
+		if (bAnyUnlocked)
+		{
+			LockedNodes.Add(SelectedNode);
+		}
+		else
+		{
+			LockedNodes.Remove(SelectedNode);
+		}
 	}
 }
 
@@ -2045,49 +2236,72 @@ TSharedPtr<SGraphPanel> FBAGraphHandler::GetGraphPanel()
 
 FSlateRect FBAGraphHandler::GetCachedNodeBounds(UEdGraphNode* Node, bool bWithCommentBubble)
 {
-	if (!Node)
+	return FBANodeGeometryUtils::GetNodeBounds(*this, Node, bWithCommentBubble);
+}
+
+bool FBAGraphHandler::GetNodeSize(UEdGraphNode* Node, FVector2D& OutSize)
+{
+	if (HeadlessGeometry)
 	{
-		return FSlateRect();
+		return HeadlessGeometry->GetNodeSize(Node, OutSize);
 	}
 
-	FVector2D Pos(Node->NodePosX, Node->NodePosY);
+	const FBANodeData& FoundNodeData = GetNodeData(Node);
+	if (FoundNodeData.HasSize())
+	{
+		OutSize = FoundNodeData.GetSize();
+		return true;
+	}
 
-	FVector2D Size(300, 150);
-	if (FBAUtils::IsKnotNode(Node))
+	if (TSharedPtr<SGraphNode> GraphNode = FBAUtils::GetGraphNode(GetGraphPanel(), Node))
 	{
-		Size = FBAUtils::GetKnotNodeSize();
+		OutSize = GraphNode->GetDesiredSize();
+		return true;
 	}
-	else
+
+	return false;
+}
+
+bool FBAGraphHandler::GetPinOffset(const UEdGraphPin* Pin, float& OutOffset)
+{
+	if (HeadlessGeometry)
 	{
-		FBANodeData& FoundNodeData = GetNodeData(Node);
-		if (FoundNodeData.HasSize())
-		{
-			Size.X = FoundNodeData.SizeX;
-			Size.Y = FoundNodeData.SizeY;
-		}
-		else
-		{
-			if (TSharedPtr<SGraphNode> GraphNode = FBAUtils::GetGraphNode(GetGraphPanel(), Node))
-			{
-				Size = GraphNode->GetDesiredSize();
-			}
-		}
+		return HeadlessGeometry->GetPinOffset(Pin, OutOffset);
+	}
+
+	const FBANodeData& FoundNodeData = GetNodeData(Pin->GetOwningNode());
+	if (FoundNodeData.FindPinOffset(Pin, OutOffset))
+	{
+		return true;
 	}
 
-	// skip comment bubbles since when we access this function for comments, we are actually grabbing the title bar bounds 
-	if (!FBAUtils::IsCommentNode(Node))
+	if (TSharedPtr<SGraphNode> GraphNode = GetGraphNode(Pin->GetOwningNode()))
 	{
-		FVector2D* CommentBubbleSizePtr = CommentBubbleSizeCache.Find(Node);
-		if (bWithCommentBubble && CommentBubbleSizePtr != nullptr && Node->bCommentBubbleVisible)
+		TSharedPtr<SGraphPin> GraphPin = GraphNode->FindWidgetForPin(const_cast<UEdGraphPin*>(Pin));
+		if (GraphPin.IsValid() && GraphPin->GetPinObj() != nullptr)
 		{
-			const FVector2D CommentBubbleSize = *CommentBubbleSizePtr;
-			Pos.Y -= CommentBubbleSize.Y;
-			Size.Y += CommentBubbleSize.Y;
-			Size.X = FMath::Max(Size.X, CommentBubbleSize.X);
+			OutOffset = GraphPin->GetNodeOffset().Y;
+			return true;
 		}
 	}
 
-	return FSlateRect::FromPointAndExtent(Pos, Size);
+	return false;
+}
+
+bool FBAGraphHandler::GetCommentBubbleSize(UEdGraphNode* Node, FVector2D& OutSize)
+{
+	if (HeadlessGeometry)
+	{
+		return HeadlessGeometry->GetCommentBubbleSize(Node, OutSize);
+	}
+
+	if (const FVector2D* CommentBubbleSizePtr = CommentBubbleSizeCache.Find(Node))
+	{
+		OutSize = *CommentBubbleSizePtr;
+		return true;
+	}
+
+	return false;
 }
 
 UEdGraphPin* FBAGraphHandler::GetSelectedPin()
@@ -2205,39 +2419,7 @@ void FBAGraphHandler::ResetReplaceNodeTransaction()
 
 float FBAGraphHandler::GetPinY(const UEdGraphPin* Pin)
 {
-	if (!Pin) { return 0; }
-
-	UEdGraphNode* OwningNode = Pin->GetOwningNode();
-	if (!OwningNode)
-	{
-		return 0;
-	}
-
-	const FBANodeData& FoundNodeData = GetNodeData(OwningNode);
-	if (const float* FoundPinOffset = FoundNodeData.CachedPins.Find(Pin->PinId))
-	{
-		return OwningNode->NodePosY + *FoundPinOffset;
-	}
-
-	// cache pin offset
-	TSharedPtr<SGraphPanel> GraphPanel = GetGraphPanel();
-	if (GraphPanel.IsValid())
-	{
-		TSharedPtr<SGraphNode> GraphNode = GetGraphNode(OwningNode);
-		if (GraphNode.IsValid())
-		{
-			TSharedPtr<SGraphPin> GraphPin = GraphNode->FindWidgetForPin(const_cast<UEdGraphPin*>(Pin));
-			if (GraphPin.IsValid())
-			{
-				if (GraphPin->GetPinObj() != nullptr)
-				{
-					return OwningNode->NodePosY + GraphPin->GetNodeOffset().Y;
-				}
-			}
-		}
-	}
-
-	return OwningNode->NodePosY;
+	return FBANodeGeometryUtils::GetPinY(*this, Pin);
 }
 
 void FBAGraphHandler::UpdateCachedNodeSize(float DeltaTime)
@@ -2278,6 +2460,7 @@ void FBAGraphHandler::UpdateCachedNodeSize(float DeltaTime)
 		if (GraphPanel->GetNodeWidgetFromGuid(Node->NodeGuid).IsValid())
 		{
 			bIsPanelValid = true;
+			break;
 		}
 	}
 
@@ -2305,9 +2488,26 @@ void FBAGraphHandler::UpdateCachedNodeSize(float DeltaTime)
 	{
 		OnBeginNodeCaching();
 
+		// nodes in the viewport can be cached without moving the view, so process them first
+		TSet<UEdGraphNode*> VisibleNodes;
+		for (TWeakObjectPtr<UEdGraphNode> Node : PendingSize)
+		{
+			if (FBAUtils::IsNodeVisible(GraphPanel, Node.Get()))
+			{
+				VisibleNodes.Add(Node.Get());
+			}
+		}
+
 		// sort top left most node
-		PendingSize.Sort([](const TWeakObjectPtr<UEdGraphNode> NodeA, const TWeakObjectPtr<UEdGraphNode> NodeB)
+		PendingSize.Sort([&VisibleNodes](const TWeakObjectPtr<UEdGraphNode> NodeA, const TWeakObjectPtr<UEdGraphNode> NodeB)
 		{
+			const bool bVisibleA = VisibleNodes.Contains(NodeA.Get());
+			const bool bVisibleB = VisibleNodes.Contains(NodeB.Get());
+			if (bVisibleA != bVisibleB)
+			{
+				return bVisibleA;
+			}
+
 			if (NodeA->NodePosX == NodeB->NodePosX)
 			{
 				return NodeA->NodePosY <= NodeB->NodePosY;
@@ -2381,7 +2581,7 @@ void FBAGraphHandler::UpdateCachedNodeSize(float DeltaTime)
 	}
 
 	// cache node sizes
-	TArray<UEdGraphNode*> NodesCalculated;
+	TSet<UEdGraphNode*> NodesCalculated;
 	for (TWeakObjectPtr<UEdGraphNode> WeakPtr : PendingSize)
 	{
 		if (!WeakPtr.IsValid())
@@ -2389,6 +2589,12 @@ void FBAGraphHandler::UpdateCachedNodeSize(float DeltaTime)
 			continue;
 		}
 
+		// out of time for this frame, continue on the next tick
+		if (NodesCalculated.Num() > 0 && !FrameBudget.HasTimeRemaining())
+		{
+			break;
+		}
+
 		UEdGraphNode* Node = WeakPtr.Get();
 		const bool bIsCommentNode = FBAUtils::IsCommentNode(Node);
 
@@ -2462,10 +2668,13 @@ void FBAGraphHandler::UpdateCachedNodeSize(float DeltaTime)
 		}
 	}
 
-	// remove any nodes that we calculated the size for
-	for (UEdGraphNode* Node : NodesCalculated)
+	// remove any nodes that we calculated the size for (keeping the priority order)
+	if (NodesCalculated.Num() > 0)
 	{
-		PendingSize.RemoveSwap(Node);
+		PendingSize.RemoveAll([&NodesCalculated](TWeakObjectPtr<UEdGraphNode> Node)
+		{
+			return NodesCalculated.Contains(Node.Get());
+		});
 	}
 
 	if ((PendingSize.Num() == 0) && bFullyZoomed)
@@ -2515,12 +2724,15 @@ void FBAGraphHandler::UpdateNodesRequiringFormatting()
 	if (NodesWithoutSize.Num() > 0)
 	{
 		bool bPendingSize = false;
+		TSet<UEdGraphNode*> CheckedNodes;
 		for (TWeakObjectPtr<UEdGraphNode> Pending : PendingFormatting)
 		{
-			if (Pending.IsValid())
+			// pending nodes in the same tree share the size check
+			if (Pending.IsValid() && !CheckedNodes.Contains(Pending.Get()))
 			{
 				TSet<UEdGraphNode*> NodeTree = FBAUtils::GetNodeTree(Pending.Get());
 				bPendingSize |= UpdateNodeSizesChanges(NodeTree.Array());
+				CheckedNodes.Append(NodeTree);
 			}
 		}
 
@@ -2537,9 +2749,22 @@ void FBAGraphHandler::UpdateNodesRequiringFormatting()
 	});
 
 	int CountError = NodesToFormatCopy.Num();
+	int32 NumFormatted = 0;
+	int32 NumCoalesced = 0;
+	bool bOutOfTime = false;
+
+	// several edits in one frame can queue multiple nodes from the same tree (or overlapping trees), only format each tree once
+	TSet<UEdGraphNode*> FormattedThisFrame;
 
 	while (NodesToFormatCopy.Num() > 0)
 	{
+		// out of time for this frame, keep the remaining nodes (and the pending transaction) for the next tick
+		if (NumFormatted > 0 && !FrameBudget.HasTimeRemaining())
+		{
+			bOutOfTime = true;
+			break;
+		}
+
 		CountError -= 1;
 		if (CountError < 0)
 		{
@@ -2555,21 +2780,44 @@ void FBAGraphHandler::UpdateNodesRequiringFormatting()
 		TWeakObjectPtr<UEdGraphNode> NodeToFormat = NodesToFormatCopy.Pop();
 		if (!NodeToFormat.IsValid())
 		{
+			PendingFormatting.Remove(NodeToFormat);
+			continue;
+		}
+
+		// resolve the root once and pass it on to FormatNodes
+		UEdGraphNode* RootNode = GetRootNode(NodeToFormat.Get(), FormatterParameters.NodesToFormat.GetNodes());
+		if (!RootNode)
+		{
+			PendingFormatting.Remove(NodeToFormat);
+			continue;
+		}
+
+		if (FormattedThisFrame.Contains(RootNode))
+		{
+			// the tree for this node overlaps a tree we already formatted
+			PendingFormatting.Remove(NodeToFormat);
+			NumCoalesced += 1;
 			continue;
 		}
 
-		// UE_LOG(LogBlueprintAssist, Warning, TEXT("Formatting %s"), *FBAUtils::GetNodeName(NodeToFormat));
+		// UE_LOG(LogBlueprintAssist, Warning, TEXT("Formatting %s"), *FBAUtils::GetNodeName(RootNode));
 
-		TSharedPtr<FFormatterInterface> Formatter = FormatNodes(NodeToFormat.Get());
+		TSharedPtr<FFormatterInterface> Formatter = FormatNodes(NodeToFormat.Get(), false, RootNode);
 		PendingFormatting.Remove(NodeToFormat);
-		NodesToFormatCopy.Remove(NodeToFormat);
+		NumFormatted += 1;
+		FormattedThisFrame.Add(RootNode);
 
 		if (Formatter.IsValid())
 		{
 			for (UEdGraphNode* Node : Formatter->GetFormattedNodes())
 			{
-				PendingFormatting.Remove(Node);
+				if (PendingFormatting.Remove(Node) > 0)
+				{
+					NumCoalesced += 1;
+				}
+
 				NodesToFormatCopy.Remove(Node);
+				FormattedThisFrame.Add(Node);
 			}
 		}
 
@@ -2579,24 +2827,22 @@ void FBAGraphHandler::UpdateNodesRequiringFormatting()
 		}
 	}
 
-	// handle format all nodes
-	if (FormatAllColumns.Num() > 0)
+	if (NumCoalesced > 0)
 	{
-		FormatterParameters.MasterContainsGraph = MakeShared<FBACommentContainsGraph>();
-		FormatterParameters.MasterContainsGraph->Init(AsShared());
-		FormatterParameters.MasterContainsGraph->BuildCommentTree();
+		NumRedundantFormatsAvoided += NumCoalesced;
+		INC_DWORD_STAT_BY(STAT_GraphHandler_RedundantFormatsAvoided, NumCoalesced);
+		UE_LOG(LogBlueprintAssist, Verbose, TEXT("Formatted %d trees, avoided %d redundant formats (%d total)"), NumFormatted, NumCoalesced, NumRedundantFormatsAvoided);
+	}
 
-		PreFormatting();
+	if (bOutOfTime)
+	{
+		return;
+	}
 
-		if (UBASettings::Get().FormatAllStyle == EBAFormatAllStyle::Smart)
-		{
-			SmartFormatAll();
-		}
-		else
-		{
-			// this also handles EBAFormatAllStyle::NodeType, should separate into another function
-			SimpleFormatAll();
-		}
+	// handle format all nodes
+	if (FormatAllColumns.Num() > 0)
+	{
+		RunFormatAll();
 	}
 
 	FormatAllColumns.Reset();
@@ -2604,6 +2850,26 @@ void FBAGraphHandler::UpdateNodesRequiringFormatting()
 	PendingTransaction.Reset();
 }
 
+void FBAGraphHandler::RunFormatAll()
+{
+	FormatterParameters.MasterContainsGraph = MakeShared<FBACommentContainsGraph>();
+	FormatterParameters.MasterContainsGraph->Init(AsShared());
+	FormatterParameters.MasterContainsGraph->BuildCommentTree();
+
+	PreFormatting();
+	NodePositionBuffer.Begin(GetFocusedEdGraph());
+
+	if (UBASettings::Get().FormatAllStyle == EBAFormatAllStyle::Smart)
+	{
+		SmartFormatAll();
+	}
+	else
+	{
+		// this also handles EBAFormatAllStyle::NodeType, should separate into another function
+		SimpleFormatAll();
+	}
+}
+
 void FBAGraphHandler::SimpleFormatAll()
 {
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FBAGraphHandler::FormatAll"), STAT_GraphHandler_FormatAll, STATGROUP_BA_EdGraphFormatter);
@@ -2634,8 +2900,6 @@ void FBAGraphHandler::SimpleFormatAll()
 				continue;
 			}
 
-			Node->Modify();
-
 			// ignore previously formatted nodes, these can be overlapping if they are shared parameter nodes
 			FormatterParameters.IgnoredNodes.GetNodesWeak() = FBAMiscUtils::AsWeakObjectPtrArray(FormattedNodes.Array());
 			TSharedPtr<FFormatterInterface> Formatter = FormatNodes(Node, true);
@@ -2683,6 +2947,8 @@ void FBAGraphHandler::SimpleFormatAll()
 		bFirstColumn = false;
 	}
 
+	CommitNodePositions();
+
 	// the Metasound Graph requires you to move nodes via GraphNode::MoveTo, so it's easier to do it once here 
 	for (UEdGraphNode* Node : FormattedNodes)
 	{
@@ -2720,8 +2986,6 @@ void FBAGraphHandler::SmartFormatAll()
 			continue;
 		}
 
-		Node->Modify();
-
 		TSharedPtr<FFormatterInterface> Formatter = FormatNodes(Node, true);
 		AllFormatterSaved.Add(Formatter);
 
@@ -2786,7 +3050,10 @@ void FBAGraphHandler::SmartFormatAll()
 			AllFormatters.Remove(Formatter);
 		}
 
-		GraphOverlay->DrawBounds(FBAFormatterUtils::GetFormatterArrayBounds(CurrentColumn, AsShared(), true));
+		if (GraphOverlay)
+		{
+			GraphOverlay->DrawBounds(FBAFormatterUtils::GetFormatterArrayBounds(CurrentColumn, AsShared(), true));
+		}
 
 		ColumnX += CommentOffset;
 
@@ -2798,6 +3065,8 @@ void FBAGraphHandler::SmartFormatAll()
 		NumColumns += 1;
 	}
 
+	CommitNodePositions();
+
 	// the Metasound Graph requires you to move nodes via GraphNode::MoveTo, so it's easier to do it once here 
 	for (UEdGraphNode* Node : PreviouslyFormattedNodes)
 	{
@@ -3143,7 +3412,7 @@ void FBAGraphHandler::FormatAllEvents()
 			if (WeakPtr.IsValid())
 			{
 				UEdGraphNode* Node = WeakPtr.Get();
-				if (UBASettings::Get().bRefreshNodeSizeBeforeFormatting)
+				if (UBASettings::Get().bRefreshNodeSizeBeforeFormatting && !IsHeadless())
 				{
 					TSet<UEdGraphNode*> NodeTree = FBAUtils::GetNodeTree(Node);
 					UpdateNodeSizesChanges(NodeTree.Array());
@@ -3173,6 +3442,20 @@ void FBAGraphHandler::FormatAllEvents()
 	}
 }
 
+void FBAGraphHandler::FormatAllEventsImmediate()
+{
+	FormatAllEvents();
+
+	if (FormatAllColumns.Num() > 0)
+	{
+		RunFormatAll();
+	}
+
+	FormatAllColumns.Reset();
+	FormatAllTransaction.Reset();
+	FormatterParameters.Reset();
+}
+
 void FBAGraphHandler::ApplyGlobalCommentBubblePinned()
 {
 	if (!UBASettings::Get().bEnableGlobalCommentBubblePinned)
@@ -3212,12 +3495,16 @@ int32 FBAGraphHandler::GetNumberOfPendingNodesToCache() const
 
 float FBAGraphHandler::GetPendingNodeSizeProgress() const
 {
-	if (InitialPendingSize)
-	{
-		return 1.0f - (static_cast<float>(PendingSize.Num()) / static_cast<float>(InitialPendingSize));
-	}
+	return GetPendingWorkProgress().GetSizeProgress();
+}
 
-	return 0.0f;
+FBAPendingWorkProgress FBAGraphHandler::GetPendingWorkProgress() const
+{
+	FBAPendingWorkProgress Progress;
+	Progress.NumPendingSize = PendingSize.Num();
+	Progress.InitialPendingSize = InitialPendingSize;
+	Progress.NumPendingFormatting = PendingFormatting.Num();
+	return Progress;
 }
 
 void FBAGraphHandler::ClearFormatters()
@@ -3225,11 +3512,11 @@ void FBAGraphHandler::ClearFormatters()
 	FormatterMap.Empty();
 }
 
-TSharedPtr<FFormatterInterface> FBAGraphHandler::FormatNodes(UEdGraphNode* Node, bool bUsingFormatAll)
+TSharedPtr<FFormatterInterface> FBAGraphHandler::FormatNodes(UEdGraphNode* Node, bool bUsingFormatAll, UEdGraphNode* InRootNode)
 {
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FBAGraphHandler::FormatNode"), STAT_GraphHandler_FormatNode, STATGROUP_BA_EdGraphFormatter);
 
-	if (!GetGraphPanel().IsValid())
+	if (!IsHeadless() && !GetGraphPanel().IsValid())
 	{
 		return nullptr;
 	}
@@ -3262,7 +3549,7 @@ TSharedPtr<FFormatterInterface> FBAGraphHandler::FormatNodes(UEdGraphNode* Node,
 		}
 	}
 
-	UEdGraphNode* NodeToFormat = GetRootNode(Node, FormatterParameters.NodesToFormat.GetNodes(), bCheckSelectedNode);
+	UEdGraphNode* NodeToFormat = InRootNode ? InRootNode : GetRootNode(Node, FormatterParameters.NodesToFormat.GetNodes(), bCheckSelectedNode);
 	if (!NodeToFormat)
 	{
 		return nullptr;
@@ -3302,10 +3589,27 @@ TSharedPtr<FFormatterInterface> FBAGraphHandler::FormatNodes(UEdGraphNode* Node,
 			PreFormatting();
 		}
 
+		// format all keeps the run open across its formatters, flush the nodes it moved before this formatter removes its knots
+		const bool bOwnsPositionBuffer = NodePositionBuffer.Begin(GetFocusedEdGraph());
+		if (!bOwnsPositionBuffer)
+		{
+			NodePositionBuffer.Flush();
+		}
+
 		Formatter->PreFormatting();
 		// GraphOverlay->DrawBounds(FBAUtils::GetNodeBounds(Node));
 		// GraphOverlay->DrawBounds(FBAUtils::GetNodeBounds(NodeToFormat), FLinearColor::Red);
 		Formatter->FormatNode(NodeToFormat);
+
+		if (bOwnsPositionBuffer)
+		{
+			CommitNodePositions();
+		}
+		else
+		{
+			NodePositionBuffer.Flush();
+		}
+
 		Formatter->PostFormatting();
 		OnNodeFormatted.Broadcast(Node, *(Formatter.Get()));
 
@@ -3318,6 +3622,25 @@ TSharedPtr<FFormatterInterface> FBAGraphHandler::FormatNodes(UEdGraphNode* Node,
 	return Formatter;
 }
 
+void FBAGraphHandler::CommitNodePositions()
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FBAGraphHandler::CommitNodePositions"), STAT_GraphHandler_CommitNodePositions, STATGROUP_BA_EdGraphFormatter);
+
+	const int32 NumNodes = NodePositionBuffer.GetNumNodes();
+	const int32 NumMoved = NodePositionBuffer.Commit();
+	if (NumMoved > 0)
+	{
+		HitTestIndex.MarkDirty();
+
+		if (GraphOverlay)
+		{
+			GraphOverlay->InvalidateAllNodeBounds();
+		}
+	}
+
+	UE_LOG(LogBlueprintAssist, VeryVerbose, TEXT("Formatting moved %d / %d nodes"), NumMoved, NumNodes);
+}
+
 void FBAGraphHandler::CancelActiveFormatting()
 {
 	PendingSize.Reset();
@@ -3402,8 +3725,33 @@ bool FBAGraphHandler::CacheNodeSize(UEdGraphNode* Node)
 		}
 
 		NodeData.SetSize(Size);
+		FBACache::Get().ShareNodeShape(Node, NodeData);
+		HitTestIndex.MarkDirty();
+
+		if (GraphOverlay)
+		{
+			GraphOverlay->InvalidateNodeBounds(Node);
+		}
+
 		return true;
 	}
 
 	return false;
+}
+
+bool FBAGraphHandler::TryApplyNodeShape(UEdGraphNode* Node)
+{
+	if (!FBACache::Get().TryApplyNodeShape(Node, GetNodeData(Node)))
+	{
+		return false;
+	}
+
+	HitTestIndex.MarkDirty();
+
+	if (GraphOverlay)
+	{
+		GraphOverlay->InvalidateNodeBounds(Node);
+	}
+
+	return true;
 }
\ No newline at end of file
@@ -0,0 +1,670 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "BlueprintAssistGraphLint.h"
+
+#include "BlueprintAssistSettings_Advanced.h"
+#include "BlueprintAssistUtils.h"
+#include "EdGraphNode_Comment.h"
+#include "K2Node_MacroInstance.h"
+#include "K2Node_VariableGet.h"
+#include "Async/ParallelFor.h"
+#include "BlueprintAssistFormatters/BANodeGeometry.h"
+#include "EdGraph/EdGraph.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Logging/MessageLog.h"
+#include "Misc/LazySingleton.h"
+
+namespace BAGraphLintRules
+{
+	/* Loop macros of the engine's StandardMacros library, their inputs are read on every iteration */
+	bool IsStandardLoopMacro(const UK2Node_MacroInstance* MacroNode)
+	{
+		static const FSoftObjectPath StandardMacrosPath(TEXT("/Engine/EditorBlueprintResources/StandardMacros.StandardMacros"));
+		static const TSet<FName> LoopMacroNames = {
+			"ForLoop",
+			"ForLoopWithBreak",
+			"ForEachLoop",
+			"ForEachLoopWithBreak",
+			"ReverseForEachLoop",
+		};
+
+		UEdGraph* MacroGraph = MacroNode->GetMacroGraph();
+		if (!MacroGraph || !LoopMacroNames.Contains(MacroGraph->GetFName()))
+		{
+			return false;
+		}
+
+		const UBlueprint* MacroLibrary = FBlueprintEditorUtils::FindBlueprintForGraph(MacroGraph);
+		return MacroLibrary && FSoftObjectPath(MacroLibrary) == StandardMacrosPath;
+	}
+
+	class FKnots final : public IBAGraphLintRule
+	{
+	public:
+		virtual FName GetName() const override { return "Knots"; }
+
+		virtual void Lint(const FBALintGraphSnapshot& Graph, TArray<FBAGraphIssue>& OutIssues) const override
+		{
+			for (const FBALintNode& Node : Graph.Nodes)
+			{
+				if (!Node.bKnot)
+				{
+					continue;
+				}
+
+				bool bLinked = false;
+				for (int32 PinIndex : Node.Pins)
+				{
+					const FBALintPin& Pin = Graph.Pins[PinIndex];
+					bLinked |= Pin.LinkedTo.Num() > 0;
+
+					// exec knot nodes can only have a single output link
+					if (Pin.bExec && Pin.Direction == EGPD_Output && Pin.LinkedTo.Num() > 1)
+					{
+						FBAGraphIssue& Issue = OutIssues.AddDefaulted_GetRef();
+						Issue.Severity = EMessageSeverity::Error;
+						Issue.Rule = GetName();
+						Issue.Message = FString::Printf(TEXT("Badly linked reroute node (manually delete and remake this node) %s"), *Node.Guid.ToString());
+						Issue.Node = Node.Node;
+					}
+				}
+
+				if (!bLinked)
+				{
+					FBAGraphIssue& Issue = OutIssues.AddDefaulted_GetRef();
+					Issue.Severity = EMessageSeverity::Info;
+					Issue.Rule = GetName();
+					Issue.Message = FString::Printf(TEXT("Unlinked reroute node %s"), *Node.Guid.ToString());
+					Issue.Node = Node.Node;
+				}
+			}
+		}
+	};
+
+	/* Nodes which are not executed from an event and don't provide a parameter to an executed node */
+	class FDeadNodes final : public IBAGraphLintRule
+	{
+	public:
+		virtual FName GetName() const override { return "DeadNodes"; }
+
+		virtual void Lint(const FBALintGraphSnapshot& Graph, TArray<FBAGraphIssue>& OutIssues) const override
+		{
+			TArray<bool> Reached;
+			Reached.SetNumZeroed(Graph.Nodes.Num());
+
+			TArray<int32> Stack;
+			for (int32 i = 0; i < Graph.Nodes.Num(); ++i)
+			{
+				if (Graph.Nodes[i].bEvent)
+				{
+					Reached[i] = true;
+					Stack.Add(i);
+				}
+			}
+
+			// graphs without events (material, animation) have no execution to check
+			if (Stack.Num() == 0)
+			{
+				return;
+			}
+
+			// follow the exec links
+			TArray<int32> ExecutedNodes;
+			while (Stack.Num())
+			{
+				const int32 NodeIndex = Stack.Pop();
+				ExecutedNodes.Add(NodeIndex);
+
+				for (int32 PinIndex : Graph.Nodes[NodeIndex].Pins)
+				{
+					const FBALintPin& Pin = Graph.Pins[PinIndex];
+					if (Pin.bExec && Pin.Direction == EGPD_Output)
+					{
+						for (int32 LinkedPin : Pin.LinkedTo)
+						{
+							const int32 LinkedNode = Graph.Pins[LinkedPin].NodeIndex;
+							if (!Reached[LinkedNode])
+							{
+								Reached[LinkedNode] = true;
+								Stack.Add(LinkedNode);
+							}
+						}
+					}
+				}
+			}
+
+			// follow the parameters of the executed nodes through pure nodes
+			Stack = MoveTemp(ExecutedNodes);
+			while (Stack.Num())
+			{
+				const int32 NodeIndex = Stack.Pop();
+				for (int32 PinIndex : Graph.Nodes[NodeIndex].Pins)
+				{
+					const FBALintPin& Pin = Graph.Pins[PinIndex];
+					if (!Pin.bExec && Pin.Direction == EGPD_Input)
+					{
+						for (int32 LinkedPin : Pin.LinkedTo)
+						{
+							const int32 LinkedNode = Graph.Pins[LinkedPin].NodeIndex;
+							if (!Reached[LinkedNode] && !Graph.Nodes[LinkedNode].bImpure)
+							{
+								Reached[LinkedNode] = true;
+								Stack.Add(LinkedNode);
+							}
+						}
+					}
+				}
+			}
+
+			for (int32 i = 0; i < Graph.Nodes.Num(); ++i)
+			{
+				const FBALintNode& Node = Graph.Nodes[i];
+				if (!Reached[i] && !Node.bComment && !Node.bKnot)
+				{
+					FBAGraphIssue& Issue = OutIssues.AddDefaulted_GetRef();
+					Issue.Severity = EMessageSeverity::Info;
+					Issue.Rule = GetName();
+					Issue.Message = FString::Printf(TEXT("Unused node %s"), *Node.Name);
+					Issue.Node = Node.Node;
+				}
+			}
+		}
+	};
+
+	/* A pure node linked to the input of a for loop is evaluated again on every iteration */
+	class FPureNodeInLoop final : public IBAGraphLintRule
+	{
+	public:
+		virtual FName GetName() const override { return "PureNodeInLoop"; }
+
+		virtual void Lint(const FBALintGraphSnapshot& Graph, TArray<FBAGraphIssue>& OutIssues) const override
+		{
+			for (const FBALintNode& Node : Graph.Nodes)
+			{
+				if (Node.bImpure || Node.bVariableGet || Node.bKnot || Node.bComment)
+				{
+					continue;
+				}
+
+				TArray<int32> Stack;
+				for (int32 PinIndex : Node.Pins)
+				{
+					if (Graph.Pins[PinIndex].Direction == EGPD_Output)
+					{
+						Stack.Append(Graph.Pins[PinIndex].LinkedTo);
+					}
+				}
+
+				TSet<int32> ReportedLoops;
+				while (Stack.Num())
+				{
+					const FBALintPin& LinkedPin = Graph.Pins[Stack.Pop()];
+					const FBALintNode& LinkedNode = Graph.Nodes[LinkedPin.NodeIndex];
+
+					// follow links through reroute nodes
+					if (LinkedNode.bKnot)
+					{
+						for (int32 KnotPinIndex : LinkedNode.Pins)
+						{
+							if (Graph.Pins[KnotPinIndex].Direction == EGPD_Output)
+							{
+								Stack.Append(Graph.Pins[KnotPinIndex].LinkedTo);
+							}
+						}
+					}
+					else if (LinkedNode.bForLoopMacro && !ReportedLoops.Contains(LinkedPin.NodeIndex))
+					{
+						ReportedLoops.Add(LinkedPin.NodeIndex);
+
+						FBAGraphIssue& Issue = OutIssues.AddDefaulted_GetRef();
+						Issue.Severity = EMessageSeverity::Warning;
+						Issue.Rule = GetName();
+						Issue.Message = FString::Printf(TEXT("Pure node %s is evaluated on every iteration of %s, store its result in a variable before the loop"), *Node.Name, *LinkedNode.Name);
+						Issue.Node = Node.Node;
+					}
+				}
+			}
+		}
+	};
+
+	class FOverlappingNodes final : public IBAGraphLintRule
+	{
+	public:
+		virtual FName GetName() const override { return "OverlappingNodes"; }
+
+		virtual void Lint(const FBALintGraphSnapshot& Graph, TArray<FBAGraphIssue>& OutIssues) const override
+		{
+			// nodes without a cached size use a default size, which would give false positives
+			TArray<int32> Candidates;
+			for (int32 i = 0; i < Graph.Nodes.Num(); ++i)
+			{
+				const FBALintNode& Node = Graph.Nodes[i];
+				if (Node.bHasSize && !Node.bKnot && !Node.bComment)
+				{
+					Candidates.Add(i);
+				}
+			}
+
+			Candidates.Sort([&Graph](int32 A, int32 B)
+			{
+				return Graph.Nodes[A].Bounds.Left < Graph.Nodes[B].Bounds.Left;
+			});
+
+			// sweep along x, only nodes starting before the current node ends can overlap it
+			for (int32 i = 0; i < Candidates.Num(); ++i)
+			{
+				const FBALintNode& NodeA = Graph.Nodes[Candidates[i]];
+				for (int32 j = i + 1; j < Candidates.Num(); ++j)
+				{
+					const FBALintNode& NodeB = Graph.Nodes[Candidates[j]];
+					if (NodeB.Bounds.Left >= NodeA.Bounds.Right)
+					{
+						break;
+					}
+
+					if (NodeA.Bounds.Top < NodeB.Bounds.Bottom && NodeB.Bounds.Top < NodeA.Bounds.Bottom)
+					{
+						FBAGraphIssue& Issue = OutIssues.AddDefaulted_GetRef();
+						Issue.Severity = EMessageSeverity::Info;
+						Issue.Rule = GetName();
+						Issue.Message = FString::Printf(TEXT("Node %s overlaps %s"), *NodeA.Name, *NodeB.Name);
+						Issue.Node = NodeA.Node;
+					}
+				}
+			}
+		}
+	};
+
+	/* Only checked for graphs which use comments */
+	class FNodesOutsideComments final : public IBAGraphLintRule
+	{
+	public:
+		virtual FName GetName() const override { return "NodesOutsideComments"; }
+
+		virtual void Lint(const FBALintGraphSnapshot& Graph, TArray<FBAGraphIssue>& OutIssues) const override
+		{
+			if (!Graph.bHasComments)
+			{
+				return;
+			}
+
+			for (const FBALintNode& Node : Graph.Nodes)
+			{
+				if (!Node.bInsideComment && !Node.bComment && !Node.bKnot)
+				{
+					FBAGraphIssue& Issue = OutIssues.AddDefaulted_GetRef();
+					Issue.Severity = EMessageSeverity::Info;
+					Issue.Rule = GetName();
+					Issue.Message = FString::Printf(TEXT("Node %s is not inside a comment"), *Node.Name);
+					Issue.Node = Node.Node;
+				}
+			}
+		}
+	};
+
+	class FLongLinkSpans final : public IBAGraphLintRule
+	{
+	public:
+		virtual FName GetName() const override { return "LongLinkSpans"; }
+
+		virtual void Lint(const FBALintGraphSnapshot& Graph, TArray<FBAGraphIssue>& OutIssues) const override
+		{
+			const float MaxSpan = Graph.LongLinkSpan;
+			if (MaxSpan <= 0)
+			{
+				return;
+			}
+
+			for (const FBALintPin& Pin : Graph.Pins)
+			{
+				if (Pin.Direction != EGPD_Output)
+				{
+					continue;
+				}
+
+				for (int32 LinkedPinIndex : Pin.LinkedTo)
+				{
+					const FBALintPin& LinkedPin = Graph.Pins[LinkedPinIndex];
+					const float Span = FVector2D::Distance(Pin.Position, LinkedPin.Position);
+					if (Span > MaxSpan)
+					{
+						const FBALintNode& Node = Graph.Nodes[Pin.NodeIndex];
+						FBAGraphIssue& Issue = OutIssues.AddDefaulted_GetRef();
+						Issue.Severity = EMessageSeverity::Info;
+						Issue.Rule = GetName();
+						Issue.Message = FString::Printf(TEXT("Link from %s to %s is %d units long"), *Node.Name, *Graph.Nodes[LinkedPin.NodeIndex].Name, FMath::RoundToInt(Span));
+						Issue.Node = Node.Node;
+					}
+				}
+			}
+		}
+	};
+}
+
+void FBALintGraphSnapshot::Build(UEdGraph* Graph, IBANodeGeometry& Geometry)
+{
+	GraphName = Graph->GetName();
+	LongLinkSpan = UBASettings_Advanced::Get().LintLongLinkSpan;
+	bHasComments = false;
+	Nodes.Reset();
+	Pins.Reset();
+
+	TMap<UEdGraphNode*, int32> NodeIndices;
+	TMap<const UEdGraphPin*, int32> PinIndices;
+
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (!Node)
+		{
+			continue;
+		}
+
+		const int32 NodeIndex = Nodes.AddDefaulted();
+		NodeIndices.Add(Node, NodeIndex);
+
+		FBALintNode& LintNode = Nodes[NodeIndex];
+		LintNode.Node = Node;
+		LintNode.Guid = Node->NodeGuid;
+		LintNode.Name = FBAUtils::GetNodeName(Node);
+		LintNode.Bounds = FBANodeGeometryUtils::GetNodeBounds(Geometry, Node);
+		LintNode.bKnot = FBAUtils::IsKnotNode(Node);
+		LintNode.bComment = FBAUtils::IsCommentNode(Node);
+		LintNode.bImpure = FBAUtils::IsNodeImpure(Node);
+		LintNode.bEvent = FBAUtils::IsEventNode(Node, EGPD_Output);
+		LintNode.bVariableGet = Node->IsA(UK2Node_VariableGet::StaticClass());
+
+		FVector2D Size;
+		LintNode.bHasSize = LintNode.bKnot || Geometry.GetNodeSize(Node, Size);
+
+		if (UK2Node_MacroInstance* Macro = Cast<UK2Node_MacroInstance>(Node))
+		{
+			LintNode.bForLoopMacro = BAGraphLintRules::IsStandardLoopMacro(Macro);
+		}
+
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (!Pin || Pin->bHidden)
+			{
+				continue;
+			}
+
+			const int32 PinIndex = Pins.AddDefaulted();
+			PinIndices.Add(Pin, PinIndex);
+			LintNode.Pins.Add(PinIndex);
+
+			FBALintPin& LintPin = Pins[PinIndex];
+			LintPin.NodeIndex = NodeIndex;
+			LintPin.Direction = Pin->Direction;
+			LintPin.bExec = FBAUtils::IsExecPin(Pin);
+			LintPin.Position = FBANodeGeometryUtils::GetPinPos(Geometry, Pin);
+		}
+	}
+
+	// resolve links once every pin has an index
+	for (const TPair<const UEdGraphPin*, int32>& Elem : PinIndices)
+	{
+		for (UEdGraphPin* LinkedPin : Elem.Key->LinkedTo)
+		{
+			if (const int32* LinkedPinIndex = PinIndices.Find(LinkedPin))
+			{
+				Pins[Elem.Value].LinkedTo.Add(*LinkedPinIndex);
+			}
+		}
+	}
+
+	for (const TPair<UEdGraphNode*, int32>& Elem : NodeIndices)
+	{
+		if (UEdGraphNode_Comment* Comment = Cast<UEdGraphNode_Comment>(Elem.Key))
+		{
+			bHasComments = true;
+
+			for (UEdGraphNode* NodeUnderComment : FBAUtils::GetNodesUnderComment(Comment))
+			{
+				if (const int32* NodeIndex = NodeIndices.Find(NodeUnderComment))
+				{
+					Nodes[*NodeIndex].bInsideComment = true;
+				}
+			}
+		}
+	}
+}
+
+FBAGraphLint& FBAGraphLint::Get()
+{
+	return TLazySingleton<FBAGraphLint>::Get();
+}
+
+void FBAGraphLint::TearDown()
+{
+	TLazySingleton<FBAGraphLint>::TearDown();
+}
+
+FBAGraphLint::FBAGraphLint()
+{
+	RegisterRule(MakeShared<BAGraphLintRules::FKnots>());
+	RegisterRule(MakeShared<BAGraphLintRules::FDeadNodes>());
+	RegisterRule(MakeShared<BAGraphLintRules::FPureNodeInLoop>());
+	RegisterRule(MakeShared<BAGraphLintRules::FOverlappingNodes>());
+	RegisterRule(MakeShared<BAGraphLintRules::FNodesOutsideComments>());
+	RegisterRule(MakeShared<BAGraphLintRules::FLongLinkSpans>());
+}
+
+void FBAGraphLint::Cleanup()
+{
+	CachedResults.Empty();
+}
+
+void FBAGraphLint::RegisterRule(TSharedRef<IBAGraphLintRule> Rule)
+{
+	UnregisterRule(Rule->GetName());
+	Rules.Add(Rule);
+}
+
+void FBAGraphLint::UnregisterRule(FName RuleName)
+{
+	if (Rules.RemoveAll([RuleName](const TSharedRef<IBAGraphLintRule>& Rule) { return Rule->GetName() == RuleName; }) > 0)
+	{
+		CachedResults.Empty();
+	}
+}
+
+void FBAGraphLint::LintGraphs(const TArray<UEdGraph*>& Graphs, TArray<FBAGraphLintResult>& OutResults)
+{
+	struct FLintTask
+	{
+		int32 ResultIndex;
+		uint32 Hash;
+		FBALintGraphSnapshot Snapshot;
+	};
+
+	for (auto It = CachedResults.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	const TArray<TSharedRef<IBAGraphLintRule>> EnabledRules = GetEnabledRules();
+
+	// the enabled rules and their settings change the result of unchanged graphs
+	uint32 SettingsHash = GetTypeHash(UBASettings_Advanced::Get().LintLongLinkSpan);
+	for (const TSharedRef<IBAGraphLintRule>& Rule : EnabledRules)
+	{
+		SettingsHash = HashCombine(SettingsHash, GetTypeHash(Rule->GetName()));
+	}
+
+	OutResults.Reset();
+	OutResults.SetNum(Graphs.Num());
+
+	// snapshots are taken on the game thread
+	TArray<FLintTask> Tasks;
+	for (int32 i = 0; i < Graphs.Num(); ++i)
+	{
+		UEdGraph* Graph = Graphs[i];
+		if (!IsValid(Graph))
+		{
+			continue;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		FBACachedNodeGeometry Geometry(Graph);
+		const uint32 Hash = HashCombine(SettingsHash, GetGraphHash(Graph, Geometry));
+
+		if (const FCachedResult* CachedResult = CachedResults.Find(Graph))
+		{
+			if (CachedResult->Hash == Hash)
+			{
+				OutResults[i].Issues = CachedResult->Issues;
+				OutResults[i].bCached = true;
+				continue;
+			}
+		}
+
+		FLintTask& Task = Tasks.AddDefaulted_GetRef();
+		Task.ResultIndex = i;
+		Task.Hash = Hash;
+		Task.Snapshot.Build(Graph, Geometry);
+
+		OutResults[i].Seconds = FPlatformTime::Seconds() - StartTime;
+	}
+
+	ParallelFor(Tasks.Num(), [&Tasks, &EnabledRules, &OutResults](int32 TaskIndex)
+	{
+		const FLintTask& Task = Tasks[TaskIndex];
+		FBAGraphLintResult& Result = OutResults[Task.ResultIndex];
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (const TSharedRef<IBAGraphLintRule>& Rule : EnabledRules)
+		{
+			Rule->Lint(Task.Snapshot, Result.Issues);
+		}
+
+		Result.Seconds += FPlatformTime::Seconds() - StartTime;
+	});
+
+	for (const FLintTask& Task : Tasks)
+	{
+		FCachedResult& CachedResult = CachedResults.FindOrAdd(Graphs[Task.ResultIndex]);
+		CachedResult.Hash = Task.Hash;
+		CachedResult.Issues = OutResults[Task.ResultIndex].Issues;
+	}
+}
+
+void FBAGraphLint::ReportIssues(const TArray<FBAGraphIssue>& Issues)
+{
+	if (Issues.Num() == 0)
+	{
+		return;
+	}
+
+	struct FLocal
+	{
+		static void FocusNode(TWeakObjectPtr<UEdGraphNode> Node)
+		{
+			if (Node.IsValid())
+			{
+				FKismetEditorUtilities::BringKismetToFocusAttentionOnObject(Node.Get(), false);
+			}
+		}
+	};
+
+	FMessageLog BlueprintAssistLog("BlueprintAssist");
+
+	bool bOpenMessageLog = false;
+	for (const FBAGraphIssue& Issue : Issues)
+	{
+		TSharedRef<FTokenizedMessage> Message = FTokenizedMessage::Create(Issue.Severity);
+		Message->AddToken(FTextToken::Create(FText::FromString(Issue.Message)));
+		Message->AddToken(FActionToken::Create(
+			FText::FromString("GoTo"),
+			FText::FromString("Go to node"),
+			FOnActionTokenExecuted::CreateStatic(&FLocal::FocusNode, Issue.Node)));
+
+		BlueprintAssistLog.AddMessage(Message);
+
+		bOpenMessageLog |= Issue.Severity == EMessageSeverity::Error;
+	}
+
+	if (bOpenMessageLog)
+	{
+		BlueprintAssistLog.Open();
+	}
+}
+
+TArray<TSharedRef<IBAGraphLintRule>> FBAGraphLint::GetEnabledRules() const
+{
+	const TSet<FName>& DisabledRules = UBASettings_Advanced::Get().DisabledLintRules;
+	return Rules.FilterByPredicate([&DisabledRules](const TSharedRef<IBAGraphLintRule>& Rule)
+	{
+		return !DisabledRules.Contains(Rule->GetName());
+	});
+}
+
+uint32 FBAGraphLint::GetGraphHash(UEdGraph* Graph, IBANodeGeometry& Geometry)
+{
+	uint32 Hash = GetTypeHash(Graph->Nodes.Num());
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (!Node)
+		{
+			continue;
+		}
+
+		Hash = HashCombine(Hash, GetTypeHash(Node->NodeGuid));
+		Hash = HashCombine(Hash, GetTypeHash(Node->GetClass()));
+		Hash = HashCombine(Hash, GetTypeHash(FBAUtils::GetNodeName(Node)));
+		Hash = HashCombine(Hash, GetTypeHash(Node->NodePosX));
+		Hash = HashCombine(Hash, GetTypeHash(Node->NodePosY));
+		Hash = HashCombine(Hash, GetTypeHash(Node->NodeWidth));
+		Hash = HashCombine(Hash, GetTypeHash(Node->NodeHeight));
+		Hash = HashCombine(Hash, GetTypeHash(Node->bCommentBubbleVisible));
+
+		FVector2D Size;
+		if (Geometry.GetNodeSize(Node, Size))
+		{
+			Hash = HashCombine(Hash, HashCombine(GetTypeHash(Size.X), GetTypeHash(Size.Y)));
+		}
+
+		FVector2D CommentBubbleSize;
+		if (Node->bCommentBubbleVisible && Geometry.GetCommentBubbleSize(Node, CommentBubbleSize))
+		{
+			Hash = HashCombine(Hash, HashCombine(GetTypeHash(CommentBubbleSize.X), GetTypeHash(CommentBubbleSize.Y)));
+		}
+
+		// the loop macro check reads the macro graph and its library
+		if (UK2Node_MacroInstance* Macro = Cast<UK2Node_MacroInstance>(Node))
+		{
+			Hash = HashCombine(Hash, GetTypeHash(Macro->GetMacroGraph()));
+		}
+
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (!Pin)
+			{
+				continue;
+			}
+
+			Hash = HashCombine(Hash, GetTypeHash(Pin->PinId));
+			Hash = HashCombine(Hash, GetTypeHash(Pin->bHidden));
+			Hash = HashCombine(Hash, GetTypeHash(static_cast<uint8>(Pin->Direction)));
+			Hash = HashCombine(Hash, GetTypeHash(Pin->PinType.PinCategory));
+
+			float PinOffset;
+			if (Geometry.GetPinOffset(Pin, PinOffset))
+			{
+				Hash = HashCombine(Hash, GetTypeHash(PinOffset));
+			}
+
+			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				Hash = HashCombine(Hash, GetTypeHash(LinkedPin->PinId));
+			}
+		}
+	}
+
+	return Hash;
+}
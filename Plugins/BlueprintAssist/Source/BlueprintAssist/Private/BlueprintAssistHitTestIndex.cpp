@@ -0,0 +1,281 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "BlueprintAssistHitTestIndex.h"
+
+#include "BlueprintAssistStats.h"
+#include "BlueprintAssistUtils.h"
+#include "SGraphPanel.h"
+#include "SGraphPin.h"
+#include "HAL/PlatformTime.h"
+
+namespace BAHitTestIndex
+{
+	// rebuild at least this often in case a node was moved without any event we listen to
+	constexpr double MaxIndexAge = 1.0;
+
+	// wire splines bulge out horizontally from their pins, wires going backwards loop out further
+	constexpr float WirePadding = 64.0f;
+	constexpr float BackwardsWirePadding = 256.0f;
+}
+
+void FBAHitTestIndex::Reset()
+{
+	Entries.Empty();
+	Grid.Empty();
+	WireEntries.Empty();
+	WireGrid.Empty();
+	CommentEntries.Empty();
+	CachedPanel.Reset();
+	CachedNumNodes = INDEX_NONE;
+	bDirty = true;
+}
+
+TSharedPtr<SGraphNode> FBAHitTestIndex::FindNodeAt(TSharedPtr<SGraphPanel> GraphPanel, const FVector2D& GraphCoord)
+{
+	RebuildIfNeeded(GraphPanel);
+
+	TArray<TSharedPtr<SGraphNode>, TInlineAllocator<4>> Nodes;
+	GetRegularNodesAt(GraphCoord, Nodes);
+	if (Nodes.Num() > 0)
+	{
+		return Nodes[0];
+	}
+
+	for (const FEntry& Entry : CommentEntries)
+	{
+		if (TSharedPtr<SGraphNode> GraphNode = Entry.GraphNode.Pin())
+		{
+			if (FBAUtils::GetNodeBounds(GraphNode).ContainsPoint(GraphCoord))
+			{
+				return GraphNode;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+TSharedPtr<SGraphPin> FBAHitTestIndex::FindHoveredPin(TSharedPtr<SGraphPanel> GraphPanel, const FVector2D& GraphCoord, bool bUseDirectlyHovered)
+{
+	RebuildIfNeeded(GraphPanel);
+
+	TArray<TSharedPtr<SGraphNode>, TInlineAllocator<4>> Nodes;
+	GetRegularNodesAt(GraphCoord, Nodes);
+
+	for (TSharedPtr<SGraphNode> GraphNode : Nodes)
+	{
+		TArray<TSharedRef<SWidget>> PinsAsWidgets;
+		GraphNode->GetPins(PinsAsWidgets);
+
+		for (const TSharedRef<SWidget>& Widget : PinsAsWidgets)
+		{
+			TSharedRef<SGraphPin> GraphPin = StaticCastSharedRef<SGraphPin>(Widget);
+			UEdGraphPin* Pin = GraphPin->GetPinObj();
+			if (!Pin || FBAUtils::IsPinHidden(Pin))
+			{
+				continue;
+			}
+
+			const bool bIsHovered = bUseDirectlyHovered ? GraphPin->IsDirectlyHovered() : GraphPin->IsHovered();
+			if (bIsHovered)
+			{
+				return GraphPin;
+			}
+		}
+	}
+
+	if (const TArray<int32>* Cell = WireGrid.Find(GetCell(GraphCoord)))
+	{
+		for (int32 WireIndex : *Cell)
+		{
+			const FWireEntry& Wire = WireEntries[WireIndex];
+			if (!Wire.Bounds.ContainsPoint(GraphCoord))
+			{
+				continue;
+			}
+
+			for (const TWeakPtr<SGraphPin>& WeakPin : { Wire.OutputPin, Wire.InputPin })
+			{
+				TSharedPtr<SGraphPin> GraphPin = WeakPin.Pin();
+				if (!GraphPin || !GraphPin->GetPinObj() || FBAUtils::IsPinHidden(GraphPin->GetPinObj()))
+				{
+					continue;
+				}
+
+				const bool bIsHovered = bUseDirectlyHovered ? GraphPin->IsDirectlyHovered() : GraphPin->IsHovered();
+				if (bIsHovered)
+				{
+					return GraphPin;
+				}
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+void FBAHitTestIndex::RebuildIfNeeded(TSharedPtr<SGraphPanel> GraphPanel)
+{
+	UEdGraph* Graph = GraphPanel->GetGraphObj();
+	const int32 NumNodes = Graph ? Graph->Nodes.Num() : 0;
+
+	// node widgets change size depending on the zoom level
+	const bool bNeedsRebuild = bDirty
+		|| CachedPanel != GraphPanel
+		|| CachedZoom != GraphPanel->GetZoomAmount()
+		|| CachedNumNodes != NumNodes
+		|| (FPlatformTime::Seconds() - LastBuildTime) > BAHitTestIndex::MaxIndexAge;
+
+	if (bNeedsRebuild)
+	{
+		Rebuild(GraphPanel);
+	}
+}
+
+void FBAHitTestIndex::Rebuild(TSharedPtr<SGraphPanel> GraphPanel)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FBAHitTestIndex::Rebuild"), STAT_HitTestIndex_Rebuild, STATGROUP_BA_EdGraphFormatter);
+
+	Entries.Reset();
+	Grid.Reset();
+	WireEntries.Reset();
+	WireGrid.Reset();
+	CommentEntries.Reset();
+
+	CachedPanel = GraphPanel;
+	CachedZoom = GraphPanel->GetZoomAmount();
+	LastBuildTime = FPlatformTime::Seconds();
+	bDirty = false;
+	NumRebuilds += 1;
+
+	UEdGraph* Graph = GraphPanel->GetGraphObj();
+	CachedNumNodes = Graph ? Graph->Nodes.Num() : 0;
+	if (!Graph)
+	{
+		return;
+	}
+
+	TMap<UEdGraphNode*, int32> EntryIndices;
+	EntryIndices.Reserve(Graph->Nodes.Num());
+
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		TSharedPtr<SGraphNode> GraphNode = FBAUtils::GetGraphNode(GraphPanel, Node);
+		if (!GraphNode)
+		{
+			continue;
+		}
+
+		FEntry Entry;
+		Entry.GraphNode = GraphNode;
+		Entry.Bounds = FBAUtils::GetNodeBounds(GraphNode);
+
+		if (FBAUtils::IsCommentNode(Node))
+		{
+			CommentEntries.Add(Entry);
+			continue;
+		}
+
+		const int32 EntryIndex = Entries.Add(Entry);
+		EntryIndices.Add(Node, EntryIndex);
+		AddToGrid(Grid, Entry.Bounds, EntryIndex);
+	}
+
+	AddWires(GraphPanel, EntryIndices);
+}
+
+void FBAHitTestIndex::AddWires(TSharedPtr<SGraphPanel> GraphPanel, const TMap<UEdGraphNode*, int32>& EntryIndices)
+{
+	for (const FEntry& Entry : Entries)
+	{
+		TSharedPtr<SGraphNode> GraphNode = Entry.GraphNode.Pin();
+		UEdGraphNode* Node = GraphNode ? GraphNode->GetNodeObj() : nullptr;
+		if (!Node)
+		{
+			continue;
+		}
+
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (Pin->Direction != EGPD_Output || Pin->LinkedTo.Num() == 0)
+			{
+				continue;
+			}
+
+			TSharedPtr<SGraphPin> OutputPin = GraphNode->FindWidgetForPin(Pin);
+			if (!OutputPin)
+			{
+				continue;
+			}
+
+			const FVector2D OutputPos(Entry.Bounds.Right, Entry.Bounds.Top + OutputPin->GetNodeOffset().Y);
+
+			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				const int32* LinkedIndex = LinkedPin ? EntryIndices.Find(LinkedPin->GetOwningNode()) : nullptr;
+				if (!LinkedIndex)
+				{
+					continue;
+				}
+
+				const FEntry& LinkedEntry = Entries[*LinkedIndex];
+				TSharedPtr<SGraphNode> LinkedGraphNode = LinkedEntry.GraphNode.Pin();
+				TSharedPtr<SGraphPin> InputPin = LinkedGraphNode ? LinkedGraphNode->FindWidgetForPin(LinkedPin) : nullptr;
+				if (!InputPin)
+				{
+					continue;
+				}
+
+				const FVector2D InputPos(LinkedEntry.Bounds.Left, LinkedEntry.Bounds.Top + InputPin->GetNodeOffset().Y);
+				const float PaddingX = OutputPos.X > InputPos.X ? BAHitTestIndex::BackwardsWirePadding : BAHitTestIndex::WirePadding;
+
+				FWireEntry Wire;
+				Wire.OutputPin = OutputPin;
+				Wire.InputPin = InputPin;
+				Wire.Bounds = FSlateRect(
+					FMath::Min(OutputPos.X, InputPos.X) - PaddingX,
+					FMath::Min(OutputPos.Y, InputPos.Y) - BAHitTestIndex::WirePadding,
+					FMath::Max(OutputPos.X, InputPos.X) + PaddingX,
+					FMath::Max(OutputPos.Y, InputPos.Y) + BAHitTestIndex::WirePadding);
+
+				AddToGrid(WireGrid, Wire.Bounds, WireEntries.Add(Wire));
+			}
+		}
+	}
+}
+
+void FBAHitTestIndex::AddToGrid(TMap<FIntPoint, TArray<int32>>& InGrid, const FSlateRect& Bounds, int32 Index)
+{
+	const FIntPoint MinCell = GetCell(FVector2D(Bounds.Left, Bounds.Top));
+	const FIntPoint MaxCell = GetCell(FVector2D(Bounds.Right, Bounds.Bottom));
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			InGrid.FindOrAdd(FIntPoint(X, Y)).Add(Index);
+		}
+	}
+}
+
+void FBAHitTestIndex::GetRegularNodesAt(const FVector2D& GraphCoord, TArray<TSharedPtr<SGraphNode>, TInlineAllocator<4>>& OutNodes) const
+{
+	if (const TArray<int32>* Cell = Grid.Find(GetCell(GraphCoord)))
+	{
+		for (int32 EntryIndex : *Cell)
+		{
+			if (TSharedPtr<SGraphNode> GraphNode = Entries[EntryIndex].GraphNode.Pin())
+			{
+				// test against the current bounds in case the node moved since the last rebuild
+				if (FBAUtils::GetNodeBounds(GraphNode).ContainsPoint(GraphCoord))
+				{
+					OutNodes.Add(GraphNode);
+				}
+			}
+		}
+	}
+}
+
+FIntPoint FBAHitTestIndex::GetCell(const FVector2D& GraphCoord)
+{
+	return FIntPoint(FMath::FloorToInt(GraphCoord.X / CellSize), FMath::FloorToInt(GraphCoord.Y / CellSize));
+}
@@ -7,6 +7,7 @@
 #include "BlueprintAssistGlobals.h"
 #include "BlueprintAssistGraphHandler.h"
 #include "BlueprintAssistModule.h"
+#include "BlueprintAssistOpenWindowIndex.h"
 #include "BlueprintAssistSettings_Advanced.h"
 #include "BlueprintAssistSettings_EditorFeatures.h"
 #include "BlueprintAssistTabHandler.h"
@@ -16,6 +17,7 @@
 #include "IContentBrowserSingleton.h"
 #include "K2Node_DynamicCast.h"
 #include "SGraphPanel.h"
+#include "BlueprintAssistMisc/BlueprintAssistInputLatency.h"
 #include "BlueprintAssistObjects/BARootObject.h"
 #include "Editor/ContentBrowser/Private/SContentBrowser.h"
 #include "Framework/Application/SlateApplication.h"
@@ -52,6 +54,9 @@ FBAInputProcessor::FBAInputProcessor()
 
 	FSlateApplication::Get().OnApplicationActivationStateChanged().AddRaw(this, &FBAInputProcessor::OnWindowFocusChanged);
 
+	OnUserDefinedChordChangedHandle = FInputBindingManager::Get().RegisterUserDefinedChordChanged(
+		FOnUserDefinedChordChanged::FDelegate::CreateRaw(this, &FBAInputProcessor::OnUserDefinedChordChanged));
+
 	CommandLists = {
 		GlobalActions.GlobalCommands,
 		TabActions.TabCommands,
@@ -78,6 +83,9 @@ void FBAInputProcessor::Cleanup()
 		FSlateApplication::Get().UnregisterInputPreProcessor(BAInputProcessorInstance);
 	}
 
+	FInputBindingManager::Get().UnregisterUserDefinedChordChanged(OnUserDefinedChordChangedHandle);
+	ChordDispatchTable.Empty();
+
 	BAInputProcessorInstance.Reset();
 }
 
@@ -97,16 +105,22 @@ void FBAInputProcessor::Tick(
 
 	FBATabHandler::Get().Tick(DeltaTime);
 
+	FBAOpenWindowIndex::Get().Tick();
+
 	if (UBARootObject* RootObject = FBlueprintAssistModule::Get().GetRootObject())
 	{
 		RootObject->Tick();
 	}
 
+	// mouse move events are coalesced, move the dragged nodes once per tick
+	ApplyPendingDragDelta();
 	UpdateGroupMovement();
 }
 
 bool FBAInputProcessor::HandleKeyDownEvent(FSlateApplication& SlateApp, const FKeyEvent& InKeyEvent)
 {
+	BA_SCOPED_INPUT_LATENCY(KeyDown);
+
 	// ignore repeat keys
 	if (InKeyEvent.IsRepeat())
 	{
@@ -151,7 +165,10 @@ bool FBAInputProcessor::HandleKeyDownEvent(FSlateApplication& SlateApp, const FK
 			return true;
 		}
 
-		if (BlueprintActions.HasOpenBlueprintEditor())
+		// the context checks below are only needed if the chord is bound to one of our commands
+		const bool bHasCommandsForKeyEvent = HasCommandsForKeyEvent(InKeyEvent);
+
+		if (bHasCommandsForKeyEvent && BlueprintActions.HasOpenBlueprintEditor())
 		{
 			if (ProcessCommandBindings(BlueprintActions.BlueprintCommands, InKeyEvent))
 			{
@@ -213,7 +230,7 @@ bool FBAInputProcessor::HandleKeyDownEvent(FSlateApplication& SlateApp, const FK
 		TSharedPtr<SWindow> Menu = SlateApp.GetActiveTopLevelWindow();
 		if (Menu.IsValid())
 		{
-			if (GraphActions.HasOpenActionMenu())
+			if (bHasCommandsForKeyEvent && GraphActions.HasOpenActionMenu())
 			{
 				if (ProcessCommandBindings(TabActions.ActionMenuCommands, InKeyEvent))
 				{
@@ -301,7 +318,7 @@ bool FBAInputProcessor::HandleKeyDownEvent(FSlateApplication& SlateApp, const FK
 		}
 
 		// process commands for which require a node to be selected
-		if (GraphHandler->GetSelectedPin() != nullptr || FBAUtils::GetHoveredGraphPin(GraphHandler->GetGraphPanel()).IsValid())
+		if (bHasCommandsForKeyEvent && (GraphHandler->GetSelectedPin() != nullptr || FBAUtils::GetHoveredGraphPin(GraphHandler->GetGraphPanel()).IsValid()))
 		{
 			if (ProcessCommandBindings(PinActions.PinCommands, InKeyEvent))
 			{
@@ -376,6 +393,8 @@ bool FBAInputProcessor::HandleKeyUpEvent(FSlateApplication& SlateApp, const FKey
 
 bool FBAInputProcessor::HandleMouseButtonDownEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent)
 {
+	BA_SCOPED_INPUT_LATENCY(MouseButtonDown);
+
 	if (OnKeyOrMouseDown(SlateApp, MouseEvent.GetEffectingButton()))
 	{
 		return true;
@@ -432,6 +451,8 @@ bool FBAInputProcessor::HandleMouseButtonUpEvent(FSlateApplication& SlateApp, co
 
 bool FBAInputProcessor::HandleMouseMoveEvent(FSlateApplication& SlateApp, const FPointerEvent& MouseEvent)
 {
+	BA_SCOPED_INPUT_LATENCY(MouseMove);
+
 	if (IsDisabled())
 	{
 		return false;
@@ -550,6 +571,7 @@ bool FBAInputProcessor::BeginGroupMovement(const FKey& Key)
 			// set the anchor node for group movement
 			AnchorNode = HoveredNodeObj;
 			LastAnchorPos = HoveredNode->GetPosition();
+			ResetGroupDrag();
 			DragNodeTransaction.Begin(NodesToMove, INVTEXT("Move Node(s)"), EBADragMethod::LMB);
 		}
 	}
@@ -584,6 +606,7 @@ bool FBAInputProcessor::BeginGroupMovement(const FKey& Key)
 			NodeSet.Append(GraphHandler->GetGroupedNodes(GraphHandler->GetSelectedNodes()));
 
 			// begin transaction
+			ResetGroupDrag();
 			DragNodeTransaction.Begin(NodeSet, INVTEXT("Move Node(s)"), EBADragMethod::AdditionalDragChord);
 		}
 	}
@@ -604,21 +627,18 @@ bool FBAInputProcessor::OnMouseDrag(FSlateApplication& SlateApp, const FVector2D
 		{
 			if (IsInputChordDown(Chord))
 			{
-				TSet<UEdGraphNode*> NodesToMove = MyGraphHandler->GetSelectedNodes();
-				for (UEdGraphNode* Node : NodesToMove)
+				// the selected nodes are moved on tick, see ApplyPendingDragDelta
+				bBlocking = MyGraphHandler->GetSelectedNodes().Num() > 0;
+				if (bBlocking)
 				{
-					Node->NodePosX += Delta.X;
-					Node->NodePosY += Delta.Y;
+					PendingDragDelta += Delta;
 				}
 
-				bBlocking = NodesToMove.Num() > 0;
 				break;
 			}
 		}
 	}
 
-	UpdateGroupMovement();
-
 	return bBlocking;
 }
 
@@ -658,8 +678,10 @@ bool FBAInputProcessor::OnKeyOrMouseUp(FSlateApplication& SlateApp, const FKey&
 		{
 			GEditor->GetTimerManager()->SetTimerForNextTick([&]()
 			{
+				UpdateGroupMovement();
 				DragNodeTransaction.End(EBADragMethod::LMB);
 				AnchorNode = nullptr;
+				ResetGroupDrag();
 			});
 		}
 	}
@@ -669,7 +691,12 @@ bool FBAInputProcessor::OnKeyOrMouseUp(FSlateApplication& SlateApp, const FKey&
 		if (DragNodeTransaction.DragMethod == EBADragMethod::AdditionalDragChord)
 		{
 			bBlocking = true;
+
+			// flush any movement from this frame before releasing the anchor node
+			ApplyPendingDragDelta();
+			UpdateGroupMovement();
 			AnchorNode = nullptr;
+			ResetGroupDrag();
 	
 			GEditor->GetTimerManager()->SetTimerForNextTick([&]()
 			{
@@ -741,7 +768,6 @@ void FBAInputProcessor::UpdateGroupMovement()
 		return;
 	}
 	
-	TSet<UEdGraphNode*> NodesToMove;
 	EEdGraphPinDirection Direction = EGPD_MAX;
 	bool bMoveGroupOrSubtree = false;
 	bool bMoveGraphHandledGroup = false;
@@ -776,49 +802,75 @@ void FBAInputProcessor::UpdateGroupMovement()
 		return;
 	}
 	
-	// Group/subtree movement
-	if (bMoveGroupOrSubtree)
+	// Only gather the nodes to move when the selection or movement mode changes, the tree search is too slow to run on every move
+	uint32 DragKey = HashCombine(GetTypeHash(static_cast<uint8>(Direction)), GetTypeHash(bMoveGraphHandledGroup));
+	DragKey = HashCombine(DragKey, GetTypeHash(SelectedNodes.Num()));
+	for (UEdGraphNode* SelectedNode : SelectedNodes)
 	{
-		// Get the graph nodes in the desired direction(s)
-		for (UEdGraphNode* SelectedNode : SelectedNodes)
+		// xor so the key does not depend on the set iteration order
+		DragKey ^= GetTypeHash(SelectedNode);
+	}
+
+	if (DragKey != GroupDragKey)
+	{
+		GroupDragKey = DragKey;
+
+		TSet<UEdGraphNode*> NodesToMove;
+
+		// Group/subtree movement
+		if (bMoveGroupOrSubtree)
 		{
-			auto RelevantTree = FBAUtils::GetNodeTreeWithFilter(SelectedNode, [](UEdGraphPin* Pin)
+			// Get the graph nodes in the desired direction(s)
+			for (UEdGraphNode* SelectedNode : SelectedNodes)
 			{
-				return !FBAUtils::IsDelegatePin(Pin);
-			}, Direction);
-			NodesToMove.Append(RelevantTree);
-		}
-		// Add relevant input nodes for rightward subtrees
-		if (Direction == EGPD_Output)
-		{
-			TSet<UEdGraphNode*> AdditionalNodesToMove;
-			for (UEdGraphNode* SelectedNode : NodesToMove)
+				auto RelevantTree = FBAUtils::GetNodeTreeWithFilter(SelectedNode, [](UEdGraphPin* Pin)
+				{
+					return !FBAUtils::IsDelegatePin(Pin);
+				}, Direction);
+				NodesToMove.Append(RelevantTree);
+			}
+			// Add relevant input nodes for rightward subtrees
+			if (Direction == EGPD_Output)
 			{
-				auto LinkedNodes = FBAUtils::GetLinkedNodes(SelectedNode, EGPD_Input);
-				for (UEdGraphNode* Node : LinkedNodes)
+				TSet<UEdGraphNode*> AdditionalNodesToMove;
+				for (UEdGraphNode* SelectedNode : NodesToMove)
 				{
-					auto ExecPins = FBAUtils::GetExecPins(Node, EGPD_Output);
-					if (ExecPins.Num() == 0)
+					auto LinkedNodes = FBAUtils::GetLinkedNodes(SelectedNode, EGPD_Input);
+					for (UEdGraphNode* Node : LinkedNodes)
 					{
-						auto NonExecNodes = FBAUtils::GetNodeTreeWithFilter(Node, [](UEdGraphPin* Pin)
+						auto ExecPins = FBAUtils::GetExecPins(Node, EGPD_Output);
+						if (ExecPins.Num() == 0)
 						{
-							return FBAUtils::IsNodePure(Pin->GetOwningNode());
-						}, EGPD_Input);
-						AdditionalNodesToMove.Append(NonExecNodes);
+							auto NonExecNodes = FBAUtils::GetNodeTreeWithFilter(Node, [](UEdGraphPin* Pin)
+							{
+								return FBAUtils::IsNodePure(Pin->GetOwningNode());
+							}, EGPD_Input);
+							AdditionalNodesToMove.Append(NonExecNodes);
+						}
 					}
 				}
+				NodesToMove.Append(AdditionalNodesToMove);
 			}
-			NodesToMove.Append(AdditionalNodesToMove);
 		}
+		// Group movement using graph handler
+		else if (bMoveGraphHandledGroup)
+		{
+			NodesToMove = GraphHandler->GetGroupedNodes(SelectedNodes);
+		}
+
+		CacheGroupDragNodes(NodesToMove, SelectedNodes);
 	}
-	// Group movement using graph handler
-	else if (bMoveGraphHandledGroup)
+
+	// Move all cached nodes by the same delta in a single pass
+	for (const TWeakObjectPtr<UEdGraphNode>& WeakNode : GroupDragNodes)
 	{
-		NodesToMove = GraphHandler->GetGroupedNodes(SelectedNodes);
+		if (UEdGraphNode* Node = WeakNode.Get())
+		{
+			ModifyForGroupDrag(Node);
+			Node->NodePosX += Delta.X;
+			Node->NodePosY += Delta.Y;
+		}
 	}
-	
-	// Move nodes
-	GroupMoveNodes(Delta, NodesToMove);
 }
 
 void FBAInputProcessor::GroupMoveSelectedNodes(const FVector2D& Delta)
@@ -845,33 +897,111 @@ void FBAInputProcessor::GroupMoveSelectedNodes(const FVector2D& Delta)
 	}
 }
 
-void FBAInputProcessor::GroupMoveNodes(const FVector2D& Delta, TSet<UEdGraphNode*>& Nodes)
+void FBAInputProcessor::ApplyPendingDragDelta()
 {
+	if (PendingDragDelta.IsZero())
+	{
+		return;
+	}
+
+	const FVector2D Delta = PendingDragDelta;
+	PendingDragDelta = FVector2D::ZeroVector;
+
 	TSharedPtr<FBAGraphHandler> GraphHandler = FBATabHandler::Get().GetActiveGraphHandler();
-	TSet<UEdGraphNode*> SelectedNodes = GraphHandler->GetSelectedNodes();
+	if (!GraphHandler || !AnchorNode.IsValid())
+	{
+		return;
+	}
+
+	for (UEdGraphNode* Node : GraphHandler->GetSelectedNodes())
+	{
+		Node->NodePosX += Delta.X;
+		Node->NodePosY += Delta.Y;
+	}
+}
+
+void FBAInputProcessor::ResetGroupDrag()
+{
+	PendingDragDelta = FVector2D::ZeroVector;
+	GroupDragNodes.Empty();
+	GroupDragKey = 0;
+	GroupDragModifiedNodes.Empty();
+}
+
+void FBAInputProcessor::CacheGroupDragNodes(const TSet<UEdGraphNode*>& Nodes, const TSet<UEdGraphNode*>& SelectedNodes)
+{
+	GroupDragNodes.Reset();
+
 	TSet<UEdGraphNode*> IgnoredNodes(SelectedNodes);
 
+	// the editor already moves the nodes under a dragged comment
 	if (SelectedNodes.Num() == 1)
 	{
 		if (UEdGraphNode_Comment* DraggedComment = Cast<UEdGraphNode_Comment>(SelectedNodes.Array()[0]))
 		{
-			for (UEdGraphNode* Node : FBAUtils::GetNodesUnderComment(DraggedComment))
-			{
-				IgnoredNodes.Add(Node);
-			}
+			IgnoredNodes.Append(FBAUtils::GetNodesUnderComment(DraggedComment));
 		}
 	}
 
 	for (UEdGraphNode* Node : Nodes)
 	{
-		if (IgnoredNodes.Contains(Node))
+		if (!IgnoredNodes.Contains(Node))
+		{
+			GroupDragNodes.Add(Node);
+		}
+	}
+
+	if (GroupDragNodes.Num() == 0)
+	{
+		return;
+	}
+
+	// also move the comments which only contain moving nodes, so the group stays inside its comment
+	TSet<UEdGraphNode*> MovingNodes(Nodes);
+	MovingNodes.Append(IgnoredNodes);
+
+	UEdGraph* Graph = GroupDragNodes[0]->GetGraph();
+	for (UEdGraphNode_Comment* Comment : FBAUtils::GetCommentNodesFromGraph(Graph))
+	{
+		if (MovingNodes.Contains(Comment))
+		{
+			continue;
+		}
+
+		const TArray<UEdGraphNode*> NodesUnderComment = FBAUtils::GetNodesUnderComment(Comment);
+		if (NodesUnderComment.Num() == 0)
 		{
 			continue;
 		}
 
+		bool bContainsOnlyMovingNodes = true;
+		bool bContainsDraggedGroup = false;
+		for (UEdGraphNode* Node : NodesUnderComment)
+		{
+			if (!MovingNodes.Contains(Node))
+			{
+				bContainsOnlyMovingNodes = false;
+				break;
+			}
+
+			bContainsDraggedGroup |= !IgnoredNodes.Contains(Node);
+		}
+
+		if (bContainsOnlyMovingNodes && bContainsDraggedGroup)
+		{
+			GroupDragNodes.Add(Comment);
+		}
+	}
+}
+
+void FBAInputProcessor::ModifyForGroupDrag(UEdGraphNode* Node)
+{
+	// nodes only need to be recorded once for the drag transaction
+	bool bAlreadyModified = false;
+	GroupDragModifiedNodes.Add(TWeakObjectPtr<UEdGraphNode>(Node), &bAlreadyModified);
+	if (!bAlreadyModified)
+	{
 		Node->Modify(false);
-		Node->NodePosX += Delta.X;
-		Node->NodePosY += Delta.Y;
 	}
 }
 
@@ -1093,50 +1223,74 @@ bool FBAInputProcessor::ProcessCommandBindings(TSharedPtr<FUICommandList> Comman
 		return false;
 	}
 
-	FModifierKeysState ModifierKeysState = FSlateApplication::Get().GetModifierKeys();
-	const FInputChord CheckChord(KeyEvent.GetKey(), EModifierKey::FromBools(
+	const auto& DisabledCommands = GetDefault<UBASettings_Advanced>()->DisabledCommands;
+
+	// Check to see if there is any command in the context activated by the chord
+	for (const TSharedPtr<FUICommandInfo>& Command : GetCommandsForChord(GetInputChord(KeyEvent)))
+	{
+		// Find the bound action for this command
+		const FUIAction* Action = CommandList->GetActionForCommand(Command);
+
+		// If there is no Action mapped to this command list, continue to the next context
+		if (Action)
+		{
+			if (Action->CanExecute() && (!KeyEvent.IsRepeat() || Action->CanRepeat()))
+			{
+				// Block the command if we have disabled it in the settings
+				if (!DisabledCommands.Contains(Command->GetCommandName()))
+				{
+					// If the action was found and can be executed, do so now
+					FBAInputLatencyTracker::Get().SetDispatchedCommand(Command->GetCommandName());
+					return Action->Execute();
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+FInputChord FBAInputProcessor::GetInputChord(const FKeyEvent& KeyEvent) const
+{
+	const FModifierKeysState ModifierKeysState = FSlateApplication::Get().GetModifierKeys();
+	return FInputChord(KeyEvent.GetKey(), EModifierKey::FromBools(
 		ModifierKeysState.IsControlDown(),
 		ModifierKeysState.IsAltDown(),
 		ModifierKeysState.IsShiftDown(),
 		ModifierKeysState.IsCommandDown()));
+}
 
-	const auto& DisabledCommands = GetDefault<UBASettings_Advanced>()->DisabledCommands;
-
-	const FInputBindingManager& InputBindingManager = FInputBindingManager::Get();
-
-	TArray<TSharedPtr<FUICommandInfo>> LocalCommandInfos;
-	InputBindingManager.GetCommandInfosFromContext(FBACommands::Get().GetContextName(), LocalCommandInfos);
+const TArray<TSharedPtr<FUICommandInfo>, TInlineAllocator<2>>& FBAInputProcessor::GetCommandsForChord(const FInputChord& Chord)
+{
+	if (const auto* Commands = ChordDispatchTable.Find(Chord))
+	{
+		return *Commands;
+	}
 
 	// Only active chords process commands
 	constexpr bool bCheckDefault = false;
 
 	static const TArray<FName> ContextNames = { FBACommands::Get().GetContextName(), FBAToolbarCommands::Get().GetContextName() };
 
-	// Check to see if there is any command in the context activated by the chord
+	TArray<TSharedPtr<FUICommandInfo>, TInlineAllocator<2>>& Commands = ChordDispatchTable.Add(Chord);
 	for (const FName& ContextName : ContextNames)
 	{
-		TSharedPtr<FUICommandInfo> Command = FInputBindingManager::Get().FindCommandInContext(ContextName, CheckChord, bCheckDefault);
-
-		if (Command.IsValid() && Command->HasActiveChord(CheckChord))
+		TSharedPtr<FUICommandInfo> Command = FInputBindingManager::Get().FindCommandInContext(ContextName, Chord, bCheckDefault);
+		if (Command.IsValid() && Command->HasActiveChord(Chord))
 		{
-			// Find the bound action for this command
-			const FUIAction* Action = CommandList->GetActionForCommand(Command);
-
-			// If there is no Action mapped to this command list, continue to the next context
-			if (Action)
-			{
-				if (Action->CanExecute() && (!KeyEvent.IsRepeat() || Action->CanRepeat()))
-				{
-					// Block the command if we have disabled it in the settings
-					if (!DisabledCommands.Contains(Command->GetCommandName()))
-					{
-						// If the action was found and can be executed, do so now
-						return Action->Execute();
-					}
-				}
-			}
+			Commands.Add(Command);
 		}
 	}
 
-	return false;
+	return Commands;
+}
+
+bool FBAInputProcessor::HasCommandsForKeyEvent(const FKeyEvent& KeyEvent)
+{
+	return GetCommandsForChord(GetInputChord(KeyEvent)).Num() > 0;
+}
+
+void FBAInputProcessor::OnUserDefinedChordChanged(const FUICommandInfo& CommandInfo)
+{
+	ChordDispatchTable.Reset();
 }
\ No newline at end of file
@@ -0,0 +1,323 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "BlueprintAssistMisc/BAGraphMaintenanceCommandlet.h"
+
+#include "BlueprintAssistCache.h"
+#include "BlueprintAssistGlobals.h"
+#include "BlueprintAssistGraphHandler.h"
+#include "BlueprintAssistGraphLint.h"
+#include "BlueprintAssistUtils.h"
+#include "FileHelpers.h"
+#include "JsonObjectConverter.h"
+#include "K2Node_Knot.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "BlueprintAssistFormatters/BANodeGeometry.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace BAGraphMaintenance
+{
+	static FString GetSeverityString(EMessageSeverity::Type Severity)
+	{
+		switch (Severity)
+		{
+			case EMessageSeverity::Error:
+				return TEXT("Error");
+			case EMessageSeverity::Warning:
+			case EMessageSeverity::PerformanceWarning:
+				return TEXT("Warning");
+			default:
+				return TEXT("Info");
+		}
+	}
+}
+
+UBAGraphMaintenanceCommandlet::UBAGraphMaintenanceCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UBAGraphMaintenanceCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamVals;
+	ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	const bool bCleanup = Switches.Contains(TEXT("Cleanup"));
+	const bool bFormat = Switches.Contains(TEXT("Format"));
+	const bool bSave = Switches.Contains(TEXT("Save"));
+
+	TArray<FString> ContentPaths;
+	if (const FString* PathsParam = ParamVals.Find(TEXT("Paths")))
+	{
+		PathsParam->ParseIntoArray(ContentPaths, TEXT("+"));
+	}
+
+	if (ContentPaths.Num() == 0)
+	{
+		ContentPaths.Add(TEXT("/Game"));
+	}
+
+	const FString* ReportParam = ParamVals.Find(TEXT("Report"));
+	const FString ReportPath = ReportParam ? *ReportParam : GetDefaultReportPath();
+
+	int32 BatchSize = 64;
+	if (const FString* BatchSizeParam = ParamVals.Find(TEXT("BatchSize")))
+	{
+		BatchSize = FMath::Max(1, FCString::Atoi(**BatchSizeParam));
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	// the cache normally loads when the editor's asset registry finishes loading, which doesn't happen in a commandlet
+	FBACache::Get().LoadCache();
+
+	FARFilter Filter;
+	Filter.bRecursivePaths = true;
+	Filter.bRecursiveClasses = true;
+	for (const FString& ContentPath : ContentPaths)
+	{
+		Filter.PackagePaths.Add(FName(*ContentPath));
+	}
+
+#if BA_UE_VERSION_OR_LATER(5, 1)
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+#else
+	Filter.ClassNames.Add(UBlueprint::StaticClass()->GetFName());
+#endif
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	UE_LOG(LogBlueprintAssist, Display, TEXT("BAGraphMaintenance: Processing %d blueprints in %s"), Assets.Num(), *FString::Join(ContentPaths, TEXT(", ")));
+
+	FBAGraphMaintenanceReport Report;
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<FSoftObjectPath> Batch;
+	for (int32 i = 0; i < Assets.Num(); ++i)
+	{
+#if BA_UE_VERSION_OR_LATER(5, 1)
+		Batch.Add(Assets[i].GetSoftObjectPath());
+#else
+		Batch.Add(Assets[i].ToSoftObjectPath());
+#endif
+
+		if (Batch.Num() == BatchSize || i == Assets.Num() - 1)
+		{
+			ProcessBatch(Batch, bCleanup, bFormat, bSave, Report);
+			Batch.Reset();
+
+			// the loaded blueprints are no longer needed
+			CollectGarbage(RF_NoFlags);
+
+			UE_LOG(LogBlueprintAssist, Display, TEXT("BAGraphMaintenance: %d / %d"), i + 1, Assets.Num());
+		}
+	}
+
+	Report.NumAssets = Report.Assets.Num();
+	Report.TotalSeconds = FPlatformTime::Seconds() - StartTime;
+
+	FString JsonAsString;
+	FJsonObjectConverter::UStructToJsonObjectString(Report, JsonAsString);
+	if (!FFileHelper::SaveStringToFile(JsonAsString, *ReportPath))
+	{
+		UE_LOG(LogBlueprintAssist, Error, TEXT("BAGraphMaintenance: Failed to write report %s"), *ReportPath);
+		return 1;
+	}
+
+	UE_LOG(LogBlueprintAssist, Display, TEXT("BAGraphMaintenance: Finished %d blueprints in %.2fs, %d issues (%d errors), %d removed nodes, %d formatted graphs (%d skipped without cached sizes), %d saved. Report: %s"),
+		Report.NumAssets, Report.TotalSeconds, Report.NumIssues, Report.NumErrors, Report.NumRemovedNodes, Report.NumFormattedGraphs, Report.NumUnsizedGraphs, Report.NumSaved, *ReportPath);
+
+	return Report.NumErrors > 0 ? 1 : 0;
+}
+
+void UBAGraphMaintenanceCommandlet::ProcessBatch(const TArray<FSoftObjectPath>& AssetPaths, bool bCleanup, bool bFormat, bool bSave, FBAGraphMaintenanceReport& Report)
+{
+	const int32 FirstReportIndex = Report.Assets.Num();
+	TArray<UBlueprint*> Blueprints;
+	TArray<UEdGraph*> Graphs;
+	TArray<int32> GraphReportIndices;
+
+	// loading must happen on the game thread
+	for (const FSoftObjectPath& AssetPath : AssetPaths)
+	{
+		FBAGraphMaintenanceAssetReport& AssetReport = Report.Assets.AddDefaulted_GetRef();
+		AssetReport.AssetPath = AssetPath.ToString();
+
+		const double LoadStart = FPlatformTime::Seconds();
+		UBlueprint* Blueprint = Cast<UBlueprint>(AssetPath.TryLoad());
+		AssetReport.LoadSeconds = FPlatformTime::Seconds() - LoadStart;
+		AssetReport.bLoaded = Blueprint != nullptr;
+		Blueprints.Add(Blueprint);
+
+		if (!Blueprint)
+		{
+			UE_LOG(LogBlueprintAssist, Warning, TEXT("BAGraphMaintenance: Failed to load %s"), *AssetReport.AssetPath);
+			continue;
+		}
+
+		TArray<UEdGraph*> BlueprintGraphs;
+		Blueprint->GetAllGraphs(BlueprintGraphs);
+		AssetReport.NumGraphs = BlueprintGraphs.Num();
+
+		for (UEdGraph* Graph : BlueprintGraphs)
+		{
+			Graphs.Add(Graph);
+			GraphReportIndices.Add(Report.Assets.Num() - 1);
+		}
+	}
+
+	TArray<FBAGraphLintResult> LintResults;
+	FBAGraphLint::Get().LintGraphs(Graphs, LintResults);
+
+	for (int32 GraphIndex = 0; GraphIndex < Graphs.Num(); ++GraphIndex)
+	{
+		UEdGraph* Graph = Graphs[GraphIndex];
+		const FBAGraphLintResult& LintResult = LintResults[GraphIndex];
+		FBAGraphMaintenanceAssetReport& AssetReport = Report.Assets[GraphReportIndices[GraphIndex]];
+		AssetReport.LintSeconds += LintResult.Seconds;
+
+		for (const FBAGraphIssue& Issue : LintResult.Issues)
+		{
+			FBAGraphMaintenanceIssue& ReportIssue = AssetReport.Issues.AddDefaulted_GetRef();
+			ReportIssue.Severity = BAGraphMaintenance::GetSeverityString(Issue.Severity);
+			ReportIssue.Rule = Issue.Rule.ToString();
+			ReportIssue.Graph = Graph->GetName();
+			ReportIssue.Message = Issue.Message;
+
+			Report.NumIssues += 1;
+			Report.NumErrors += Issue.Severity == EMessageSeverity::Error ? 1 : 0;
+		}
+
+		if (bCleanup)
+		{
+			const double CleanupStart = FPlatformTime::Seconds();
+			const int32 NumRemovedNodes = CleanupGraph(Graph);
+			AssetReport.NumRemovedNodes += NumRemovedNodes;
+			Report.NumRemovedNodes += NumRemovedNodes;
+			AssetReport.CleanupSeconds += FPlatformTime::Seconds() - CleanupStart;
+		}
+
+		// formatting modifies the nodes so it runs on the game thread after the lint
+		if (bFormat)
+		{
+			const double FormatStart = FPlatformTime::Seconds();
+			bool bMissingSizes = false;
+			if (FormatGraph(Graph, bMissingSizes))
+			{
+				AssetReport.NumFormattedGraphs += 1;
+				Report.NumFormattedGraphs += 1;
+				UE_LOG(LogBlueprintAssist, Display, TEXT("BAGraphMaintenance: Formatted %s"), *Graph->GetPathName());
+			}
+			else if (bMissingSizes)
+			{
+				AssetReport.NumUnsizedGraphs += 1;
+				Report.NumUnsizedGraphs += 1;
+			}
+			AssetReport.FormatSeconds += FPlatformTime::Seconds() - FormatStart;
+		}
+	}
+
+	if (!bSave)
+	{
+		return;
+	}
+
+	for (int32 i = 0; i < Blueprints.Num(); ++i)
+	{
+		FBAGraphMaintenanceAssetReport& AssetReport = Report.Assets[FirstReportIndex + i];
+		if (!Blueprints[i] || (AssetReport.NumRemovedNodes == 0 && AssetReport.NumFormattedGraphs == 0))
+		{
+			continue;
+		}
+
+		// mark the blueprint as modified so the save isn't skipped and the blueprint is recompiled with the changes
+		FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprints[i]);
+
+		const double SaveStart = FPlatformTime::Seconds();
+		AssetReport.bSaved = UEditorLoadingAndSavingUtils::SavePackages({ Blueprints[i]->GetOutermost() }, false);
+		AssetReport.SaveSeconds = FPlatformTime::Seconds() - SaveStart;
+
+		if (AssetReport.bSaved)
+		{
+			Report.NumSaved += 1;
+		}
+		else
+		{
+			UE_LOG(LogBlueprintAssist, Warning, TEXT("BAGraphMaintenance: Failed to save %s"), *AssetReport.AssetPath);
+		}
+	}
+}
+
+int32 UBAGraphMaintenanceCommandlet::CleanupGraph(UEdGraph* Graph)
+{
+	if (!IsValid(Graph))
+	{
+		return 0;
+	}
+
+	TArray<UEdGraphNode*> UnlinkedKnots = Graph->Nodes.FilterByPredicate([](UEdGraphNode* Node)
+	{
+		return Cast<UK2Node_Knot>(Node) && FBAUtils::GetLinkedPins(Node).Num() == 0;
+	});
+
+	for (UEdGraphNode* Node : UnlinkedKnots)
+	{
+		FBAUtils::DeleteNode(Node);
+	}
+
+	return UnlinkedKnots.Num();
+}
+
+bool UBAGraphMaintenanceCommandlet::FormatGraph(UEdGraph* Graph, bool& bOutMissingSizes)
+{
+	bOutMissingSizes = false;
+
+	if (!IsValid(Graph) || !FBAUtils::IsBlueprintGraph(Graph) || FBlueprintEditorUtils::IsGraphReadOnly(Graph))
+	{
+		return false;
+	}
+
+	TSharedRef<FBACachedNodeGeometry> Geometry = MakeShared<FBACachedNodeGeometry>(Graph);
+
+	// the formatter would use a default size for these nodes, leave the graph as it is instead
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		FVector2D Size;
+		if (FBAUtils::IsGraphNode(Node) && !FBAUtils::IsKnotNode(Node) && !FBAUtils::IsCommentNode(Node) && !Geometry->GetNodeSize(Node, Size))
+		{
+			UE_LOG(LogBlueprintAssist, Verbose, TEXT("BAGraphMaintenance: Skipped formatting %s, %s has no cached size"), *Graph->GetPathName(), *FBAUtils::GetNodeName(Node));
+			bOutMissingSizes = true;
+			return false;
+		}
+	}
+
+	TMap<UEdGraphNode*, FIntPoint> StartPositions;
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		StartPositions.Add(Node, FIntPoint(Node->NodePosX, Node->NodePosY));
+	}
+
+	TSharedRef<FBAGraphHandler> GraphHandler = FBAGraphHandler::MakeHeadless(Graph, Geometry);
+	GraphHandler->FormatAllEventsImmediate();
+
+	// only report (and save) graphs which the formatting changed
+	return Graph->Nodes.Num() != StartPositions.Num() || Graph->Nodes.ContainsByPredicate([&StartPositions](UEdGraphNode* Node)
+	{
+		const FIntPoint* StartPos = StartPositions.Find(Node);
+		return !StartPos || *StartPos != FIntPoint(Node->NodePosX, Node->NodePosY);
+	});
+}
+
+FString UBAGraphMaintenanceCommandlet::GetDefaultReportPath()
+{
+	return FPaths::ProjectDir() / TEXT("Saved") / TEXT("BlueprintAssist") / TEXT("GraphMaintenanceReport.json");
+}
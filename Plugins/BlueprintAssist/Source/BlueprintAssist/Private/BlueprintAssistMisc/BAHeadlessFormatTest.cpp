@@ -0,0 +1,140 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "BlueprintAssistCache.h"
+#include "BlueprintAssistGraphHandler.h"
+#include "BlueprintAssistUtils.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_CustomEvent.h"
+#include "BlueprintAssistFormatters/BANodeGeometry.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "GameFramework/Actor.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace BAHeadlessFormatTest
+{
+	constexpr int32 NumNodes = 4;
+
+	const FVector2D NodeSize(200, 100);
+
+	/* Event graph with only a custom event and an exec chain of print string nodes, all at the same position */
+	UEdGraph* CreateOverlappingGraph()
+	{
+		UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(
+			AActor::StaticClass(),
+			GetTransientPackage(),
+			MakeUniqueObjectName(GetTransientPackage(), UBlueprint::StaticClass(), TEXT("BA_HeadlessFormatTest")),
+			BPTYPE_Normal,
+			UBlueprint::StaticClass(),
+			UBlueprintGeneratedClass::StaticClass());
+
+		UEdGraph* EventGraph = Blueprint ? FBlueprintEditorUtils::FindEventGraph(Blueprint) : nullptr;
+		if (!EventGraph)
+		{
+			return nullptr;
+		}
+
+		// remove the default event nodes, they have no cached size
+		const TArray<UEdGraphNode*> DefaultNodes = EventGraph->Nodes;
+		for (UEdGraphNode* Node : DefaultNodes)
+		{
+			EventGraph->RemoveNode(Node);
+		}
+
+		FGraphNodeCreator<UK2Node_CustomEvent> EventCreator(*EventGraph);
+		UK2Node_CustomEvent* EventNode = EventCreator.CreateNode(false);
+		EventNode->CustomFunctionName = TEXT("BA_HeadlessFormatTestEvent");
+		EventCreator.Finalize();
+
+		UFunction* PrintString = UKismetSystemLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, PrintString));
+
+		UEdGraphPin* PreviousThenPin = EventNode->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+		for (int32 i = 0; i < NumNodes; ++i)
+		{
+			FGraphNodeCreator<UK2Node_CallFunction> NodeCreator(*EventGraph);
+			UK2Node_CallFunction* Node = NodeCreator.CreateNode(false);
+			Node->SetFromFunction(PrintString);
+			NodeCreator.Finalize();
+
+			PreviousThenPin->MakeLinkTo(Node->GetExecPin());
+			PreviousThenPin = Node->GetThenPin();
+		}
+
+		return EventGraph;
+	}
+
+	/* Sizes and pin offsets as if every node had been measured in a graph editor */
+	void CacheNodeSizes(UEdGraph* Graph)
+	{
+		FBAGraphData& GraphData = FBACache::Get().GetGraphData(Graph);
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			FBANodeData& NodeData = GraphData.GetNodeData(Node);
+			NodeData.SetSize(NodeSize);
+
+			int32 NumInputs = 0;
+			int32 NumOutputs = 0;
+			for (UEdGraphPin* Pin : Node->Pins)
+			{
+				int32& PinIndex = Pin->Direction == EGPD_Input ? NumInputs : NumOutputs;
+				NodeData.CachedPins.Add(Pin->PinId, 30 + 20 * PinIndex++);
+			}
+		}
+	}
+
+	void RemoveCachedGraph(UEdGraph* Graph)
+	{
+		if (FBAPackageData* PackageData = FBACache::Get().GetCacheData().PackageData.Find(Graph->GetOutermost()->GetFName()))
+		{
+			PackageData->GraphData.Remove(FBAUtils::GetGraphGuid(Graph));
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBAHeadlessFormatTest, "BlueprintAssist.Formatting.Headless", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FBAHeadlessFormatTest::RunTest(const FString& Parameters)
+{
+	UEdGraph* Graph = BAHeadlessFormatTest::CreateOverlappingGraph();
+	if (!Graph)
+	{
+		AddError(TEXT("Failed to create the test blueprint"));
+		return false;
+	}
+
+	BAHeadlessFormatTest::CacheNodeSizes(Graph);
+
+	TSharedRef<FBACachedNodeGeometry> Geometry = MakeShared<FBACachedNodeGeometry>(Graph);
+	FBAGraphHandler::MakeHeadless(Graph, Geometry)->FormatAllEventsImmediate();
+
+	TestTrue(TEXT("Formatting moved the nodes"), Graph->Nodes.ContainsByPredicate([](UEdGraphNode* Node)
+	{
+		return Node->NodePosX != 0 || Node->NodePosY != 0;
+	}));
+
+	for (int32 i = 0; i < Graph->Nodes.Num(); ++i)
+	{
+		const FSlateRect Bounds = FBANodeGeometryUtils::GetNodeBounds(*Geometry, Graph->Nodes[i]);
+		TestEqual(TEXT("Node uses the cached size"), Bounds.GetSize(), BAHeadlessFormatTest::NodeSize);
+
+		for (int32 j = i + 1; j < Graph->Nodes.Num(); ++j)
+		{
+			const FSlateRect OtherBounds = FBANodeGeometryUtils::GetNodeBounds(*Geometry, Graph->Nodes[j]);
+			TestFalse(
+				FString::Printf(TEXT("%s does not overlap %s"), *FBAUtils::GetNodeName(Graph->Nodes[i]), *FBAUtils::GetNodeName(Graph->Nodes[j])),
+				FSlateRect::DoRectanglesIntersect(Bounds, OtherBounds));
+		}
+	}
+
+	BAHeadlessFormatTest::RemoveCachedGraph(Graph);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,372 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "BlueprintAssistMisc/BASearchIndex.h"
+
+void FBASearchIndex::Reset(int32 NumItems)
+{
+	Entries.Reset(NumItems);
+	Chars.Reset();
+	TrigramOffsets.Reset();
+	TrigramItems.Reset();
+	bTrigramsBuilt = false;
+	PreviousQuery.Reset();
+	PreviousMatches.Reset();
+	PreviousSubsequenceQuery.Reset();
+	PreviousSubsequenceMatches.Reset();
+}
+
+void FBASearchIndex::AddItem(const FString& SearchText, const FString& KeySearchText)
+{
+	FEntry& Entry = Entries.AddDefaulted_GetRef();
+
+	Entry.SearchOffset = Chars.Num();
+	for (TCHAR Char : SearchText)
+	{
+		if (Char != TEXT(' '))
+		{
+			const TCHAR LowerChar = FChar::ToLower(Char);
+			Chars.Add(LowerChar);
+			Entry.CharMask |= GetCharBit(LowerChar);
+		}
+	}
+	Entry.SearchLen = Chars.Num() - Entry.SearchOffset;
+	Chars.Add(TEXT('\0'));
+
+	Entry.KeyOffset = Chars.Num();
+	for (TCHAR Char : KeySearchText)
+	{
+		Chars.Add(FChar::ToLower(Char));
+	}
+	Entry.KeyLen = KeySearchText.Len();
+	Chars.Add(TEXT('\0'));
+
+	bTrigramsBuilt = false;
+	PreviousQuery.Reset();
+	PreviousSubsequenceQuery.Reset();
+}
+
+void FBASearchIndex::Search(const FString& Query, TArray<int32>& OutResults, int32 MaxSortedResults)
+{
+	OutResults.Reset();
+
+	const FString LowerQuery = Query.TrimStartAndEnd().ToLower();
+
+	TArray<FString> Terms;
+	LowerQuery.ParseIntoArray(Terms, TEXT(" "), true);
+
+	if (Terms.Num() == 0)
+	{
+		OutResults.Reserve(Entries.Num());
+		for (int32 Index = 0; Index < Entries.Num(); ++Index)
+		{
+			OutResults.Add(Index);
+		}
+
+		PreviousQuery.Reset();
+		return;
+	}
+
+	uint64 QueryMask = 0;
+	for (const FString& Term : Terms)
+	{
+		for (TCHAR Char : Term)
+		{
+			QueryMask |= GetCharBit(Char);
+		}
+	}
+
+	// extending the previous query can only remove matches, so only check the previous matches
+	TOptional<TArrayView<const int32>> Candidates;
+	if (!PreviousQuery.IsEmpty() && LowerQuery.StartsWith(PreviousQuery, ESearchCase::CaseSensitive))
+	{
+		Candidates = TArrayView<const int32>(PreviousMatches);
+	}
+
+	const TArrayView<const int32> TrigramCandidates = GetTrigramCandidates(Terms);
+	if (TrigramCandidates.GetData() && (!Candidates.IsSet() || TrigramCandidates.Num() < Candidates->Num()))
+	{
+		Candidates = TrigramCandidates;
+	}
+
+	TArray<int32> Matches;
+	const auto CheckItem = [&](const int32 Index)
+	{
+		const FEntry& Entry = Entries[Index];
+		if ((Entry.CharMask & QueryMask) != QueryMask)
+		{
+			return;
+		}
+
+		const TCHAR* SearchText = GetSearchText(Entry);
+		for (const FString& Term : Terms)
+		{
+			if (!FCString::Strstr(SearchText, *Term))
+			{
+				return;
+			}
+		}
+
+		Matches.Add(Index);
+	};
+
+	if (Candidates.IsSet())
+	{
+		for (const int32 Index : Candidates.GetValue())
+		{
+			CheckItem(Index);
+		}
+	}
+	else
+	{
+		for (int32 Index = 0; Index < Entries.Num(); ++Index)
+		{
+			CheckItem(Index);
+		}
+	}
+
+	TArray<FScoredItem> Scored;
+	Scored.Reserve(Matches.Num());
+
+	if (Matches.Num() > 0)
+	{
+		const FString& FirstTerm = Terms[0];
+		for (const int32 Index : Matches)
+		{
+			const FEntry& Entry = Entries[Index];
+			const bool bExactMatch = Entry.KeyLen == LowerQuery.Len() && FCString::Strcmp(GetKeyText(Entry), *LowerQuery) == 0;
+			const bool bPrefixMatch = FCString::Strncmp(GetSearchText(Entry), *FirstTerm, FirstTerm.Len()) == 0;
+
+			const int32 Score = (bExactMatch ? (1 << 30) : 0) + (bPrefixMatch ? (1 << 20) : 0) - Entry.KeyLen;
+			Scored.Add({ Index, Score });
+		}
+	}
+	else
+	{
+		// no item contains the terms, fall back to items containing the characters in order
+		const FString JoinedQuery = FString::Join(Terms, TEXT(""));
+		const bool bExtendsPrevious = !PreviousSubsequenceQuery.IsEmpty() && JoinedQuery.StartsWith(PreviousSubsequenceQuery, ESearchCase::CaseSensitive);
+
+		TArray<int32> SubsequenceMatches;
+		const auto CheckSubsequence = [&](const int32 Index)
+		{
+			const FEntry& Entry = Entries[Index];
+			if ((Entry.CharMask & QueryMask) != QueryMask)
+			{
+				return;
+			}
+
+			const int32 Gaps = GetSubsequenceGaps(GetSearchText(Entry), JoinedQuery);
+			if (Gaps != INDEX_NONE)
+			{
+				SubsequenceMatches.Add(Index);
+				Scored.Add({ Index, -(Gaps * 64 + Entry.KeyLen) });
+			}
+		};
+
+		if (bExtendsPrevious)
+		{
+			for (const int32 Index : PreviousSubsequenceMatches)
+			{
+				CheckSubsequence(Index);
+			}
+		}
+		else
+		{
+			for (int32 Index = 0; Index < Entries.Num(); ++Index)
+			{
+				CheckSubsequence(Index);
+			}
+		}
+
+		PreviousSubsequenceQuery = JoinedQuery;
+		PreviousSubsequenceMatches = MoveTemp(SubsequenceMatches);
+	}
+
+	// subsequence matches are mostly noise past the best few, so only keep the sorted ones
+	const bool bSubsequenceFallback = Matches.Num() == 0;
+
+	PreviousQuery = LowerQuery;
+	PreviousMatches = MoveTemp(Matches);
+
+	SelectBest(Scored, OutResults, MaxSortedResults, bSubsequenceFallback);
+}
+
+void FBASearchIndex::BuildTrigrams()
+{
+	// two passes: count the items per bucket, then fill the buckets contiguously
+	TrigramOffsets.Init(0, NumTrigramBuckets + 1);
+
+	TArray<int32> LastItem;
+	LastItem.Init(INDEX_NONE, NumTrigramBuckets);
+
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		const FEntry& Entry = Entries[Index];
+		const TCHAR* Text = GetSearchText(Entry);
+		for (int32 i = 0; i + 3 <= Entry.SearchLen; ++i)
+		{
+			const uint32 Bucket = GetTrigramBucket(Text + i);
+			if (LastItem[Bucket] != Index)
+			{
+				LastItem[Bucket] = Index;
+				++TrigramOffsets[Bucket + 1];
+			}
+		}
+	}
+
+	for (int32 Bucket = 0; Bucket < NumTrigramBuckets; ++Bucket)
+	{
+		TrigramOffsets[Bucket + 1] += TrigramOffsets[Bucket];
+	}
+
+	TrigramItems.SetNumUninitialized(TrigramOffsets[NumTrigramBuckets]);
+
+	TArray<int32> Cursors(TrigramOffsets.GetData(), NumTrigramBuckets);
+	LastItem.Init(INDEX_NONE, NumTrigramBuckets);
+
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		const FEntry& Entry = Entries[Index];
+		const TCHAR* Text = GetSearchText(Entry);
+		for (int32 i = 0; i + 3 <= Entry.SearchLen; ++i)
+		{
+			const uint32 Bucket = GetTrigramBucket(Text + i);
+			if (LastItem[Bucket] != Index)
+			{
+				LastItem[Bucket] = Index;
+				TrigramItems[Cursors[Bucket]++] = Index;
+			}
+		}
+	}
+
+	bTrigramsBuilt = true;
+}
+
+TArrayView<const int32> FBASearchIndex::GetTrigramCandidates(const TArray<FString>& Terms)
+{
+	// every match must contain all the trigrams of every term, so the smallest bucket is a superset of the matches
+	TArrayView<const int32> Smallest;
+	for (const FString& Term : Terms)
+	{
+		if (Term.Len() < 3)
+		{
+			continue;
+		}
+
+		if (!bTrigramsBuilt)
+		{
+			BuildTrigrams();
+		}
+
+		for (int32 i = 0; i + 3 <= Term.Len(); ++i)
+		{
+			const uint32 Bucket = GetTrigramBucket(*Term + i);
+			const int32 Start = TrigramOffsets[Bucket];
+			const int32 Count = TrigramOffsets[Bucket + 1] - Start;
+
+			if (!Smallest.GetData() || Count < Smallest.Num())
+			{
+				// use a valid pointer for empty buckets so the caller can tell it apart from "no trigrams"
+				Smallest = TArrayView<const int32>(Count > 0 ? &TrigramItems[Start] : TrigramOffsets.GetData(), Count);
+			}
+		}
+	}
+
+	return Smallest;
+}
+
+void FBASearchIndex::SelectBest(TArray<FScoredItem>& Scored, TArray<int32>& OutResults, int32 MaxSortedResults, bool bDiscardUnsorted) const
+{
+	// items are scored in item order, so ties keep the item order
+	const auto IsBetter = [](const FScoredItem& A, const FScoredItem& B)
+	{
+		return A.Score > B.Score || (A.Score == B.Score && A.Index < B.Index);
+	};
+
+	OutResults.Reserve(Scored.Num());
+
+	if (Scored.Num() <= MaxSortedResults)
+	{
+		Scored.Sort(IsBetter);
+		for (const FScoredItem& Item : Scored)
+		{
+			OutResults.Add(Item.Index);
+		}
+
+		return;
+	}
+
+	// keep the best items in a heap with the worst of them on top
+	const auto IsWorse = [&IsBetter](const FScoredItem& A, const FScoredItem& B)
+	{
+		return IsBetter(B, A);
+	};
+
+	TArray<FScoredItem> Best;
+	Best.Reserve(MaxSortedResults + 1);
+	for (const FScoredItem& Item : Scored)
+	{
+		if (Best.Num() < MaxSortedResults)
+		{
+			Best.HeapPush(Item, IsWorse);
+		}
+		else if (IsBetter(Item, Best.HeapTop()))
+		{
+			Best.HeapPopDiscard(IsWorse, false);
+			Best.HeapPush(Item, IsWorse);
+		}
+	}
+
+	Best.Sort(IsBetter);
+
+	TBitArray<> bIsBest(false, Entries.Num());
+	for (const FScoredItem& Item : Best)
+	{
+		OutResults.Add(Item.Index);
+		bIsBest[Item.Index] = true;
+	}
+
+	if (bDiscardUnsorted)
+	{
+		return;
+	}
+
+	for (const FScoredItem& Item : Scored)
+	{
+		if (!bIsBest[Item.Index])
+		{
+			OutResults.Add(Item.Index);
+		}
+	}
+}
+
+int32 FBASearchIndex::GetSubsequenceGaps(const TCHAR* Text, const FString& Query)
+{
+	int32 Gaps = 0;
+	int32 QueryIndex = 0;
+	bool bStarted = false;
+
+	for (const TCHAR* Char = Text; *Char && QueryIndex < Query.Len(); ++Char)
+	{
+		if (*Char == Query[QueryIndex])
+		{
+			++QueryIndex;
+			bStarted = true;
+		}
+		else if (bStarted)
+		{
+			++Gaps;
+		}
+	}
+
+	return QueryIndex == Query.Len() ? Gaps : INDEX_NONE;
+}
+
+uint32 FBASearchIndex::GetTrigramBucket(const TCHAR* Chars)
+{
+	const uint32 Hash = static_cast<uint32>(Chars[0]) * 0x9E3779B1u
+		^ static_cast<uint32>(Chars[1]) * 0x85EBCA77u
+		^ static_cast<uint32>(Chars[2]) * 0xC2B2AE3Du;
+
+	return (Hash >> 16) & (NumTrigramBuckets - 1);
+}
@@ -0,0 +1,117 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "BlueprintAssistMisc/BASearchIndex.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace BASearchIndexTest
+{
+	/* Items are added with the same search and key text, like the open file menu */
+	void AddItems(FBASearchIndex& Index, const TArray<FString>& Items)
+	{
+		Index.Reset(Items.Num());
+		for (const FString& Item : Items)
+		{
+			Index.AddItem(Item, Item);
+		}
+	}
+
+	TArray<int32> Search(FBASearchIndex& Index, const FString& Query, int32 MaxSortedResults = 256)
+	{
+		TArray<int32> Results;
+		Index.Search(Query, Results, MaxSortedResults);
+		return Results;
+	}
+
+	/* Reference results from a fresh index, so no previous query or trigram state is reused */
+	TArray<int32> SearchFresh(const TArray<FString>& Items, const FString& Query, int32 MaxSortedResults = 256)
+	{
+		FBASearchIndex Index;
+		AddItems(Index, Items);
+		return Search(Index, Query, MaxSortedResults);
+	}
+
+	/* Many similar names so the trigram buckets and the previous matches are both used */
+	TArray<FString> MakeLargeItemList()
+	{
+		TArray<FString> Items;
+		for (int32 i = 0; i < 5000; ++i)
+		{
+			Items.Add(FString::Printf(TEXT("BP_Actor_%d"), i));
+			Items.Add(FString::Printf(TEXT("WBP_Widget_%d"), i));
+		}
+
+		Items.Add(TEXT("BP_Character"));
+		return Items;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBASearchIndexTermsTest, "BlueprintAssist.SearchIndex.Terms", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FBASearchIndexTermsTest::RunTest(const FString& Parameters)
+{
+	const TArray<FString> Items = { TEXT("Print String"), TEXT("Print Text"), TEXT("String Length"), TEXT("Delay Until Next Tick"), TEXT("Delay") };
+
+	FBASearchIndex Index;
+	BASearchIndexTest::AddItems(Index, Items);
+
+	TestEqual(TEXT("Empty query returns every item in order"), BASearchIndexTest::Search(Index, TEXT("")), TArray<int32>({ 0, 1, 2, 3, 4 }));
+	TestEqual(TEXT("Every term must match"), BASearchIndexTest::Search(Index, TEXT("string print")), TArray<int32>({ 0 }));
+	TestEqual(TEXT("Search is case insensitive and ignores spaces in the items"), BASearchIndexTest::Search(Index, TEXT("PRINTSTR")), TArray<int32>({ 0 }));
+	TestEqual(TEXT("Prefix matches are ranked first"), BASearchIndexTest::Search(Index, TEXT("str")), TArray<int32>({ 2, 0 }));
+	TestEqual(TEXT("Exact key matches are ranked first"), BASearchIndexTest::Search(Index, TEXT("delay")), TArray<int32>({ 4, 3 }));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBASearchIndexIncrementalTest, "BlueprintAssist.SearchIndex.Incremental", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FBASearchIndexIncrementalTest::RunTest(const FString& Parameters)
+{
+	const TArray<FString> Items = BASearchIndexTest::MakeLargeItemList();
+
+	FBASearchIndex Index;
+	BASearchIndexTest::AddItems(Index, Items);
+
+	// type a query one character at a time, then delete back to an unrelated query
+	const TArray<FString> Queries = {
+		TEXT("b"), TEXT("bp"), TEXT("bp_"), TEXT("bp_a"), TEXT("bp_actor_12"), TEXT("bp_actor_123"),
+		TEXT("bp_actor_1"), TEXT("wbp widget 4"), TEXT("wbp widget 49"), TEXT("char"), TEXT("") };
+
+	for (const FString& Query : Queries)
+	{
+		TestEqual(FString::Printf(TEXT("Results for '%s' match a fresh index"), *Query), BASearchIndexTest::Search(Index, Query), BASearchIndexTest::SearchFresh(Items, Query));
+	}
+
+	const TArray<int32> Results = BASearchIndexTest::Search(Index, TEXT("bp_actor_4999"));
+	TestTrue(TEXT("Exact match is the first result"), Results.Num() > 0 && Items[Results[0]] == TEXT("BP_Actor_4999"));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBASearchIndexSubsequenceTest, "BlueprintAssist.SearchIndex.Subsequence", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FBASearchIndexSubsequenceTest::RunTest(const FString& Parameters)
+{
+	const TArray<FString> Items = BASearchIndexTest::MakeLargeItemList();
+
+	FBASearchIndex Index;
+	BASearchIndexTest::AddItems(Index, Items);
+
+	// no item contains "bpchr", so the items containing the characters in order are returned
+	const TArray<int32> Results = BASearchIndexTest::Search(Index, TEXT("bpchr"));
+	TestTrue(TEXT("Subsequence match is found"), Results.Num() > 0 && Items[Results[0]] == TEXT("BP_Character"));
+
+	// every "WBP_Widget_N" item contains "wwd" as a subsequence, only the best sorted results are returned
+	constexpr int32 MaxSortedResults = 32;
+	TestEqual(TEXT("Subsequence matches are limited to the sorted results"), BASearchIndexTest::Search(Index, TEXT("wwd"), MaxSortedResults).Num(), MaxSortedResults);
+
+	// extending a subsequence query only checks the previous subsequence matches
+	TestEqual(TEXT("Extended subsequence query matches a fresh index"), BASearchIndexTest::Search(Index, TEXT("wwd9"), MaxSortedResults), BASearchIndexTest::SearchFresh(Items, TEXT("wwd9"), MaxSortedResults));
+	TestEqual(TEXT("Unmatched query returns nothing"), BASearchIndexTest::Search(Index, TEXT("zzzz")).Num(), 0);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,173 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "BlueprintAssistMisc/BlueprintAssistInputLatency.h"
+
+#include "BlueprintAssistGlobals.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/LazySingleton.h"
+
+UE_TRACE_CHANNEL_DEFINE(BlueprintAssistInputChannel);
+
+namespace BAInputLatency
+{
+	static FAutoConsoleCommand InputLatencyCommand(
+		TEXT("BlueprintAssist.InputLatency"),
+		TEXT("Print the latency of the Blueprint Assist input handlers. Pass 'start' / 'stop' to toggle recording or 'reset' to clear the recorded data."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			if (Args.Num() > 0 && Args[0].Equals(TEXT("start"), ESearchCase::IgnoreCase))
+			{
+				FBAInputLatencyTracker::Get().SetRecording(true);
+				UE_LOG(LogBlueprintAssist, Log, TEXT("Started recording input latency"));
+			}
+			else if (Args.Num() > 0 && Args[0].Equals(TEXT("stop"), ESearchCase::IgnoreCase))
+			{
+				FBAInputLatencyTracker::Get().SetRecording(false);
+				UE_LOG(LogBlueprintAssist, Log, TEXT("Stopped recording input latency"));
+			}
+			else if (Args.Num() > 0 && Args[0].Equals(TEXT("reset"), ESearchCase::IgnoreCase))
+			{
+				FBAInputLatencyTracker::Get().Reset();
+				UE_LOG(LogBlueprintAssist, Log, TEXT("Reset input latency"));
+			}
+			else
+			{
+				FBAInputLatencyTracker::Get().LogReport();
+			}
+		}));
+}
+
+void FBALatencyHistogram::Add(double Microseconds)
+{
+	const int32 Bucket = Microseconds < 1.0 ? 0 : FMath::Min(FMath::FloorLog2(static_cast<uint32>(FMath::Min(Microseconds, static_cast<double>(MAX_uint32)))) + 1, NumBuckets - 1);
+	Buckets[Bucket] += 1;
+	Count += 1;
+	TotalMicroseconds += Microseconds;
+	MaxMicroseconds = FMath::Max(MaxMicroseconds, Microseconds);
+}
+
+double FBALatencyHistogram::GetPercentile(float Percentile) const
+{
+	if (Count == 0)
+	{
+		return 0.0;
+	}
+
+	const uint32 Target = FMath::Max(1u, static_cast<uint32>(FMath::CeilToInt(Count * Percentile)));
+
+	uint32 Cumulative = 0;
+	for (int32 i = 0; i < NumBuckets; ++i)
+	{
+		Cumulative += Buckets[i];
+		if (Cumulative >= Target)
+		{
+			// bucket i holds [2^(i-1), 2^i) microseconds
+			return FMath::Min(static_cast<double>(1u << i), MaxMicroseconds);
+		}
+	}
+
+	return MaxMicroseconds;
+}
+
+FBAInputLatencyTracker& FBAInputLatencyTracker::Get()
+{
+	return TLazySingleton<FBAInputLatencyTracker>::Get();
+}
+
+void FBAInputLatencyTracker::Record(EBAInputHandler Handler, double Microseconds, FName DispatchedCommand)
+{
+	Histograms[static_cast<int32>(Handler)].Add(Microseconds);
+
+	if (!DispatchedCommand.IsNone())
+	{
+		TPair<int32, double>& Entry = CommandLatency.FindOrAdd(DispatchedCommand, TPair<int32, double>(0, 0.0));
+		Entry.Key += 1;
+		Entry.Value = FMath::Max(Entry.Value, Microseconds);
+	}
+}
+
+FName FBAInputLatencyTracker::ConsumeDispatchedCommand()
+{
+	const FName Command = CurrentCommand;
+	CurrentCommand = NAME_None;
+	return Command;
+}
+
+void FBAInputLatencyTracker::LogReport() const
+{
+	if (!bRecording)
+	{
+		UE_LOG(LogBlueprintAssist, Log, TEXT("Input latency is not being recorded, run \"BlueprintAssist.InputLatency start\""));
+	}
+
+	UE_LOG(LogBlueprintAssist, Log, TEXT("Input handler latency (us):"));
+	for (int32 i = 0; i < static_cast<int32>(EBAInputHandler::Num); ++i)
+	{
+		const FBALatencyHistogram& Histogram = Histograms[i];
+		UE_LOG(LogBlueprintAssist, Log, TEXT("\t%-16s count %6u | avg %8.1f | p50 %8.0f | p99 %8.0f | max %8.1f"),
+			GetHandlerName(static_cast<EBAInputHandler>(i)),
+			Histogram.Count,
+			Histogram.GetAverage(),
+			Histogram.GetPercentile(0.5f),
+			Histogram.GetPercentile(0.99f),
+			Histogram.MaxMicroseconds);
+	}
+
+	if (CommandLatency.Num() > 0)
+	{
+		UE_LOG(LogBlueprintAssist, Log, TEXT("Dispatched commands:"));
+		for (const auto& Elem : CommandLatency)
+		{
+			UE_LOG(LogBlueprintAssist, Log, TEXT("\t%s: count %d | max %.1f"), *Elem.Key.ToString(), Elem.Value.Key, Elem.Value.Value);
+		}
+	}
+}
+
+void FBAInputLatencyTracker::Reset()
+{
+	for (FBALatencyHistogram& Histogram : Histograms)
+	{
+		Histogram = FBALatencyHistogram();
+	}
+
+	CommandLatency.Reset();
+	CurrentCommand = NAME_None;
+}
+
+const TCHAR* FBAInputLatencyTracker::GetHandlerName(EBAInputHandler Handler)
+{
+	switch (Handler)
+	{
+		case EBAInputHandler::KeyDown:
+			return TEXT("KeyDown");
+		case EBAInputHandler::MouseButtonDown:
+			return TEXT("MouseButtonDown");
+		case EBAInputHandler::MouseMove:
+			return TEXT("MouseMove");
+		default:
+			return TEXT("Unknown");
+	}
+}
+
+FBAScopedInputLatency::FBAScopedInputLatency(EBAInputHandler InHandler)
+	: Handler(InHandler)
+	, bRecording(FBAInputLatencyTracker::Get().IsRecording())
+{
+	if (bRecording)
+	{
+		StartTime = FPlatformTime::Seconds();
+		FBAInputLatencyTracker::Get().ConsumeDispatchedCommand();
+	}
+}
+
+FBAScopedInputLatency::~FBAScopedInputLatency()
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	FBAInputLatencyTracker& Tracker = FBAInputLatencyTracker::Get();
+	Tracker.Record(Handler, (FPlatformTime::Seconds() - StartTime) * 1000000.0, Tracker.ConsumeDispatchedCommand());
+}
@@ -0,0 +1,189 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "BlueprintAssistCommands.h"
+#include "BlueprintAssistGraphHandler.h"
+#include "BlueprintAssistInputProcessor.h"
+#include "BlueprintAssistTabHandler.h"
+#include "Editor.h"
+#include "K2Node_CallFunction.h"
+#include "BlueprintAssistMisc/BlueprintAssistInputLatency.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "Framework/Application/SlateApplication.h"
+#include "GameFramework/Actor.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/AutomationTest.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "Widgets/SWindow.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace BAInputLatencyTest
+{
+	constexpr int32 NumNodes = 2000;
+	constexpr int32 NumKeyEvents = 500;
+
+	// the histogram percentiles are rounded up to a power of two
+	constexpr double MaxMedianMicroseconds = 1024.0;
+
+	constexpr double OpenEditorTimeout = 10.0;
+
+	/* Event graph with a long exec chain of print string nodes */
+	UBlueprint* CreateLargeBlueprint()
+	{
+		UBlueprint* Blueprint = FKismetEditorUtilities::CreateBlueprint(
+			AActor::StaticClass(),
+			GetTransientPackage(),
+			MakeUniqueObjectName(GetTransientPackage(), UBlueprint::StaticClass(), TEXT("BA_InputLatencyTest")),
+			BPTYPE_Normal,
+			UBlueprint::StaticClass(),
+			UBlueprintGeneratedClass::StaticClass());
+
+		UEdGraph* EventGraph = Blueprint ? FBlueprintEditorUtils::FindEventGraph(Blueprint) : nullptr;
+		if (!EventGraph)
+		{
+			return nullptr;
+		}
+
+		UFunction* PrintString = UKismetSystemLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, PrintString));
+
+		UK2Node_CallFunction* PreviousNode = nullptr;
+		for (int32 i = 0; i < NumNodes; ++i)
+		{
+			FGraphNodeCreator<UK2Node_CallFunction> NodeCreator(*EventGraph);
+			UK2Node_CallFunction* Node = NodeCreator.CreateNode(false);
+			Node->SetFromFunction(PrintString);
+			Node->NodePosX = (i % 50) * 400;
+			Node->NodePosY = (i / 50) * 300;
+			NodeCreator.Finalize();
+
+			if (PreviousNode)
+			{
+				PreviousNode->GetThenPin()->MakeLinkTo(Node->GetExecPin());
+			}
+
+			PreviousNode = Node;
+		}
+
+		return Blueprint;
+	}
+}
+
+/* Waits until the graph handler for the opened graph is active */
+class FBAWaitForGraphHandlerCommand final : public IAutomationLatentCommand
+{
+public:
+	explicit FBAWaitForGraphHandlerCommand(TWeakObjectPtr<UEdGraph> InGraph)
+		: Graph(InGraph) { }
+
+	virtual bool Update() override
+	{
+		TSharedPtr<FBAGraphHandler> GraphHandler = FBATabHandler::Get().GetActiveGraphHandler();
+		const bool bReady = GraphHandler.IsValid() && Graph.IsValid() && GraphHandler->GetFocusedEdGraph() == Graph.Get();
+		return bReady || GetCurrentRunTime() > BAInputLatencyTest::OpenEditorTimeout;
+	}
+
+private:
+	TWeakObjectPtr<UEdGraph> Graph;
+};
+
+/* Sends the focus graph panel chord through the input processor, checks it reached the graph command dispatch and the median latency */
+class FBAMeasureKeyDownCommand final : public IAutomationLatentCommand
+{
+public:
+	FBAMeasureKeyDownCommand(FAutomationTestBase* InTest, TWeakObjectPtr<UBlueprint> InBlueprint)
+		: Test(InTest)
+		, Blueprint(InBlueprint) { }
+
+	virtual bool Update() override
+	{
+		UEdGraph* EventGraph = Blueprint.IsValid() ? FBlueprintEditorUtils::FindEventGraph(Blueprint.Get()) : nullptr;
+		TSharedPtr<FBAGraphHandler> GraphHandler = FBATabHandler::Get().GetActiveGraphHandler();
+		if (!GraphHandler.IsValid() || !EventGraph || GraphHandler->GetFocusedEdGraph() != EventGraph)
+		{
+			Test->AddError(TEXT("Failed to open the test blueprint in a graph editor"));
+			CloseEditor();
+			return true;
+		}
+
+		// a read only graph command, so the key event passes every context check before it is dispatched
+		const TSharedPtr<FUICommandInfo> Command = FBACommands::Get().FocusGraphPanel;
+		const FInputChord Chord = *Command->GetFirstValidChord();
+		if (!Chord.IsValidChord())
+		{
+			Test->AddError(TEXT("FocusGraphPanel has no chord bound"));
+			CloseEditor();
+			return true;
+		}
+
+		// the graph commands are only dispatched while the graph editor's window is active and its panel has focus
+		if (TSharedPtr<SWindow> Window = GraphHandler->GetWindow())
+		{
+			Window->BringToFront(true);
+			FSlateApplication::Get().SetKeyboardFocus(GraphHandler->GetGraphPanel(), EFocusCause::SetDirectly);
+		}
+
+		FBAInputLatencyTracker& Tracker = FBAInputLatencyTracker::Get();
+		const bool bWasRecording = Tracker.IsRecording();
+		Tracker.Reset();
+		Tracker.SetRecording(true);
+
+		const FModifierKeysState ModifierKeys(Chord.bShift, false, Chord.bCtrl, false, Chord.bAlt, false, Chord.bCmd, false, false);
+		const FKeyEvent KeyEvent(Chord.Key, ModifierKeys, 0, false, 0, 0);
+
+		int32 NumHandled = 0;
+		for (int32 i = 0; i < BAInputLatencyTest::NumKeyEvents; ++i)
+		{
+			NumHandled += FBAInputProcessor::Get().HandleKeyDownEvent(FSlateApplication::Get(), KeyEvent) ? 1 : 0;
+		}
+
+		const FBALatencyHistogram& Histogram = Tracker.GetHistogram(EBAInputHandler::KeyDown);
+		const double Median = Histogram.GetPercentile(0.5f);
+
+		Test->TestEqual(TEXT("Recorded key events"), static_cast<int32>(Histogram.Count), BAInputLatencyTest::NumKeyEvents);
+		Test->TestEqual(TEXT("Key events handled by the input processor"), NumHandled, BAInputLatencyTest::NumKeyEvents);
+		Test->TestEqual(TEXT("Dispatched FocusGraphPanel commands"), Tracker.GetDispatchCount(Command->GetCommandName()), BAInputLatencyTest::NumKeyEvents);
+		Test->TestTrue(
+			FString::Printf(TEXT("Median key down latency %.0fus on %d nodes (max %.0fus)"), Median, BAInputLatencyTest::NumNodes, BAInputLatencyTest::MaxMedianMicroseconds),
+			Median <= BAInputLatencyTest::MaxMedianMicroseconds);
+
+		Tracker.Reset();
+		Tracker.SetRecording(bWasRecording);
+
+		CloseEditor();
+		return true;
+	}
+
+private:
+	void CloseEditor()
+	{
+		if (Blueprint.IsValid())
+		{
+			GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->CloseAllEditorsForAsset(Blueprint.Get());
+		}
+	}
+
+	FAutomationTestBase* Test;
+	TWeakObjectPtr<UBlueprint> Blueprint;
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBAInputLatencyKeyDownTest, "BlueprintAssist.InputLatency.KeyDownLargeGraph", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FBAInputLatencyKeyDownTest::RunTest(const FString& Parameters)
+{
+	UBlueprint* Blueprint = BAInputLatencyTest::CreateLargeBlueprint();
+	if (!TestNotNull(TEXT("Test blueprint"), Blueprint))
+	{
+		return false;
+	}
+
+	GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->OpenEditorForAsset(Blueprint);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FBAWaitForGraphHandlerCommand(FBlueprintEditorUtils::FindEventGraph(Blueprint)));
+	ADD_LATENT_AUTOMATION_COMMAND(FBAMeasureKeyDownCommand(this, Blueprint));
+	return true;
+}
+
+#endif
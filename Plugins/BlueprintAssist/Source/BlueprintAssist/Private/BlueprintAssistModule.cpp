@@ -2,19 +2,26 @@
 
 #include "BlueprintAssistModule.h"
 
+#include "BlueprintAssistActionMenuCache.h"
+#include "BlueprintAssistAssetIndex.h"
 #include "BlueprintAssistCache.h"
 #include "BlueprintAssistCommands.h"
 #include "BlueprintAssistGlobals.h"
 #include "BlueprintAssistGraphCommands.h"
 #include "BlueprintAssistGraphExtender.h"
+#include "BlueprintAssistGraphLint.h"
 #include "BlueprintAssistGraphPanelNodeFactory.h"
 #include "BlueprintAssistInputProcessor.h"
+#include "BlueprintAssistOpenWindowIndex.h"
 #include "BlueprintAssistSettings.h"
 #include "BlueprintAssistSettings_Advanced.h"
 #include "BlueprintAssistSettings_EditorFeatures.h"
 #include "BlueprintAssistStyle.h"
+#include "BlueprintAssistSymbolIndex.h"
 #include "BlueprintAssistTabHandler.h"
 #include "BlueprintAssistToolbar.h"
+#include "BlueprintAssistVariableIndex.h"
+#include "BlueprintAssistWidgetQuery.h"
 #include "BlueprintEditorModule.h"
 #include "PropertyEditorModule.h"
 #include "BlueprintAssistObjects/BARootObject.h"
@@ -75,6 +82,14 @@ void FBlueprintAssistModule::OnPostEngineInit()
 	// Init singletons
 	FBACache::Get().Init();
 	FBATabHandler::Get().Init();
+	FBAWidgetQuery::Get().Init();
+	FBAAssetIndex::Get().Init();
+	FBAOpenWindowIndex::Get().Init();
+	FBASymbolIndex::Get().Init();
+	FBAVariableIndex::Get().Init();
+#if BA_UE_VERSION_OR_LATER(5, 1)
+	FBAActionMenuCache::Get().Init();
+#endif
 	FBAInputProcessor::Create();
 
 #if WITH_EDITOR
@@ -114,6 +129,22 @@ void FBlueprintAssistModule::ShutdownModule()
 
 	FBATabHandler::Get().Cleanup();
 
+	FBAWidgetQuery::Get().Cleanup();
+
+	FBAAssetIndex::Get().Cleanup();
+
+	FBAOpenWindowIndex::Get().Cleanup();
+
+	FBASymbolIndex::Get().Cleanup();
+
+	FBAVariableIndex::Get().Cleanup();
+
+	FBAGraphLint::Get().Cleanup();
+
+#if BA_UE_VERSION_OR_LATER(5, 1)
+	FBAActionMenuCache::Get().Cleanup();
+#endif
+
 	FBAInputProcessor::Get().Cleanup();
 
 	FBAToolbar::Get().Cleanup();
@@ -0,0 +1,96 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "BlueprintAssistNodeLookupCache.h"
+
+#include "BlueprintAssistStats.h"
+#include "EdGraph/EdGraph.h"
+
+void FBANodeLookupCache::Init(UEdGraph* InGraph)
+{
+	Reset();
+	Graph = InGraph;
+}
+
+void FBANodeLookupCache::Reset()
+{
+	Graph.Reset();
+	NodesByGuid.Empty();
+	CachedNumNodes = INDEX_NONE;
+	bDirty = true;
+}
+
+UEdGraphNode* FBANodeLookupCache::FindNode(const FGuid& NodeGuid)
+{
+	UEdGraph* GraphPtr = Graph.Get();
+	if (!GraphPtr)
+	{
+		return nullptr;
+	}
+
+	if (bDirty || CachedNumNodes != GraphPtr->Nodes.Num())
+	{
+		Rebuild();
+	}
+
+	if (const TWeakObjectPtr<UEdGraphNode>* FoundNode = NodesByGuid.Find(NodeGuid))
+	{
+		UEdGraphNode* Node = FoundNode->Get();
+		if (Node && Node->NodeGuid == NodeGuid && Node->GetGraph() == GraphPtr)
+		{
+			return Node;
+		}
+	}
+
+	// the node guid may have changed without a graph changed event (e.g. pasted nodes), fall back to a full search
+	for (UEdGraphNode* Node : GraphPtr->Nodes)
+	{
+		if (Node && Node->NodeGuid == NodeGuid)
+		{
+			bDirty = true;
+			return Node;
+		}
+	}
+
+	return nullptr;
+}
+
+UEdGraphPin* FBANodeLookupCache::FindPin(const FGuid& NodeGuid, const FGuid& PinId)
+{
+	if (UEdGraphNode* Node = FindNode(NodeGuid))
+	{
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (Pin->PinId == PinId)
+			{
+				return Pin;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+void FBANodeLookupCache::Rebuild()
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FBANodeLookupCache::Rebuild"), STAT_NodeLookupCache_Rebuild, STATGROUP_BA_EdGraphFormatter);
+
+	NodesByGuid.Reset();
+	bDirty = false;
+
+	UEdGraph* GraphPtr = Graph.Get();
+	CachedNumNodes = GraphPtr ? GraphPtr->Nodes.Num() : INDEX_NONE;
+	if (!GraphPtr)
+	{
+		return;
+	}
+
+	NodesByGuid.Reserve(GraphPtr->Nodes.Num());
+	for (UEdGraphNode* Node : GraphPtr->Nodes)
+	{
+		// keep the first node to match the old linear search when there are duplicate guids
+		if (Node && !NodesByGuid.Contains(Node->NodeGuid))
+		{
+			NodesByGuid.Add(Node->NodeGuid, Node);
+		}
+	}
+}
@@ -2,67 +2,72 @@
 
 #include "BlueprintAssistNodeSizeChangeData.h"
 
+#include "BlueprintAssistGlobals.h"
+#include "BlueprintAssistSettings.h"
 #include "BlueprintAssistUtils.h"
 #include "EdGraphSchema_K2.h"
 #include "K2Node_CreateDelegate.h"
+#include "Hash/CityHash.h"
 #include "UObject/TextProperty.h"
 
-void FBAPinChangeData::UpdatePin(UEdGraphPin* Pin)
+namespace BANodeSizeChangeDataHash
 {
-	bPinHidden = Pin->bHidden;
-	bPinLinked = FBAUtils::IsPinLinked(Pin);
-	PinValue = Pin->DefaultValue;
-	PinTextValue = Pin->DefaultTextValue;
-	PinLabel = GetPinLabel(Pin);
-	PinObject = GetPinDefaultObjectName(Pin);
-}
-
-bool FBAPinChangeData::HasPinChanged(UEdGraphPin* Pin)
-{
-	if (bPinHidden != Pin->bHidden)
+	FORCEINLINE uint64 HashString(const FString& Str, uint64 Seed)
 	{
-		return true;
-	}
-	
-	if (bPinLinked != FBAUtils::IsPinLinked(Pin))
-	{
-		// these pins do not change size
-		if (Pin->PinType.PinSubCategory != UEdGraphSchema_K2::PC_Exec)
-		{
-			return true;
-		}
+		return CityHash64WithSeed(reinterpret_cast<const char*>(*Str), Str.Len() * sizeof(TCHAR), Seed);
 	}
 
-	if (PinValue != Pin->DefaultValue)
+	FORCEINLINE uint64 HashText(const FText& Text, uint64 Seed)
 	{
-		return true;
+		return HashString(Text.ToString(), Seed);
 	}
 
-	if (!PinTextValue.EqualTo(Pin->DefaultTextValue, ETextComparisonLevel::Default))
+	template<typename T>
+	FORCEINLINE uint64 HashValue(const T& Value, uint64 Seed)
 	{
-		return true;
+		return CityHash64WithSeed(reinterpret_cast<const char*>(&Value), sizeof(T), Seed);
 	}
+}
 
-	if (!PinLabel.EqualTo(GetPinLabel(Pin), ETextComparisonLevel::Default))
-	{
-		return true;
-	}
+uint64 FBAPinChangeData::HashPin(UEdGraphPin* Pin, uint64 Seed)
+{
+	return HashPinValues(Pin, BANodeSizeChangeDataHash::HashValue(Pin->PinId, Seed));
+}
 
-	const FString PinDefaultObjectName = GetPinDefaultObjectName(Pin);
-	if (PinObject != PinDefaultObjectName)
-	{
-		return true;
-	}
+uint64 FBAPinChangeData::HashPinValues(UEdGraphPin* Pin, uint64 Seed)
+{
+	using namespace BANodeSizeChangeDataHash;
+
+	// linking these pins does not change size
+	const bool bPinLinked = FBAUtils::IsPinLinked(Pin) && Pin->PinType.PinSubCategory != UEdGraphSchema_K2::PC_Exec;
+	const uint8 Flags = (Pin->bHidden ? 1 : 0) | (bPinLinked ? 2 : 0);
+
+	uint64 Hash = HashValue(Flags, Seed);
+	Hash = HashString(Pin->DefaultValue, Hash);
+	Hash = HashText(Pin->DefaultTextValue, Hash);
+	Hash = HashText(GetPinLabel(Pin), Hash);
+	Hash = HashString(GetPinDefaultObjectName(Pin), Hash);
+	return Hash;
+}
 
-	return false;
+FString FBAPinChangeData::DescribePin(UEdGraphPin* Pin)
+{
+	return FString::Printf(
+		TEXT("Hidden:%d Linked:%d Value:'%s' TextValue:'%s' Label:'%s' Object:'%s'"),
+		Pin->bHidden ? 1 : 0,
+		FBAUtils::IsPinLinked(Pin) && Pin->PinType.PinSubCategory != UEdGraphSchema_K2::PC_Exec ? 1 : 0,
+		*Pin->DefaultValue,
+		*Pin->DefaultTextValue.ToString(),
+		*GetPinLabel(Pin).ToString(),
+		*GetPinDefaultObjectName(Pin));
 }
 
-FString FBAPinChangeData::GetPinDefaultObjectName(UEdGraphPin* Pin) const
+FString FBAPinChangeData::GetPinDefaultObjectName(UEdGraphPin* Pin)
 {
 	return Pin->DefaultObject ? Pin->DefaultObject->GetName() : FString();
 }
 
-FText FBAPinChangeData::GetPinLabel(UEdGraphPin* Pin) const
+FText FBAPinChangeData::GetPinLabel(UEdGraphPin* Pin)
 {
 	if (Pin)
 	{
@@ -82,99 +87,154 @@ FBANodeSizeChangeData::FBANodeSizeChangeData(UEdGraphNode* Node)
 
 void FBANodeSizeChangeData::UpdateNode(UEdGraphNode* Node)
 {
-	PinChangeData.Reset();
-	for (UEdGraphPin* Pin : Node->GetAllPins())
+	PinsHash = HashPins(Node);
+	NodeHash = HashNode(Node);
+
+	if (IsVerbose())
 	{
-		PinChangeData.FindOrAdd(Pin->PinId).UpdatePin(Pin);
-	}
+		if (!DebugData.IsValid())
+		{
+			DebugData = MakeShared<FBANodeSizeChangeDebugData>();
+		}
 
-	AdvancedPinDisplay = Node->AdvancedPinDisplay == ENodeAdvancedPins::Shown;
-	NodeTitle = FBAUtils::GetNodeTitle(Node).ToString();
-	bCommentBubblePinned = Node->bCommentBubblePinned;
-	bCommentBubbleVisible = Node->bCommentBubbleVisible;
-	CommentBubbleValue = Node->NodeComment;
-	NodeEnabledState = Node->GetDesiredEnabledState();
+		DebugData->PinDescriptions.Reset();
+		for (UEdGraphPin* Pin : Node->GetAllPins())
+		{
+			DebugData->PinDescriptions.Add(Pin->PinId, FBAPinChangeData::DescribePin(Pin));
+		}
 
-	if (UK2Node_CreateDelegate* Delegate = Cast<UK2Node_CreateDelegate>(Node))
+		DebugData->NodeDescription = DescribeNode(Node);
+	}
+	else
 	{
-		DelegateFunctionName = Delegate->GetFunctionName();
+		DebugData.Reset();
 	}
-
-	PropertyAccessTextPath = GetPropertyAccessTextPath(Node);
 }
 
 bool FBANodeSizeChangeData::HasNodeChanged(UEdGraphNode* Node)
 {
-	TArray<FGuid> PinGuids;
-    PinChangeData.GetKeys(PinGuids);
+	// node values are cheaper to check than the pins so test them first
+	const bool bChanged = NodeHash != HashNode(Node) || PinsHash != HashPins(Node);
 
-	for (UEdGraphPin* Pin : Node->GetAllPins())
+	if (bChanged && DebugData.IsValid())
 	{
-		if (FBAPinChangeData* FoundPinData = PinChangeData.Find(Pin->PinId))
-		{
-			if (FoundPinData->HasPinChanged(Pin))
-			{
-				return true;
-			}
+		LogChanges(Node);
+	}
 
-			PinGuids.Remove(Pin->PinId);
-		}
-		else // added a new pin
+	return bChanged;
+}
+
+SIZE_T FBANodeSizeChangeData::GetAllocatedSize() const
+{
+	SIZE_T Size = sizeof(FBANodeSizeChangeData);
+
+	if (DebugData.IsValid())
+	{
+		Size += sizeof(FBANodeSizeChangeDebugData);
+		Size += DebugData->PinDescriptions.GetAllocatedSize();
+		Size += DebugData->NodeDescription.GetAllocatedSize();
+		for (const auto& Elem : DebugData->PinDescriptions)
 		{
-			return true;
+			Size += Elem.Value.GetAllocatedSize();
 		}
 	}
 
-	// If there are remaining pins, then they must have been removed
-	if (PinGuids.Num())
-	{
-		return true;
-	}
+	return Size;
+}
 
-	if (AdvancedPinDisplay != (Node->AdvancedPinDisplay == ENodeAdvancedPins::Shown))
+uint64 FBANodeSizeChangeData::HashPins(UEdGraphNode* Node)
+{
+	// each pin hash is seeded by the previous pin, so adding, removing or changing any pin changes the final hash
+	uint64 Hash = 0;
+	for (UEdGraphPin* Pin : Node->GetAllPins())
 	{
-		return true;
+		Hash = FBAPinChangeData::HashPin(Pin, Hash);
 	}
 
-	if (NodeTitle != FBAUtils::GetNodeTitle(Node).ToString())
-	{
-		return true;
-	}
+	return Hash;
+}
 
-	if (bCommentBubblePinned != Node->bCommentBubblePinned)
-	{
-		return true;
-	}
+uint64 FBANodeSizeChangeData::HashNode(UEdGraphNode* Node)
+{
+	using namespace BANodeSizeChangeDataHash;
 
-	if (bCommentBubbleVisible != Node->bCommentBubbleVisible)
-	{
-		return true;
-	}
+	const uint8 Flags =
+		(Node->AdvancedPinDisplay == ENodeAdvancedPins::Shown ? 1 : 0) |
+		(Node->bCommentBubblePinned ? 2 : 0) |
+		(Node->bCommentBubbleVisible ? 4 : 0);
 
-	if (CommentBubbleValue != Node->NodeComment)
+	uint64 Hash = HashValue(Flags, 0);
+	Hash = HashValue(Node->GetDesiredEnabledState(), Hash);
+	Hash = HashText(FBAUtils::GetNodeTitle(Node), Hash);
+	Hash = HashString(Node->NodeComment, Hash);
+
+	if (UK2Node_CreateDelegate* Delegate = Cast<UK2Node_CreateDelegate>(Node))
 	{
-		return true;
+		Hash = HashString(Delegate->GetFunctionName().ToString(), Hash);
 	}
 
-	if (NodeEnabledState != Node->GetDesiredEnabledState())
+	Hash = HashString(GetPropertyAccessTextPath(Node), Hash);
+	return Hash;
+}
+
+FString FBANodeSizeChangeData::DescribeNode(UEdGraphNode* Node)
+{
+	const UK2Node_CreateDelegate* Delegate = Cast<UK2Node_CreateDelegate>(Node);
+
+	return FString::Printf(
+		TEXT("AdvancedPinDisplay:%d CommentPinned:%d CommentVisible:%d EnabledState:%d Title:'%s' Comment:'%s' Delegate:'%s' PropertyAccess:'%s'"),
+		Node->AdvancedPinDisplay == ENodeAdvancedPins::Shown ? 1 : 0,
+		Node->bCommentBubblePinned ? 1 : 0,
+		Node->bCommentBubbleVisible ? 1 : 0,
+		static_cast<int32>(Node->GetDesiredEnabledState()),
+		*FBAUtils::GetNodeTitle(Node).ToString(),
+		*Node->NodeComment,
+		Delegate ? *Delegate->GetFunctionName().ToString() : TEXT(""),
+		*GetPropertyAccessTextPath(Node));
+}
+
+FGuid FBANodeSizeChangeData::GetNodeShape(UEdGraphNode* Node)
+{
+	using namespace BANodeSizeChangeDataHash;
+
+	if (!Node || Node->bCanResizeNode || FBAUtils::IsCommentNode(Node))
 	{
-		return true;
+		return FGuid();
 	}
 
+	// the comment bubble is cached separately from the node size, so it is not part of the shape
+	const uint8 Flags =
+		(Node->AdvancedPinDisplay == ENodeAdvancedPins::Shown ? 1 : 0) |
+		(Node->bHasCompilerMessage ? 2 : 0);
+
+	uint64 Hash = HashString(Node->GetClass()->GetPathName(), 0);
+	Hash = HashValue(Flags, Hash);
+	Hash = HashValue(Node->ErrorType, Hash);
+	Hash = HashValue(Node->GetDesiredEnabledState(), Hash);
+	Hash = HashText(FBAUtils::GetNodeTitle(Node), Hash);
+
 	if (UK2Node_CreateDelegate* Delegate = Cast<UK2Node_CreateDelegate>(Node))
 	{
-		if (DelegateFunctionName != Delegate->GetFunctionName())
-		{
-			return true;
-		}
+		Hash = HashString(Delegate->GetFunctionName().ToString(), Hash);
 	}
 
-	if (PropertyAccessTextPath != GetPropertyAccessTextPath(Node))
+	Hash = HashString(GetPropertyAccessTextPath(Node), Hash);
+
+	for (UEdGraphPin* Pin : Node->Pins)
 	{
-		return true;
+		const uint8 PinTypeFlags = (Pin->PinType.bIsReference ? 1 : 0) | (Pin->PinType.bIsConst ? 2 : 0);
+
+		Hash = HashString(Pin->PinName.ToString(), Hash);
+		Hash = HashValue(Pin->Direction, Hash);
+		Hash = HashString(Pin->PinType.PinCategory.ToString(), Hash);
+		Hash = HashString(Pin->PinType.PinSubCategory.ToString(), Hash);
+		Hash = HashString(GetPathNameSafe(Pin->PinType.PinSubCategoryObject.Get()), Hash);
+		Hash = HashValue(Pin->PinType.ContainerType, Hash);
+		Hash = HashValue(PinTypeFlags, Hash);
+		Hash = FBAPinChangeData::HashPinValues(Pin, Hash);
 	}
 
-	return false;
+	return FGuid(static_cast<uint32>(Hash >> 32), static_cast<uint32>(Hash), Node->Pins.Num(), 1);
 }
 
 FString FBANodeSizeChangeData::GetPropertyAccessTextPath(UEdGraphNode* Node)
@@ -190,3 +250,74 @@ FString FBANodeSizeChangeData::GetPropertyAccessTextPath(UEdGraphNode* Node)
 
 	return FString();
 }
+
+SIZE_T FBANodeSizeChangeData::EstimateUncompactedSize(UEdGraphNode* Node)
+{
+	// old layout: TMap<FGuid, FBAPinChangeData> + 2 bools + 2 strings + bool + enum + FName + string
+	constexpr SIZE_T NodeFieldsSize = sizeof(TMap<FGuid, int32>) + sizeof(bool) * 3 + sizeof(FString) * 3 + sizeof(ENodeEnabledState) + sizeof(FName);
+
+	// old pin layout: 2 bools + FString + 2 FText + FString, stored in a set element with its key, hash and hash index
+	constexpr SIZE_T PinFieldsSize = sizeof(FGuid) + sizeof(bool) * 2 + sizeof(FString) * 2 + sizeof(FText) * 2 + sizeof(int32) * 2;
+
+	SIZE_T Size = NodeFieldsSize;
+	Size += FBAUtils::GetNodeTitle(Node).ToString().GetAllocatedSize();
+	Size += Node->NodeComment.GetAllocatedSize();
+	Size += GetPropertyAccessTextPath(Node).GetAllocatedSize();
+
+	// FText shares its string data, count the display string as if we owned it
+	for (UEdGraphPin* Pin : Node->GetAllPins())
+	{
+		Size += PinFieldsSize;
+		Size += Pin->DefaultValue.GetAllocatedSize();
+		Size += Pin->DefaultTextValue.ToString().GetAllocatedSize();
+		Size += FBAPinChangeData::GetPinLabel(Pin).ToString().GetAllocatedSize();
+		Size += FBAPinChangeData::GetPinDefaultObjectName(Pin).GetAllocatedSize();
+	}
+
+	return Size;
+}
+
+bool FBANodeSizeChangeData::IsVerbose()
+{
+	return UBASettings::HasDebugSetting("NodeSizeChangeData");
+}
+
+void FBANodeSizeChangeData::LogChanges(UEdGraphNode* Node) const
+{
+	UE_LOG(LogBlueprintAssist, Log, TEXT("NodeSizeChangeData: %s changed"), *FBAUtils::GetNodeName(Node));
+
+	const FString NewNodeDescription = DescribeNode(Node);
+	if (NewNodeDescription != DebugData->NodeDescription)
+	{
+		UE_LOG(LogBlueprintAssist, Log, TEXT("\tNode: %s -> %s"), *DebugData->NodeDescription, *NewNodeDescription);
+	}
+
+	TSet<FGuid> RemainingPins;
+	for (const auto& Elem : DebugData->PinDescriptions)
+	{
+		RemainingPins.Add(Elem.Key);
+	}
+
+	for (UEdGraphPin* Pin : Node->GetAllPins())
+	{
+		const FString NewPinDescription = FBAPinChangeData::DescribePin(Pin);
+		if (const FString* OldPinDescription = DebugData->PinDescriptions.Find(Pin->PinId))
+		{
+			if (*OldPinDescription != NewPinDescription)
+			{
+				UE_LOG(LogBlueprintAssist, Log, TEXT("\tPin %s: %s -> %s"), *FBAUtils::GetPinName(Pin), **OldPinDescription, *NewPinDescription);
+			}
+
+			RemainingPins.Remove(Pin->PinId);
+		}
+		else
+		{
+			UE_LOG(LogBlueprintAssist, Log, TEXT("\tPin added %s: %s"), *FBAUtils::GetPinName(Pin), *NewPinDescription);
+		}
+	}
+
+	for (const FGuid& RemovedPin : RemainingPins)
+	{
+		UE_LOG(LogBlueprintAssist, Log, TEXT("\tPin removed %s"), *RemovedPin.ToString());
+	}
+}
@@ -3,19 +3,17 @@
 #include "BlueprintAssistObjects/BABlueprintHandlerObject.h"
 
 #include "BlueprintAssistGlobals.h"
+#include "BlueprintAssistGraphLint.h"
 #include "BlueprintAssistSettings.h"
 #include "BlueprintAssistUtils.h"
 #include "Editor.h"
 #include "Engine/Blueprint.h"
 #include "K2Node_CustomEvent.h"
 #include "K2Node_FunctionEntry.h"
-#include "K2Node_Knot.h"
 #include "K2Node_Tunnel.h"
 #include "ScopedTransaction.h"
 #include "SGraphActionMenu.h"
 #include "Kismet2/BlueprintEditorUtils.h"
-#include "Kismet2/KismetEditorUtilities.h"
-#include "Logging/MessageLog.h"
 
 #if BA_UE_VERSION_OR_LATER(5, 0)
 	#define BA_GET_ON_OBJECTS_REPLACED FCoreUObjectDelegates::OnObjectsReplaced
@@ -511,78 +509,25 @@ void UBABlueprintHandlerObject::OnBlueprintCompiled(UBlueprint* Blueprint)
 	TArray<UEdGraph*> Graphs;
 	Blueprint->GetAllGraphs(Graphs);
 
-	for (UEdGraph* Graph : Graphs)
-	{
-		DetectGraphIssues(Graph);
-	}
-}
+	TArray<FBAGraphLintResult> Results;
+	FBAGraphLint::Get().LintGraphs(Graphs, Results);
 
-void UBABlueprintHandlerObject::DetectGraphIssues(UEdGraph* Graph)
-{
-	if (!IsValid(Graph))
+	// warnings of graphs which have not changed since they were last linted were already reported, errors are reported on every compile
+	TArray<FBAGraphIssue> Issues;
+	for (const FBAGraphLintResult& Result : Results)
 	{
-		return;
-	}
-
-	struct FLocal
-	{
-		static void FocusNode(TWeakObjectPtr<UK2Node_Knot> Node)
+		if (!Result.bCached)
 		{
-			if (Node.IsValid())
-			{
-				FKismetEditorUtilities::BringKismetToFocusAttentionOnObject(Node.Get(), false);
-			}
+			Issues.Append(Result.Issues);
 		}
-	};
-
-	FMessageLog BlueprintAssistLog("BlueprintAssist");
-
-	for (UEdGraphNode* Node : Graph->Nodes)
-	{
-		// Detect bad knot nodes
-		if (UK2Node_Knot* KnotNode = Cast<UK2Node_Knot>(Node))
+		else
 		{
-			// Detect empty knot nodes to be deleted
-			if (FBAUtils::GetLinkedPins(KnotNode).Num() == 0)
-			{
-				TSharedRef<FTokenizedMessage> Message = FTokenizedMessage::Create(EMessageSeverity::Info);
-				const FText MessageText = FText::FromString(FString::Printf(TEXT("Unlinked reroute node %s"), *KnotNode->NodeGuid.ToString()));
-				Message->AddToken(FTextToken::Create(MessageText));
-				Message->AddToken(FActionToken::Create(
-					FText::FromString("GoTo"),
-					FText::FromString("Go to node"),
-					FOnActionTokenExecuted::CreateStatic(&FLocal::FocusNode, TWeakObjectPtr<UK2Node_Knot>(KnotNode))));
-
-				BlueprintAssistLog.AddMessage(Message);
-			}
-			else
+			Issues.Append(Result.Issues.FilterByPredicate([](const FBAGraphIssue& Issue)
 			{
-				bool bOpenMessageLog = false;
-
-				// Detect badly linked exec knot nodes
-				for (UEdGraphPin* Pin : FBAUtils::GetLinkedPins(KnotNode, EGPD_Output).FilterByPredicate(FBAUtils::IsExecPin))
-				{
-					if (Pin->LinkedTo.Num() > 1)
-					{
-						TSharedRef<FTokenizedMessage> Message = FTokenizedMessage::Create(EMessageSeverity::Error);
-						const FText MessageText = FText::FromString(FString::Printf(TEXT("Badly linked reroute node (manually delete and remake this node) %s"), *KnotNode->NodeGuid.ToString()));
-						Message->AddToken(FTextToken::Create(MessageText));
-						Message->AddToken(FActionToken::Create(
-							FText::FromString("GoTo"),
-							FText::FromString("Go to node"),
-							FOnActionTokenExecuted::CreateStatic(&FLocal::FocusNode, TWeakObjectPtr<UK2Node_Knot>(KnotNode))));
-
-						BlueprintAssistLog.AddMessage(Message);
-
-						bOpenMessageLog = true;
-					}
-				}
-
-				if (bOpenMessageLog)
-				{
-					BlueprintAssistLog.Open();
-				}
-			}
+				return Issue.Severity == EMessageSeverity::Error;
+			}));
 		}
 	}
+
+	FBAGraphLint::ReportIssues(Issues);
 }
@@ -0,0 +1,197 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "BlueprintAssistOpenWindowIndex.h"
+
+#include "BlueprintAssistGlobals.h"
+#include "EditorUtilityWidgetBlueprint.h"
+#include "ISettingsContainer.h"
+#include "ISettingsModule.h"
+#include "LevelEditor.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "BlueprintAssistWidgets/OpenWindowMenu.h"
+#include "Misc/LazySingleton.h"
+#include "Stats/StatsMisc.h"
+
+namespace BAOpenWindowIndexConstants
+{
+	/* Ticks to wait after a change before rebuilding, modules and settings tend to be registered in bursts */
+	constexpr int32 RebuildDelayTicks = 30;
+
+	/* Modules are loaded throughout editor startup and when opening asset editors, wait longer so they coalesce into one rebuild */
+	constexpr int32 ModuleRebuildDelayTicks = 300;
+}
+
+FBAOpenWindowIndex& FBAOpenWindowIndex::Get()
+{
+	return TLazySingleton<FBAOpenWindowIndex>::Get();
+}
+
+void FBAOpenWindowIndex::TearDown()
+{
+	TLazySingleton<FBAOpenWindowIndex>::TearDown();
+}
+
+void FBAOpenWindowIndex::Init()
+{
+	DelayedRebuild.SetOnDelayEnded(FBAOnDelayEnded::CreateRaw(this, &FBAOpenWindowIndex::OnDelayedRebuild));
+
+	FModuleManager::Get().OnModulesChanged().AddRaw(this, &FBAOpenWindowIndex::OnModulesChanged);
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.OnAssetAdded().AddRaw(this, &FBAOpenWindowIndex::OnAssetAddedOrRemoved);
+	AssetRegistry.OnAssetRemoved().AddRaw(this, &FBAOpenWindowIndex::OnAssetAddedOrRemoved);
+
+	MarkDirty();
+}
+
+void FBAOpenWindowIndex::Cleanup()
+{
+	FModuleManager::Get().OnModulesChanged().RemoveAll(this);
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		AssetRegistryModule->Get().OnAssetAdded().RemoveAll(this);
+		AssetRegistryModule->Get().OnAssetRemoved().RemoveAll(this);
+	}
+
+	UnbindSettingsContainers();
+
+	DelayedRebuild.Cancel();
+	Items.Empty();
+	bDirty = true;
+}
+
+void FBAOpenWindowIndex::Tick()
+{
+	DelayedRebuild.Tick();
+}
+
+const FBAOpenWindowIndex::FItemArray& FBAOpenWindowIndex::GetItems()
+{
+	if (bDirty)
+	{
+		Rebuild();
+	}
+
+	return Items;
+}
+
+void FBAOpenWindowIndex::MarkDirty()
+{
+	ScheduleRebuild(BAOpenWindowIndexConstants::RebuildDelayTicks);
+}
+
+void FBAOpenWindowIndex::ScheduleRebuild(int32 DelayTicks)
+{
+	bDirty = true;
+	DelayedRebuild.StartDelay(DelayTicks);
+}
+
+void FBAOpenWindowIndex::OnDelayedRebuild()
+{
+	// the level editor tabs need the level editor tab manager, wait for it instead of building an incomplete index
+	FLevelEditorModule* LevelEditorModule = FModuleManager::GetModulePtr<FLevelEditorModule>("LevelEditor");
+	if (!LevelEditorModule || !LevelEditorModule->GetLevelEditorTabManager().IsValid())
+	{
+		DelayedRebuild.StartDelay(BAOpenWindowIndexConstants::RebuildDelayTicks);
+		return;
+	}
+
+	Rebuild();
+}
+
+void FBAOpenWindowIndex::Rebuild()
+{
+	DelayedRebuild.Cancel();
+
+	TGuardValue<bool> RebuildingGuard(bRebuilding, true);
+
+	double ThisTime = 0;
+	{
+		SCOPE_SECONDS_COUNTER(ThisTime);
+
+		Items.Reset();
+		SOpenWindowMenu::AddOpenTabItems(Items);
+		SOpenWindowMenu::AddOpenSettingsItems(Items);
+		SOpenWindowMenu::AddEditorUtilityWidgets(Items);
+
+		BindSettingsContainers();
+		bDirty = false;
+	}
+
+	UE_LOG(LogBlueprintAssist, Verbose, TEXT("Built open window index with %d items, took %.2f"), Items.Num(), ThisTime);
+}
+
+void FBAOpenWindowIndex::BindSettingsContainers()
+{
+	UnbindSettingsContainers();
+
+	ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings");
+	if (!SettingsModule)
+	{
+		return;
+	}
+
+	TArray<FName> ContainerNames;
+	SettingsModule->GetContainerNames(ContainerNames);
+	for (const FName& ContainerName : ContainerNames)
+	{
+		if (TSharedPtr<ISettingsContainer> Container = SettingsModule->GetContainer(ContainerName))
+		{
+			// sections are added to a category by registering them, which broadcasts the category as modified
+			Container->OnCategoryModified().AddRaw(this, &FBAOpenWindowIndex::OnSettingsCategoryModified);
+			Container->OnSectionRemoved().AddRaw(this, &FBAOpenWindowIndex::OnSettingsSectionRemoved);
+			BoundSettingsContainers.Add(Container);
+		}
+	}
+}
+
+void FBAOpenWindowIndex::UnbindSettingsContainers()
+{
+	for (const TWeakPtr<ISettingsContainer>& WeakContainer : BoundSettingsContainers)
+	{
+		if (TSharedPtr<ISettingsContainer> Container = WeakContainer.Pin())
+		{
+			Container->OnCategoryModified().RemoveAll(this);
+			Container->OnSectionRemoved().RemoveAll(this);
+		}
+	}
+
+	BoundSettingsContainers.Empty();
+}
+
+void FBAOpenWindowIndex::OnModulesChanged(FName ModuleName, EModuleChangeReason Reason)
+{
+	if (!bRebuilding)
+	{
+		ScheduleRebuild(BAOpenWindowIndexConstants::ModuleRebuildDelayTicks);
+	}
+}
+
+void FBAOpenWindowIndex::OnSettingsCategoryModified(const FName& CategoryName)
+{
+	MarkDirty();
+}
+
+void FBAOpenWindowIndex::OnSettingsSectionRemoved(const TSharedRef<ISettingsSection>& Section)
+{
+	MarkDirty();
+}
+
+void FBAOpenWindowIndex::OnAssetAddedOrRemoved(const FAssetData& AssetData)
+{
+	if (IsEditorUtilityWidgetAsset(AssetData))
+	{
+		MarkDirty();
+	}
+}
+
+bool FBAOpenWindowIndex::IsEditorUtilityWidgetAsset(const FAssetData& AssetData)
+{
+#if BA_UE_VERSION_OR_LATER(5, 1)
+	return AssetData.AssetClassPath == UEditorUtilityWidgetBlueprint::StaticClass()->GetClassPathName();
+#else
+	return AssetData.AssetClass == UEditorUtilityWidgetBlueprint::StaticClass()->GetFName();
+#endif
+}
@@ -14,8 +14,18 @@ UBASettings_Advanced::UBASettings_Advanced(const FObjectInitializer& ObjectIniti
 	//~~~ Cache
 	bStoreCacheDataInPackageMetaData = false;
 	bPrettyPrintCacheJSON = false;
+	bShareNodeSizesBetweenIdenticalNodes = true;
 
 	//~~~ Misc
 	bUseCustomBlueprintActionMenu = false;
 	bForceRefreshGraphAfterFormatting = false;
+
+	//~~~ Performance
+	DeferredWorkFrameBudget = 5.0f;
+	BackgroundGraphHandlerMemoryBudget = 16 * 1024;
+	TabFocusFallbackPollInterval = 0.5f;
+
+	//~~~ Graph Lint
+	DisabledLintRules = { "NodesOutsideComments" };
+	LintLongLinkSpan = 4000.0f;
 }
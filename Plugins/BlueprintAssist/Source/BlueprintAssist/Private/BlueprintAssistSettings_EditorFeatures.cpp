@@ -23,6 +23,11 @@ UBASettings_EditorFeatures::UBASettings_EditorFeatures(const FObjectInitializer&
 	bDrawNodeGroupFill = false;
 	NodeGroupFillColor = FLinearColor(0.5f, 0.5f, 0, 0.15f);
 
+	//~~~ LevelOfDetail
+	bEnableLevelOfDetail = false;
+	LevelOfDetailZoomThreshold = 0.25f;
+	LevelOfDetailNodeOpacity = 0.8f;
+
 	//~~~ Mouse Features
 	GroupMovementChords.Add(FInputChord(EKeys::SpaceBar));
 
@@ -0,0 +1,356 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "BlueprintAssistSymbolIndex.h"
+
+#include "BlueprintAssistCache.h"
+#include "BlueprintAssistUtils.h"
+#include "K2Node_Event.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "BlueprintAssistWidgets/GoToSymbolMenu.h"
+#include "JsonObjectConverter.h"
+#include "EdGraph/EdGraph.h"
+#include "Engine/Blueprint.h"
+#include "Engine/LevelScriptBlueprint.h"
+#include "Misc/LazySingleton.h"
+#include "Misc/PackageName.h"
+#include "Stats/StatsMisc.h"
+#include "UObject/UObjectIterator.h"
+
+#if BA_UE_VERSION_OR_LATER(5, 4)
+#include "UObject/AssetRegistryTagsContext.h"
+#endif
+
+static FName NAME_BA_SYMBOLS = FName("BASymbols");
+
+FBASymbolIndex& FBASymbolIndex::Get()
+{
+	return TLazySingleton<FBASymbolIndex>::Get();
+}
+
+void FBASymbolIndex::TearDown()
+{
+	TLazySingleton<FBASymbolIndex>::TearDown();
+}
+
+void FBASymbolIndex::Init()
+{
+#if BA_UE_VERSION_OR_LATER(5, 0)
+	FCoreUObjectDelegates::OnObjectPreSave.AddRaw(this, &FBASymbolIndex::OnObjectPreSave);
+#else
+	FCoreUObjectDelegates::OnObjectSaved.AddRaw(this, &FBASymbolIndex::OnObjectSaved);
+#endif
+
+#if BA_UE_VERSION_OR_LATER(5, 4)
+	UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.AddRaw(this, &FBASymbolIndex::OnGetExtraObjectTags);
+#else
+	UObject::FAssetRegistryTag::OnGetExtraObjectTags.AddRaw(this, &FBASymbolIndex::OnGetExtraObjectTags);
+#endif
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.OnAssetRemoved().AddRaw(this, &FBASymbolIndex::OnAssetRemoved);
+	AssetRegistry.OnAssetRenamed().AddRaw(this, &FBASymbolIndex::OnAssetRenamed);
+}
+
+void FBASymbolIndex::Cleanup()
+{
+#if BA_UE_VERSION_OR_LATER(5, 0)
+	FCoreUObjectDelegates::OnObjectPreSave.RemoveAll(this);
+#else
+	FCoreUObjectDelegates::OnObjectSaved.RemoveAll(this);
+#endif
+
+#if BA_UE_VERSION_OR_LATER(5, 4)
+	UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.RemoveAll(this);
+#else
+	UObject::FAssetRegistryTag::OnGetExtraObjectTags.RemoveAll(this);
+#endif
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		AssetRegistryModule->Get().OnAssetRemoved().RemoveAll(this);
+		AssetRegistryModule->Get().OnAssetRenamed().RemoveAll(this);
+	}
+
+	ItemsByPackage.Empty();
+	bItemsBuilt = false;
+	bBuiltAfterCacheLoaded = false;
+}
+
+void FBASymbolIndex::GetItems(FName ExcludedPackageName, FItemArray& OutItems)
+{
+	// the cache is loaded once the asset registry has finished loading, rebuild to pick up the cached symbols
+	if (!bItemsBuilt || (!bBuiltAfterCacheLoaded && FBACache::Get().HasLoaded()))
+	{
+		BuildItems();
+	}
+
+	for (const auto& Elem : ItemsByPackage)
+	{
+		if (Elem.Key != ExcludedPackageName)
+		{
+			OutItems.Append(Elem.Value);
+		}
+	}
+}
+
+void FBASymbolIndex::UpdateBlueprint(UBlueprint* Blueprint)
+{
+	if (!ShouldIndexBlueprint(Blueprint))
+	{
+		return;
+	}
+
+	const FName PackageName = Blueprint->GetOutermost()->GetFName();
+
+	FBABlueprintSymbolData& SymbolData = FBACache::Get().GetCacheData().BlueprintSymbols.FindOrAdd(PackageName);
+	SymbolData.ObjectPath = Blueprint->GetPathName();
+	SymbolData.Symbols.Reset();
+	GatherSymbols(Blueprint, SymbolData.Symbols);
+
+	if (bItemsBuilt)
+	{
+		BuildPackageItems(PackageName);
+	}
+}
+
+void FBASymbolIndex::RemovePackage(FName PackageName)
+{
+	FBACache::Get().GetCacheData().BlueprintSymbols.Remove(PackageName);
+	ItemsByPackage.Remove(PackageName);
+}
+
+void FBASymbolIndex::GatherSymbols(UBlueprint* Blueprint, TArray<FBASymbolData>& OutSymbols)
+{
+	TArray<UEdGraph*> BlueprintGraphs;
+	Blueprint->GetAllGraphs(BlueprintGraphs);
+
+	for (UEdGraph* Graph : BlueprintGraphs)
+	{
+		if (!Graph || Blueprint->DelegateSignatureGraphs.Contains(Graph))
+		{
+			continue;
+		}
+
+		const EGraphType GraphType = FBAUtils::GetGraphType(Graph);
+
+		if (GraphType == GT_Ubergraph)
+		{
+			for (UEdGraphNode* Node : Graph->Nodes)
+			{
+				if (Node && Node->GetClass()->ImplementsInterface(UK2Node_EventNodeInterface::StaticClass()))
+				{
+					FBASymbolData& Symbol = OutSymbols.AddDefaulted_GetRef();
+					Symbol.Name = FBAUtils::GetNodeName(Node);
+					Symbol.Type = EBASymbolType::Event;
+					Symbol.GraphName = Graph->GetFName();
+					Symbol.GraphType = GraphType;
+					Symbol.Guid = Node->NodeGuid;
+				}
+			}
+		}
+
+		FBASymbolData& Symbol = OutSymbols.AddDefaulted_GetRef();
+		Symbol.Name = FBAUtils::GetGraphName(Graph);
+		Symbol.Type = EBASymbolType::Graph;
+		Symbol.GraphName = Graph->GetFName();
+		Symbol.GraphType = GraphType;
+	}
+
+	for (const FBPVariableDescription& Variable : Blueprint->NewVariables)
+	{
+		FBASymbolData& Symbol = OutSymbols.AddDefaulted_GetRef();
+		Symbol.Name = Variable.VarName.ToString();
+		Symbol.Type = EBASymbolType::Variable;
+		Symbol.Guid = Variable.VarGuid;
+	}
+}
+
+void FBASymbolIndex::BuildItems()
+{
+	double ThisTime = 0;
+	{
+		SCOPE_SECONDS_COUNTER(ThisTime);
+
+		// blueprints in memory are always up to date, gather them before reading the cached symbols
+		TSet<FName> GatheredPackages;
+		for (TObjectIterator<UBlueprint> It; It; ++It)
+		{
+			UBlueprint* Blueprint = *It;
+			if (ShouldIndexBlueprint(Blueprint))
+			{
+				const FName PackageName = Blueprint->GetOutermost()->GetFName();
+				GatheredPackages.Add(PackageName);
+
+				FBABlueprintSymbolData& SymbolData = FBACache::Get().GetCacheData().BlueprintSymbols.FindOrAdd(PackageName);
+				SymbolData.ObjectPath = Blueprint->GetPathName();
+				SymbolData.Symbols.Reset();
+				GatherSymbols(Blueprint, SymbolData.Symbols);
+			}
+		}
+
+		SeedFromAssetRegistry(GatheredPackages);
+
+		ItemsByPackage.Reset();
+		for (const auto& Elem : FBACache::Get().GetCacheData().BlueprintSymbols)
+		{
+			BuildPackageItems(Elem.Key);
+		}
+
+		bItemsBuilt = true;
+		bBuiltAfterCacheLoaded = FBACache::Get().HasLoaded();
+	}
+
+	UE_LOG(LogBlueprintAssist, Verbose, TEXT("Built symbol index for %d blueprints, took %.2f"), ItemsByPackage.Num(), ThisTime);
+}
+
+void FBASymbolIndex::BuildPackageItems(FName PackageName)
+{
+	const FBABlueprintSymbolData* SymbolData = FBACache::Get().GetCacheData().BlueprintSymbols.Find(PackageName);
+	if (!SymbolData)
+	{
+		ItemsByPackage.Remove(PackageName);
+		return;
+	}
+
+	const FSoftObjectPath BlueprintPath(SymbolData->ObjectPath);
+
+	FItemArray& Items = ItemsByPackage.FindOrAdd(PackageName);
+	Items.Reset(SymbolData->Symbols.Num());
+	for (const FBASymbolData& Symbol : SymbolData->Symbols)
+	{
+		Items.Add(MakeShared<FGoToSymbolStruct>(BlueprintPath, MakeShared<FBASymbolData>(Symbol)));
+	}
+}
+
+void FBASymbolIndex::SeedFromAssetRegistry(const TSet<FName>& GatheredPackages)
+{
+	FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry");
+	if (!AssetRegistryModule)
+	{
+		return;
+	}
+
+	FARFilter Filter;
+	Filter.TagsAndValues.Add(NAME_BA_SYMBOLS, TOptional<FString>());
+
+	TArray<FAssetData> Assets;
+	AssetRegistryModule->Get().GetAssets(Filter, Assets);
+
+	TMap<FName, FBABlueprintSymbolData>& BlueprintSymbols = FBACache::Get().GetCacheData().BlueprintSymbols;
+	for (const FAssetData& Asset : Assets)
+	{
+		if (GatheredPackages.Contains(Asset.PackageName))
+		{
+			continue;
+		}
+
+		// the tag was written when the package on disk was saved, so it is newer than the symbols in our cache
+		FString TagValue;
+		FBABlueprintSymbolData SymbolData;
+		if (Asset.GetTagValue(NAME_BA_SYMBOLS, TagValue) && FJsonObjectConverter::JsonObjectStringToUStruct(TagValue, &SymbolData, 0, 0))
+		{
+#if BA_UE_VERSION_OR_LATER(5, 1)
+			SymbolData.ObjectPath = Asset.GetObjectPathString();
+#else
+			SymbolData.ObjectPath = Asset.ObjectPath.ToString();
+#endif
+			BlueprintSymbols.Add(Asset.PackageName, MoveTemp(SymbolData));
+		}
+	}
+}
+
+bool FBASymbolIndex::GetSymbolsTagValue(const UObject* Object, FString& OutValue)
+{
+	const UBlueprint* Blueprint = Cast<UBlueprint>(Object);
+	if (!ShouldIndexBlueprint(Blueprint))
+	{
+		return false;
+	}
+
+	// tags are also gathered outside of saving, only write the symbols gathered by the last save (see OnObjectPreSave)
+	const FBABlueprintSymbolData* SymbolData = FBACache::Get().GetCacheData().BlueprintSymbols.Find(Blueprint->GetOutermost()->GetFName());
+	if (!SymbolData)
+	{
+		return false;
+	}
+
+	FBABlueprintSymbolData TagData;
+	TagData.Symbols = SymbolData->Symbols;
+	return FJsonObjectConverter::UStructToJsonObjectString(TagData, OutValue, 0, 0, 0, nullptr, false);
+}
+
+#if BA_UE_VERSION_OR_LATER(5, 4)
+void FBASymbolIndex::OnGetExtraObjectTags(FAssetRegistryTagsContext Context)
+{
+	FString TagValue;
+	if (GetSymbolsTagValue(Context.GetObject(), TagValue))
+	{
+		Context.AddTag(UObject::FAssetRegistryTag(NAME_BA_SYMBOLS, TagValue, UObject::FAssetRegistryTag::TT_Hidden));
+	}
+}
+#else
+void FBASymbolIndex::OnGetExtraObjectTags(const UObject* Object, TArray<UObject::FAssetRegistryTag>& OutTags)
+{
+	FString TagValue;
+	if (GetSymbolsTagValue(Object, TagValue))
+	{
+		OutTags.Add(UObject::FAssetRegistryTag(NAME_BA_SYMBOLS, TagValue, UObject::FAssetRegistryTag::TT_Hidden));
+	}
+}
+#endif
+
+bool FBASymbolIndex::ShouldIndexBlueprint(const UBlueprint* Blueprint)
+{
+	// level blueprints would load their level when jumping to them
+	return Blueprint
+		&& Blueprint->IsAsset()
+		&& !Blueprint->IsA<ULevelScriptBlueprint>()
+		&& !Blueprint->HasAnyFlags(RF_ClassDefaultObject | RF_Transient)
+		&& !Blueprint->GetOutermost()->HasAnyPackageFlags(PKG_CompiledIn);
+}
+
+#if BA_UE_VERSION_OR_LATER(5, 0)
+void FBASymbolIndex::OnObjectPreSave(UObject* Object, FObjectPreSaveContext Context)
+{
+	// the symbols of cooked blueprints don't change
+	if (Context.IsCooking())
+	{
+		return;
+	}
+
+	if (UBlueprint* Blueprint = Cast<UBlueprint>(Object))
+	{
+		UpdateBlueprint(Blueprint);
+	}
+}
+#else
+void FBASymbolIndex::OnObjectSaved(UObject* Object)
+{
+	if (GIsCookerLoadingPackage)
+	{
+		return;
+	}
+
+	if (UBlueprint* Blueprint = Cast<UBlueprint>(Object))
+	{
+		UpdateBlueprint(Blueprint);
+	}
+}
+#endif
+
+void FBASymbolIndex::OnAssetRemoved(const FAssetData& AssetData)
+{
+	RemovePackage(AssetData.PackageName);
+}
+
+void FBASymbolIndex::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	RemovePackage(FName(*FPackageName::ObjectPathToPackageName(OldObjectPath)));
+
+	// renamed assets are always loaded
+	if (UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.FastGetAsset(false)))
+	{
+		UpdateBlueprint(Blueprint);
+	}
+}
@@ -4,12 +4,16 @@
 
 #include "BlueprintAssistGlobals.h"
 #include "BlueprintAssistGraphHandler.h"
+#include "BlueprintAssistSettings_Advanced.h"
+#include "BlueprintAssistStats.h"
 #include "BlueprintAssistUtils.h"
 #include "Editor.h"
 #include "Framework/Application/SlateApplication.h"
 #include "Misc/LazySingleton.h"
 #include "Widgets/Docking/SDockTab.h"
 
+DECLARE_MEMORY_STAT(TEXT("Graph handler caches"), STAT_TabHandler_GraphHandlerCaches, STATGROUP_BA_EdGraphFormatter);
+
 FBATabHandler& FBATabHandler::Get()
 {
 	return TLazySingleton<FBATabHandler>::Get();
@@ -33,6 +37,10 @@ void FBATabHandler::Init()
 		// Add delegate for tab foregrounded
 		const auto& TabForegroundedDelegate = FOnActiveTabChanged::FDelegate::CreateRaw(this, &FBATabHandler::OnTabForegrounded);
 		OnTabForegroundedDelegateHandle = TabManager->OnTabForegrounded_Subscribe(TabForegroundedDelegate);
+
+		// window activation and graph changes inside a tab don't always fire the tab delegates, but they do move the keyboard focus
+		OnFocusChangingDelegateHandle = FSlateApplication::Get().OnFocusChanging().AddRaw(this, &FBATabHandler::OnFocusChanging);
+		OnApplicationActivationStateChangedDelegateHandle = FSlateApplication::Get().OnApplicationActivationStateChanged().AddRaw(this, &FBATabHandler::OnApplicationActivationStateChanged);
 	}
 	else
 	{
@@ -42,11 +50,25 @@ void FBATabHandler::Init()
 
 void FBATabHandler::Tick(const float DeltaTime)
 {
-	CheckActiveTabContentChanged();
+	// the tab delegates don't catch everything (e.g. the blueprint editor swapping graphs in a document tab), so still poll at a low frequency
+	TimeSinceFallbackPoll += DeltaTime;
+	if (TimeSinceFallbackPoll >= UBASettings_Advanced::Get().TabFocusFallbackPollInterval)
+	{
+		bFocusDirty = true;
+	}
 
-	RemoveInvalidTabs();
+	// the active handler is ticked below, so its tab and graph must always be valid
+	if (bFocusDirty || !IsActiveGraphHandlerValid())
+	{
+		bFocusDirty = false;
+		TimeSinceFallbackPoll = 0.f;
+
+		CheckActiveTabContentChanged();
 
-	CheckWindowFocusChanged();
+		RemoveInvalidTabs();
+
+		CheckWindowFocusChanged();
+	}
 
 	if (ActiveGraphHandler.IsValid())
 	{
@@ -78,6 +100,8 @@ void FBATabHandler::OnTabForegrounded(TSharedPtr<SDockTab> NewTab, TSharedPtr<SD
 	{
 		ProcessTabsTimerHandle = GEditor->GetTimerManager()->SetTimerForNextTick(FTimerDelegate::CreateRaw(this, &FBATabHandler::ProcessTabs));
 	}
+
+	bFocusDirty = true;
 }
 
 void FBATabHandler::OnActiveTabChanged(TSharedPtr<SDockTab> PreviousTab, TSharedPtr<SDockTab> NewTab)
@@ -96,6 +120,33 @@ void FBATabHandler::OnActiveTabChanged(TSharedPtr<SDockTab> PreviousTab, TShared
 	{
 		ProcessTabsTimerHandle = GEditor->GetTimerManager()->SetTimerForNextTick(FTimerDelegate::CreateRaw(this, &FBATabHandler::ProcessTabs));
 	}
+
+	bFocusDirty = true;
+}
+
+void FBATabHandler::OnFocusChanging(
+	const FFocusEvent& FocusEvent,
+	const FWeakWidgetPath& OldFocusedWidgetPath,
+	const TSharedPtr<SWidget>& OldFocusedWidget,
+	const FWidgetPath& NewFocusedWidgetPath,
+	const TSharedPtr<SWidget>& NewFocusedWidget)
+{
+	bFocusDirty = true;
+}
+
+void FBATabHandler::OnApplicationActivationStateChanged(bool bIsActive)
+{
+	bFocusDirty = true;
+}
+
+bool FBATabHandler::IsActiveGraphHandlerValid() const
+{
+	if (TSharedPtr<FBAGraphHandler> GraphHandler = ActiveGraphHandler.Pin())
+	{
+		return GraphHandler->GetTab().IsValid() && FBAUtils::IsValidGraph(GraphHandler->GetFocusedEdGraph());
+	}
+
+	return true;
 }
 
 void FBATabHandler::CheckActiveTabContentChanged()
@@ -180,6 +231,76 @@ void FBATabHandler::SetGraphHandler(TSharedPtr<SDockTab> Tab, TSharedPtr<SGraphE
 		GraphHandlerMap.Add(Tab, NewGraphHandler);
 		ActiveGraphHandler = NewGraphHandler;
 	}
+
+	EnforceMemoryBudget();
+}
+
+void FBATabHandler::EnforceMemoryBudget()
+{
+	TArray<TSharedRef<FBAGraphHandler>> BackgroundHandlers;
+	SIZE_T TotalSize = 0;
+	SIZE_T BackgroundSize = 0;
+
+	for (auto& Elem : GraphHandlerMap)
+	{
+		const SIZE_T HandlerSize = Elem.Value->GetAllocatedSize();
+		TotalSize += HandlerSize;
+
+		if (Elem.Value != ActiveGraphHandler.Pin() && !Elem.Value->HasReleasedCaches())
+		{
+			BackgroundHandlers.Add(Elem.Value);
+			BackgroundSize += HandlerSize;
+		}
+	}
+
+	const SIZE_T Budget = static_cast<SIZE_T>(UBASettings_Advanced::Get().BackgroundGraphHandlerMemoryBudget) * 1024;
+	if (Budget > 0 && BackgroundSize > Budget)
+	{
+		// least recently focused first
+		BackgroundHandlers.Sort([](const TSharedRef<FBAGraphHandler>& A, const TSharedRef<FBAGraphHandler>& B)
+		{
+			return A->GetLastFocusTime() < B->GetLastFocusTime();
+		});
+
+		for (TSharedRef<FBAGraphHandler>& GraphHandler : BackgroundHandlers)
+		{
+			if (BackgroundSize <= Budget)
+			{
+				break;
+			}
+
+			const SIZE_T OldSize = GraphHandler->GetAllocatedSize();
+			GraphHandler->ReleaseCaches();
+			const SIZE_T NewSize = GraphHandler->GetAllocatedSize();
+
+			BackgroundSize -= OldSize;
+			TotalSize -= OldSize - NewSize;
+		}
+	}
+
+	SET_MEMORY_STAT(STAT_TabHandler_GraphHandlerCaches, TotalSize);
+}
+
+void FBATabHandler::LogGraphHandlerStats() const
+{
+	SIZE_T TotalSize = 0;
+
+	UE_LOG(LogBlueprintAssist, Log, TEXT("Graph handlers (%d):"), GraphHandlerMap.Num());
+	for (const auto& Elem : GraphHandlerMap)
+	{
+		const TSharedRef<FBAGraphHandler>& GraphHandler = Elem.Value;
+		const SIZE_T HandlerSize = GraphHandler->GetAllocatedSize();
+		TotalSize += HandlerSize;
+
+		TSharedPtr<SDockTab> Tab = Elem.Key.Pin();
+		UE_LOG(LogBlueprintAssist, Log, TEXT("\t%s: %.1f KB%s%s"),
+			Tab ? *Tab->GetTabLabel().ToString() : TEXT("Invalid tab"),
+			HandlerSize / 1024.0,
+			GraphHandler == ActiveGraphHandler.Pin() ? TEXT(" (active)") : TEXT(""),
+			GraphHandler->HasReleasedCaches() ? TEXT(" (released)") : TEXT(""));
+	}
+
+	UE_LOG(LogBlueprintAssist, Log, TEXT("Total: %.1f KB (background budget %d KB)"), TotalSize / 1024.0, UBASettings_Advanced::Get().BackgroundGraphHandlerMemoryBudget);
 }
 
 void FBATabHandler::Cleanup()
@@ -188,6 +309,12 @@ void FBATabHandler::Cleanup()
 	TabManager->OnTabForegrounded_Unsubscribe(OnTabForegroundedDelegateHandle);
 	TabManager->OnActiveTabChanged_Unsubscribe(OnActiveTabChangedDelegateHandle);
 
+	if (FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().OnFocusChanging().Remove(OnFocusChangingDelegateHandle);
+		FSlateApplication::Get().OnApplicationActivationStateChanged().Remove(OnApplicationActivationStateChangedDelegateHandle);
+	}
+
 	for (auto& Elem : GraphHandlerMap)
 	{
 		Elem.Value->Cleanup();
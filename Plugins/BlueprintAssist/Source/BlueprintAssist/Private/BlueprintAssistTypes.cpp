@@ -1,5 +1,6 @@
 ﻿#include "BlueprintAssistTypes.h"
 
+#include "BlueprintAssistNodeLookupCache.h"
 #include "BlueprintAssistMisc/BAMiscUtils.h"
 #include "EdGraph/EdGraph.h"
 
@@ -26,34 +27,32 @@ UEdGraphPin* FBAGraphPinHandle::GetPin(bool bFallbackOnPinName)
 		return nullptr;
 	}
 
-	for (auto Node : Graph->Nodes)
+	UEdGraphNode* Node = FBAUtils::GetNodeFromGraph(Graph.Get(), NodeGuid);
+	if (!Node)
 	{
-		if (Node->NodeGuid == NodeGuid)
+		return nullptr;
+	}
+
+	for (UEdGraphPin* Pin : Node->Pins)
+	{
+		if (Pin->PinId == PinId)
 		{
-			for (UEdGraphPin* Pin : Node->Pins)
-			{
-				if (Pin->PinId == PinId)
-				{
-					return Pin;
-				}
-			}
+			return Pin;
+		}
+	}
 
-			if (bFallbackOnPinName)
+	if (bFallbackOnPinName)
+	{
+		// guid failed, find using PinType & PinName
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if ((Pin->PinType == PinType) && (Pin->PinName == PinName))
 			{
-				// guid failed, find using PinType & PinName
-				for (UEdGraphPin* Pin : Node->Pins)
-				{
-					if ((Pin->PinType == PinType) && (Pin->PinName == PinName))
-					{
-						// side effect: also update the latest PinId
-						PinId = Pin->PinId;
-
-						return Pin;
-					}
-				}
-			}
+				// side effect: also update the latest PinId
+				PinId = Pin->PinId;
 
-			return nullptr;
+				return Pin;
+			}
 		}
 	}
 
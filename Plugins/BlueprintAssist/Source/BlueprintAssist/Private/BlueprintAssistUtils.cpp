@@ -6,6 +6,7 @@
 #include "BlueprintAssistGraphHandler.h"
 #include "BlueprintAssistModule.h"
 #include "BlueprintAssistSettings.h"
+#include "BlueprintAssistWidgetQuery.h"
 #include "BlueprintAssistSettings_Advanced.h"
 #include "BlueprintAssistStats.h"
 #include "BlueprintAssistTabHandler.h"
@@ -405,19 +406,7 @@ FSlateRect FBAUtils::GetCachedNodeArrayBounds(
 
 FVector2D FBAUtils::GetPinPos(TSharedPtr<FBAGraphHandler> GraphHandler, UEdGraphPin* Pin)
 {
-	if (Pin)
-	{
-		UEdGraphNode* OwningNode = Pin->GetOwningNode();
-
-		const FSlateRect NodeBounds = GetCachedNodeBounds(GraphHandler, OwningNode, false);
-
-		// use node left and right for the pin pos x
-		return FVector2D(
-			Pin->Direction == EGPD_Input ? NodeBounds.Left : NodeBounds.Right,
-			GraphHandler->GetPinY(Pin));
-	}
-
-	return FVector2D::ZeroVector;
+	return FBANodeGeometryUtils::GetPinPos(*GraphHandler, Pin);
 }
 
 FVector2D FBAUtils::GetPinPos(TSharedPtr<SGraphPin> Pin)
@@ -1862,14 +1851,9 @@ FString FBAUtils::GetPinName(UEdGraphPin* Pin, bool bIncludeOwningNode)
 	return PinName;
 }
 
-bool FBAUtils::IsWidgetOfType(TSharedPtr<SWidget> Widget, const FString& WidgetTypeName, bool bCheckContains)
+bool FBAUtils::IsWidgetOfType(TSharedPtr<SWidget> Widget, const FName& WidgetTypeName, bool bCheckContains)
 {
-	if (!Widget.IsValid())
-	{
-		return false;
-	}
-
-	return bCheckContains ? Widget->GetTypeAsString().Contains(WidgetTypeName) : Widget->GetTypeAsString() == WidgetTypeName;
+	return FBAWidgetQuery::Get().IsOfType(Widget, WidgetTypeName, bCheckContains);
 }
 
 bool FBAUtils::IsWidgetOfTypeFast(TSharedPtr<SWidget> Widget, const FName& WidgetTypeName)
@@ -1892,31 +1876,10 @@ bool FBAUtils::IsWidgetOfAnyType(TSharedPtr<SWidget> Widget, const TArray<FName>
 
 TSharedPtr<SWidget> FBAUtils::GetChildWidget(
 	TSharedPtr<SWidget> Widget,
-	const FString& WidgetClassName,
+	const FName& WidgetClassName,
 	bool bCheckContains)
 {
-	if (Widget.IsValid())
-	{
-		if (IsWidgetOfType(Widget, WidgetClassName, bCheckContains))
-		{
-			return Widget;
-		}
-
-		// iterate through children
-		if (FChildren* Children = Widget->GetChildren())
-		{
-			for (int i = 0; i < Children->Num(); i++)
-			{
-				TSharedPtr<SWidget> ReturnWidget = GetChildWidget(Children->GetChildAt(i), WidgetClassName, bCheckContains);
-				if (ReturnWidget.IsValid())
-				{
-					return ReturnWidget;
-				}
-			}
-		}
-	}
-
-	return nullptr;
+	return FBAWidgetQuery::Get().FindChild(Widget, WidgetClassName, bCheckContains);
 }
 
 TSharedPtr<SWidget> FBAUtils::GetChildWidgetByTypes(TSharedPtr<SWidget> Widget, const TArray<FName>& WidgetClassNames)
@@ -1978,26 +1941,11 @@ TSharedPtr<SWidget> FBAUtils::GetChildWidget(TSharedPtr<SWidget> Widget, TFuncti
 
 void FBAUtils::GetChildWidgets(
 	TSharedPtr<SWidget> Widget,
-	const FString& WidgetClassName,
+	const FName& WidgetClassName,
 	TArray<TSharedPtr<SWidget>>& OutWidgets,
 	bool bCheckContains)
 {
-	if (Widget.IsValid())
-	{
-		if (IsWidgetOfType(Widget, WidgetClassName, bCheckContains))
-		{
-			OutWidgets.Add(Widget);
-		}
-
-		// iterate through children
-		if (FChildren* Children = Widget->GetChildren())
-		{
-			for (int i = 0; i < Children->Num(); i++)
-			{
-				GetChildWidgets(Children->GetChildAt(i), WidgetClassName, OutWidgets);
-			}
-		}
-	}
+	FBAWidgetQuery::Get().FindChildren(Widget, WidgetClassName, OutWidgets, bCheckContains);
 }
 
 void FBAUtils::GetChildWidgetsByTypes(TSharedPtr<SWidget> Widget,
@@ -2039,33 +1987,10 @@ TSharedPtr<SWindow> FBAUtils::GetParentWindow(TSharedPtr<SWidget> Widget)
 
 TSharedPtr<SWidget> FBAUtils::GetParentWidgetOfType(
 	TSharedPtr<SWidget> Widget,
-	const FString& ParentType,
+	const FName& ParentType,
 	bool bCheckContains)
 {
-	if (!Widget.IsValid())
-	{
-		return nullptr;
-	}
-
-	if (IsWidgetOfType(Widget, ParentType, bCheckContains))
-	{
-		return Widget;
-	}
-
-	if (!Widget->IsParentValid())
-	{
-		return nullptr;
-	}
-
-	check(Widget->GetParentWidget() != Widget)
-
-	TSharedPtr<SWidget> ReturnWidget = GetParentWidgetOfType(Widget->GetParentWidget(), ParentType, bCheckContains);
-	if (ReturnWidget.IsValid())
-	{
-		return ReturnWidget;
-	}
-
-	return nullptr;
+	return FBAWidgetQuery::Get().FindParent(Widget, ParentType, bCheckContains);
 }
 
 TSharedPtr<SWidget> FBAUtils::ScanParentContainersForTypes(TSharedPtr<SWidget> Widget, const TArray<FName>& Types, const FName& StopAtParent)
@@ -2209,6 +2134,14 @@ TSharedPtr<SGraphPin> FBAUtils::GetHoveredGraphPin(TSharedPtr<SGraphPanel> Graph
 	const bool bIsMaterialGraph = Graph->GetClass()->GetFName() == "MaterialGraph";
 	const bool bUseDirectlyHovered = UBASettings_Advanced::Get().bEnableMaterialGraphPinHoverFix && bIsMaterialGraph;
 
+	// the hit test index checks the pins of the nodes and wires under the cursor
+	TSharedPtr<FBAGraphHandler> GraphHandler = GetCurrentGraphHandler();
+	if (GraphHandler && GraphHandler->GetGraphPanel() == GraphPanel)
+	{
+		const FVector2D CursorInPanel = ScreenSpaceToPanelCoord(GraphPanel, FSlateApplication::Get().GetCursorPos());
+		return GraphHandler->GetHitTestIndex().FindHoveredPin(GraphPanel, CursorInPanel, bUseDirectlyHovered);
+	}
+
 	// check if graph pin "IsHovered" function
 	for (UEdGraphNode* Node : Graph->Nodes)
 	{
@@ -2349,6 +2282,12 @@ TSharedPtr<SGraphNode> FBAUtils::GetHoveredGraphNode(TSharedPtr<SGraphPanel> Gra
 
 	const FVector2D CursorInPanel = FBAUtils::ScreenSpaceToPanelCoord(GraphPanel, FSlateApplication::Get().GetCursorPos());
 
+	TSharedPtr<FBAGraphHandler> GraphHandler = GetCurrentGraphHandler();
+	if (GraphHandler && GraphHandler->GetGraphPanel() == GraphPanel)
+	{
+		return GraphHandler->GetHitTestIndex().FindNodeAt(GraphPanel, CursorInPanel);
+	}
+
 	TArray<UEdGraphNode*> CommentNodes;
 	TArray<UEdGraphNode*> RegularNodes;
 	for (UEdGraphNode* Node : Graph->Nodes)
@@ -2493,32 +2432,24 @@ float FBAUtils::AlignTo8x8Grid(const float& InFloat, EBARoundingMethod RoundingM
 
 bool FBAUtils::IsUserInputWidget(TSharedPtr<SWidget> Widget)
 {
-	const FString Type = Widget->GetTypeAsString();
-	if (Type == "SEditableText" ||
-		Type == "SMultiLineEditableTextBox" ||
-		Type == "SMultiLineEditableText" ||
-		Type == "SSearchBox")
+	static const TArray<FName> InputTypes = { "SEditableText", "SMultiLineEditableTextBox", "SMultiLineEditableText", "SSearchBox" };
+	if (IsWidgetOfAnyType(Widget, InputTypes))
 	{
 		return true;
 	}
 
-	const bool Contains = Type.Contains("SSpinBox");
-	return Contains;
+	return FBAWidgetQuery::Get().IsOfType(Widget, "SSpinBox", true);
 }
 
 bool FBAUtils::IsClickableWidget(TSharedPtr<SWidget> Widget)
 {
-	const FString Type = Widget->GetTypeAsString();
-	if (Type == "SComboBox" ||
-		Type == "SComponentClassCombo" ||
-		Type == "SCheckBox" ||
-		Type == "SColorBlock")
+	static const TArray<FName> ClickableTypes = { "SComboBox", "SComponentClassCombo", "SCheckBox", "SColorBlock" };
+	if (IsWidgetOfAnyType(Widget, ClickableTypes))
 	{
 		return true;
 	}
 
-	const bool Contains = Type.Contains("Button");
-	return Contains;
+	return FBAWidgetQuery::Get().IsOfType(Widget, "Button", true);
 }
 
 FVector2D FBAUtils::GraphCoordToPanelCoord(
@@ -3090,6 +3021,11 @@ UEdGraphPin* FBAUtils::GetPinFromGraph(const FGraphPinHandle& Handle, UEdGraph*
 		return nullptr;
 	}
 
+	if (FBANodeLookupCache* LookupCache = FindNodeLookupCache(Graph))
+	{
+		return LookupCache->FindPin(Handle.NodeGuid, Handle.PinId);
+	}
+
 	for (auto Node : Graph->Nodes)
 	{
 		if (Node->NodeGuid == Handle.NodeGuid)
@@ -3114,6 +3050,11 @@ UEdGraphNode* FBAUtils::GetNodeFromGraph(const UEdGraph* Graph, const FGuid& Nod
 		return nullptr;
 	}
 
+	if (FBANodeLookupCache* LookupCache = FindNodeLookupCache(Graph))
+	{
+		return LookupCache->FindNode(NodeGuid);
+	}
+
 	for (UEdGraphNode* Node : Graph->Nodes)
 	{
 		if (Node->NodeGuid == NodeGuid)
@@ -3125,6 +3066,25 @@ UEdGraphNode* FBAUtils::GetNodeFromGraph(const UEdGraph* Graph, const FGuid& Nod
 	return nullptr;
 }
 
+FBANodeLookupCache* FBAUtils::FindNodeLookupCache(const UEdGraph* Graph)
+{
+	if (!Graph || !IsInGameThread())
+	{
+		return nullptr;
+	}
+
+	if (TSharedPtr<FBAGraphHandler> GraphHandler = GetCurrentGraphHandler())
+	{
+		FBANodeLookupCache& LookupCache = GraphHandler->GetNodeLookupCache();
+		if (LookupCache.IsForGraph(Graph))
+		{
+			return &LookupCache;
+		}
+	}
+
+	return nullptr;
+}
+
 bool FBAUtils::IsExtraRootNode(UEdGraphNode* Node)
 {
 	if (UMetaData* MetaData = GetNodeMetaData(Node))
@@ -0,0 +1,172 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "BlueprintAssistVariableIndex.h"
+
+#include "BlueprintAssistTypes.h"
+#include "Editor.h"
+#include "K2Node_FunctionEntry.h"
+#include "BlueprintAssistWidgets/VariableSelectorMenu.h"
+#include "EdGraph/EdGraph.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Misc/LazySingleton.h"
+
+FBAVariableIndex& FBAVariableIndex::Get()
+{
+	return TLazySingleton<FBAVariableIndex>::Get();
+}
+
+void FBAVariableIndex::TearDown()
+{
+	TLazySingleton<FBAVariableIndex>::TearDown();
+}
+
+void FBAVariableIndex::Init()
+{
+	if (GEditor)
+	{
+		GEditor->OnBlueprintCompiled().AddRaw(this, &FBAVariableIndex::Invalidate);
+	}
+
+	FModuleManager::Get().OnModulesChanged().AddRaw(this, &FBAVariableIndex::OnModulesChanged);
+}
+
+void FBAVariableIndex::Cleanup()
+{
+	if (GEditor)
+	{
+		GEditor->OnBlueprintCompiled().RemoveAll(this);
+	}
+
+	FModuleManager::Get().OnModulesChanged().RemoveAll(this);
+
+	Invalidate();
+}
+
+const FBAVariableIndex::FItemArray& FBAVariableIndex::GetMemberVariables(UBlueprint* Blueprint, bool bIncludeInherited)
+{
+	if (!Blueprint || !Blueprint->SkeletonGeneratedClass)
+	{
+		return EmptyItems;
+	}
+
+	FEntry& Entry = FindOrAddEntry(Blueprint);
+
+	TOptional<FItemArray>& Items = bIncludeInherited ? Entry.MemberVariablesWithInherited : Entry.MemberVariables;
+	if (!Items.IsSet())
+	{
+		FItemArray& NewItems = Items.Emplace();
+
+		const EFieldIteratorFlags::SuperClassFlags FieldIteratorSuperFlag = bIncludeInherited
+			? EFieldIteratorFlags::IncludeSuper
+			: EFieldIteratorFlags::ExcludeSuper;
+
+		for (TFieldIterator<BA_PROPERTY> PropertyIt(Blueprint->SkeletonGeneratedClass, FieldIteratorSuperFlag); PropertyIt; ++PropertyIt)
+		{
+			BA_PROPERTY* Property = *PropertyIt;
+
+			// Don't show delegate & components, there is special handling for these
+			if (SVariableSelectorMenu::ShouldSkipProperty(Property))
+			{
+				continue;
+			}
+
+			NewItems.Add(MakeShareable(new FVariableSelectorStruct(Property)));
+		}
+	}
+
+	return Items.GetValue();
+}
+
+const FBAVariableIndex::FItemArray& FBAVariableIndex::GetLocalVariables(UBlueprint* Blueprint, UEdGraph* Graph)
+{
+	// We want to pull local variables from the top level function graphs
+	UEdGraph* TopLevelGraph = Graph ? FBlueprintEditorUtils::GetTopLevelGraph(Graph) : nullptr;
+	if (!Blueprint || !Blueprint->SkeletonGeneratedClass || !TopLevelGraph)
+	{
+		return EmptyItems;
+	}
+
+	FEntry& Entry = FindOrAddEntry(Blueprint);
+
+	if (FItemArray* FoundItems = Entry.LocalVariablesByGraph.Find(TopLevelGraph->GetFName()))
+	{
+		return *FoundItems;
+	}
+
+	FItemArray& Items = Entry.LocalVariablesByGraph.Add(TopLevelGraph->GetFName());
+
+	UFunction* Func = BA_FIND_FIELD<UFunction>(Blueprint->SkeletonGeneratedClass, TopLevelGraph->GetFName());
+	if (!Func)
+	{
+		return Items;
+	}
+
+	TArray<UK2Node_FunctionEntry*> FunctionEntryNodes;
+	TopLevelGraph->GetNodesOfClass<UK2Node_FunctionEntry>(FunctionEntryNodes);
+
+	// Search in all FunctionEntry nodes for their local variables
+	for (UK2Node_FunctionEntry* const FunctionEntry : FunctionEntryNodes)
+	{
+		for (const FBPVariableDescription& Variable : FunctionEntry->LocalVariables)
+		{
+			if (BA_PROPERTY* Property = BA_FIND_PROPERTY<BA_PROPERTY>(Func, Variable.VarName))
+			{
+				Items.Add(MakeShareable(new FVariableSelectorStruct(Property)));
+			}
+		}
+	}
+
+	return Items;
+}
+
+void FBAVariableIndex::Invalidate()
+{
+	for (const auto& Elem : Entries)
+	{
+		if (UBlueprint* Blueprint = Elem.Key.Get())
+		{
+			Blueprint->OnChanged().RemoveAll(this);
+			Blueprint->OnCompiled().RemoveAll(this);
+		}
+	}
+
+	Entries.Empty();
+}
+
+FBAVariableIndex::FEntry& FBAVariableIndex::FindOrAddEntry(UBlueprint* Blueprint)
+{
+	FEntry* Entry = Entries.Find(Blueprint);
+
+	// the skeleton class was replaced without us being notified, the cached properties may be gone
+	if (Entry && Entry->SkeletonClass.Get() != Blueprint->SkeletonGeneratedClass)
+	{
+		Entries.Remove(Blueprint);
+		Entry = nullptr;
+	}
+
+	if (!Entry)
+	{
+		Entry = &Entries.Add(Blueprint);
+		Entry->SkeletonClass = Blueprint->SkeletonGeneratedClass;
+
+		// structural changes (adding a variable or local variable) regenerate the skeleton class without a full compile
+		Blueprint->OnChanged().RemoveAll(this);
+		Blueprint->OnCompiled().RemoveAll(this);
+		Blueprint->OnChanged().AddRaw(this, &FBAVariableIndex::OnBlueprintChanged);
+		Blueprint->OnCompiled().AddRaw(this, &FBAVariableIndex::OnBlueprintChanged);
+	}
+
+	return *Entry;
+}
+
+void FBAVariableIndex::OnBlueprintChanged(UBlueprint* Blueprint)
+{
+	// child blueprints inherit the changed variables, so clear everything rather than just this blueprint
+	Invalidate();
+}
+
+void FBAVariableIndex::OnModulesChanged(FName ModuleName, EModuleChangeReason Reason)
+{
+	Invalidate();
+}
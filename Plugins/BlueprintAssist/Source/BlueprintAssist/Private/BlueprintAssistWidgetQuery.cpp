@@ -0,0 +1,260 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "BlueprintAssistWidgetQuery.h"
+
+#include "BlueprintAssistUtils.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Docking/TabManager.h"
+#include "Misc/LazySingleton.h"
+#include "Widgets/SWindow.h"
+
+FBAWidgetQuery& FBAWidgetQuery::Get()
+{
+	return TLazySingleton<FBAWidgetQuery>::Get();
+}
+
+void FBAWidgetQuery::TearDown()
+{
+	TLazySingleton<FBAWidgetQuery>::TearDown();
+}
+
+void FBAWidgetQuery::Init()
+{
+	if (FSlateApplication::IsInitialized())
+	{
+		OnFocusChangingDelegateHandle = FSlateApplication::Get().OnFocusChanging().AddRaw(this, &FBAWidgetQuery::OnFocusChanging);
+
+		// tabs can be swapped without moving the focus
+		OnActiveTabChangedDelegateHandle = FGlobalTabmanager::Get()->OnActiveTabChanged_Subscribe(
+			FOnActiveTabChanged::FDelegate::CreateLambda([this](TSharedPtr<SDockTab>, TSharedPtr<SDockTab>)
+			{
+				InvalidateAll();
+			}));
+	}
+}
+
+void FBAWidgetQuery::Cleanup()
+{
+	if (FSlateApplication::IsInitialized())
+	{
+		FSlateApplication::Get().OnFocusChanging().Remove(OnFocusChangingDelegateHandle);
+		FGlobalTabmanager::Get()->OnActiveTabChanged_Unsubscribe(OnActiveTabChangedDelegateHandle);
+	}
+
+	QueryCache.Empty();
+	WindowGenerations.Empty();
+	TypeContainsCache.Empty();
+}
+
+bool FBAWidgetQuery::IsOfType(const TSharedPtr<SWidget>& Widget, FName TypeName, bool bCheckContains)
+{
+	if (!Widget.IsValid())
+	{
+		return false;
+	}
+
+	const FName WidgetType = Widget->GetType();
+	if (WidgetType == TypeName)
+	{
+		return true;
+	}
+
+	return bCheckContains && DoesTypeContain(WidgetType, TypeName);
+}
+
+TSharedPtr<SWidget> FBAWidgetQuery::FindChild(TSharedPtr<SWidget> Root, FName TypeName, bool bCheckContains)
+{
+	if (!Root.IsValid())
+	{
+		return nullptr;
+	}
+
+	const FQueryKey Key { Root, TypeName, bCheckContains };
+	if (FQueryResult* Result = QueryCache.Find(Key))
+	{
+		if (Result->Generation == GetGeneration(Result->Window))
+		{
+			if (!Result->bFound)
+			{
+				NumCacheHits += 1;
+				return nullptr;
+			}
+
+			// the widget tree can change without a focus or tab event, so only return the widget if it is still under the root
+			TSharedPtr<SWidget> Widget = Result->Widget.Pin();
+			if (Widget.IsValid() && IsDescendantOf(Widget, Root))
+			{
+				NumCacheHits += 1;
+				return Widget;
+			}
+		}
+	}
+
+	NumCacheMisses += 1;
+
+	TSharedPtr<SWidget> Found = FindChildUncached(Root, TypeName, bCheckContains);
+
+	// roots are usually long lived (windows, tabs, graph editors), this only happens if something queries temporary widgets
+	if (QueryCache.Num() >= 1024)
+	{
+		QueryCache.Reset();
+	}
+
+	FQueryResult& NewResult = QueryCache.FindOrAdd(Key);
+	NewResult.bFound = Found.IsValid();
+	NewResult.Widget = Found;
+	NewResult.Window = FBAUtils::GetParentWindow(Root);
+	NewResult.Generation = GetGeneration(NewResult.Window);
+
+	return Found;
+}
+
+TSharedPtr<SWidget> FBAWidgetQuery::FindChildUncached(TSharedPtr<SWidget> Root, FName TypeName, bool bCheckContains)
+{
+	if (Root.IsValid())
+	{
+		if (IsOfType(Root, TypeName, bCheckContains))
+		{
+			return Root;
+		}
+
+		// iterate through children
+		if (FChildren* Children = Root->GetChildren())
+		{
+			for (int i = 0; i < Children->Num(); i++)
+			{
+				TSharedPtr<SWidget> ReturnWidget = FindChildUncached(Children->GetChildAt(i), TypeName, bCheckContains);
+				if (ReturnWidget.IsValid())
+				{
+					return ReturnWidget;
+				}
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+void FBAWidgetQuery::FindChildren(TSharedPtr<SWidget> Root, FName TypeName, TArray<TSharedPtr<SWidget>>& OutWidgets, bool bCheckContains)
+{
+	if (Root.IsValid())
+	{
+		if (IsOfType(Root, TypeName, bCheckContains))
+		{
+			OutWidgets.Add(Root);
+		}
+
+		// iterate through children
+		if (FChildren* Children = Root->GetChildren())
+		{
+			for (int i = 0; i < Children->Num(); i++)
+			{
+				FindChildren(Children->GetChildAt(i), TypeName, OutWidgets, bCheckContains);
+			}
+		}
+	}
+}
+
+TSharedPtr<SWidget> FBAWidgetQuery::FindParent(TSharedPtr<SWidget> Widget, FName TypeName, bool bCheckContains)
+{
+	while (Widget.IsValid())
+	{
+		if (IsOfType(Widget, TypeName, bCheckContains))
+		{
+			return Widget;
+		}
+
+		if (!Widget->IsParentValid())
+		{
+			return nullptr;
+		}
+
+		check(Widget->GetParentWidget() != Widget);
+		Widget = Widget->GetParentWidget();
+	}
+
+	return nullptr;
+}
+
+void FBAWidgetQuery::InvalidateWindow(TSharedPtr<SWindow> Window)
+{
+	if (Window.IsValid())
+	{
+		WindowGenerations.FindOrAdd(Window) += 1;
+	}
+}
+
+void FBAWidgetQuery::InvalidateAll()
+{
+	GlobalGeneration += 1;
+
+	// drop results for destroyed widgets so the cache doesn't keep growing
+	for (auto It = QueryCache.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().Root.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	for (auto It = WindowGenerations.CreateIterator(); It; ++It)
+	{
+		if (!It.Key().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+uint32 FBAWidgetQuery::GetGeneration(const TWeakPtr<SWindow>& Window) const
+{
+	const uint32* WindowGeneration = WindowGenerations.Find(Window);
+	return GlobalGeneration + (WindowGeneration ? *WindowGeneration : 0);
+}
+
+bool FBAWidgetQuery::DoesTypeContain(FName WidgetType, FName TypeName)
+{
+	const TPair<FName, FName> Key(WidgetType, TypeName);
+	if (const bool* bCached = TypeContainsCache.Find(Key))
+	{
+		return *bCached;
+	}
+
+	const bool bContains = WidgetType.ToString().Contains(TypeName.ToString());
+	TypeContainsCache.Add(Key, bContains);
+	return bContains;
+}
+
+bool FBAWidgetQuery::IsDescendantOf(TSharedPtr<SWidget> Widget, const TSharedPtr<SWidget>& Root)
+{
+	while (Widget.IsValid())
+	{
+		if (Widget == Root)
+		{
+			return true;
+		}
+
+		if (!Widget->IsParentValid())
+		{
+			return false;
+		}
+
+		Widget = Widget->GetParentWidget();
+	}
+
+	return false;
+}
+
+void FBAWidgetQuery::OnFocusChanging(
+	const FFocusEvent& FocusEvent,
+	const FWeakWidgetPath& OldFocusedWidgetPath,
+	const TSharedPtr<SWidget>& OldFocusedWidget,
+	const FWidgetPath& NewFocusedWidgetPath,
+	const TSharedPtr<SWidget>& NewFocusedWidget)
+{
+	InvalidateWindow(OldFocusedWidgetPath.Window.Pin());
+	if (NewFocusedWidgetPath.IsValid())
+	{
+		InvalidateWindow(NewFocusedWidgetPath.GetWindow());
+	}
+}
@@ -7,6 +7,7 @@
 #include "BlueprintActionMenuBuilder.h"
 #include "BlueprintActionMenuItem.h"
 #include "BlueprintActionMenuUtils.h"
+#include "BlueprintAssistActionMenuCache.h"
 #include "BlueprintAssistGraphHandler.h"
 #include "BlueprintDragDropMenuItem.h"
 #include "BlueprintEditor.h"
@@ -181,7 +182,7 @@ void SBABlueprintActionMenu::Construct(const FArguments& InArgs)
 			+ SVerticalBox::Slot()
 			[
 				SAssignNew(FilteredList, SBAFilteredList<TSharedPtr<FBAActionMenuItem>>)
-				.InitListItems(this, &SBABlueprintActionMenu::InitListItems)
+				.ItemsSource(GetActionItems())
 				.OnGenerateRow(this, &SBABlueprintActionMenu::CreateItemWidget)
 				.OnSelectItem(this, &SBABlueprintActionMenu::SelectItem)
 				.WidgetSize(GetWidgetSize())
@@ -202,7 +203,26 @@ void SBABlueprintActionMenu::Construct(const FArguments& InArgs)
 	UE_LOG(LogBlueprintAssist, Verbose, TEXT("Create BA action menu took %.2f"), ThisTime);
 }
 
-void SBABlueprintActionMenu::InitListItems(TArray<TSharedPtr<FBAActionMenuItem>>& Items)
+TSharedRef<const TArray<TSharedPtr<FBAActionMenuItem>>> SBABlueprintActionMenu::GetActionItems()
+{
+	UEdGraphPin* ContextPin = bUseSelectedPin ? GraphHandler->GetSelectedPin() : nullptr;
+	const FBAActionMenuContext Context(GraphHandler->GetFocusedEdGraph(), ContextPin, bContextSensitive);
+
+	if (TSharedPtr<const TArray<TSharedPtr<FBAActionMenuItem>>> CachedItems = FBAActionMenuCache::Get().FindItems(Context))
+	{
+		return CachedItems.ToSharedRef();
+	}
+
+	TSharedRef<TArray<TSharedPtr<FBAActionMenuItem>>> Items = MakeShared<TArray<TSharedPtr<FBAActionMenuItem>>>();
+	if (InitListItems(*Items))
+	{
+		FBAActionMenuCache::Get().AddItems(Context, Items);
+	}
+
+	return Items;
+}
+
+bool SBABlueprintActionMenu::InitListItems(TArray<TSharedPtr<FBAActionMenuItem>>& Items)
 {
 	double ThisTime = 0;
 	{
@@ -210,13 +230,13 @@ void SBABlueprintActionMenu::InitListItems(TArray<TSharedPtr<FBAActionMenuItem>>
 		FBlueprintEditor* Editor = FBAUtils::GetBlueprintEditorForGraph(GraphHandler->GetFocusedEdGraph());
 		if (!Editor)
 		{
-			return;
+			return false;
 		}
 
 		TWeakPtr<FBlueprintEditor> EditorWeakPtr = StaticCastWeakPtr<FBlueprintEditor>(Editor->AsWeak());
 		if (!EditorWeakPtr.IsValid())
 		{
-			return;
+			return false;
 		}
 
 #if BA_UE_VERSION_OR_LATER(5, 2)
@@ -246,11 +266,13 @@ void SBABlueprintActionMenu::InitListItems(TArray<TSharedPtr<FBAActionMenuItem>>
 			| EContextTargetFlags::TARGET_NonImportedTypes;
 
 		// NOTE: cannot call GetGraphContextActions() during serialization and GC due to its use of FindObject()
-		if (!GIsSavingPackage && !IsGarbageCollecting() && FilterContext.Blueprints.Num() > 0)
+		if (GIsSavingPackage || IsGarbageCollecting() || FilterContext.Blueprints.Num() == 0)
 		{
-			FBlueprintActionMenuUtils::MakeContextMenu(FilterContext, bContextSensitive, OriginalFlagsMask, MenuBuilder);
+			return false;
 		}
 
+		FBlueprintActionMenuUtils::MakeContextMenu(FilterContext, bContextSensitive, OriginalFlagsMask, MenuBuilder);
+
 		for (int i = 0; i < MenuBuilder.GetNumActions(); ++i)
 		{
 #if BA_UE_VERSION_OR_LATER(5, 5)
@@ -266,26 +288,38 @@ void SBABlueprintActionMenu::InitListItems(TArray<TSharedPtr<FBAActionMenuItem>>
 		}
 	}
 	UE_LOG(LogBlueprintAssist, Verbose, TEXT("Get all actions took %.2f"), ThisTime);
+	return true;
 }
 
 TSharedRef<ITableRow> SBABlueprintActionMenu::CreateItemWidget(TSharedPtr<FBAActionMenuItem> Item, const TSharedRef<STableViewBase>& OwnerTable) const
 {
 	// construct the icon widget
-	FSlateBrush const* IconBrush = FAppStyle::GetBrush(TEXT("NoBrush"));
-	FSlateBrush const* SecondaryBrush = FAppStyle::GetBrush(TEXT("NoBrush"));
-	FSlateColor IconColor = FSlateColor::UseForeground();
-	FSlateColor SecondaryIconColor = FSlateColor::UseForeground();
-	FText IconToolTip = Item->Action->GetTooltipDescription();
-	FString IconDocLink, IconDocExcerpt;
-
-	GetPaletteItemIcon(Item->Action, GraphHandler->GetBlueprint(), IconBrush, IconColor, IconToolTip, IconDocLink, IconDocExcerpt, SecondaryBrush, SecondaryIconColor);
+	const FBAActionMenuItemIcon& Icon = GetItemIcon(Item);
 
 	TSharedRef<SWidget> IconWidget = SPinTypeSelector::ConstructPinTypeImage(
-		IconBrush,
-		IconColor,
-		SecondaryBrush,
-		SecondaryIconColor,
-		IDocumentation::Get()->CreateToolTip(IconToolTip, NULL, IconDocLink, IconDocExcerpt));
+		Icon.IconBrush,
+		Icon.IconColor,
+		Icon.SecondaryBrush,
+		Icon.SecondaryIconColor,
+		nullptr);
+
+	TWeakPtr<FBAActionMenuItem> WeakItem = Item;
+	IconWidget->SetToolTip(TAttribute<TSharedPtr<IToolTip>>::CreateLambda([WeakItem]() -> TSharedPtr<IToolTip>
+	{
+		TSharedPtr<FBAActionMenuItem> PinnedItem = WeakItem.Pin();
+		if (!PinnedItem.IsValid() || !PinnedItem->Icon.IsSet())
+		{
+			return nullptr;
+		}
+
+		if (!PinnedItem->ToolTip.IsValid())
+		{
+			const FBAActionMenuItemIcon& ItemIcon = PinnedItem->Icon.GetValue();
+			PinnedItem->ToolTip = IDocumentation::Get()->CreateToolTip(ItemIcon.ToolTipText, nullptr, ItemIcon.DocLink, ItemIcon.DocExcerpt);
+		}
+
+		return PinnedItem->ToolTip;
+	}));
 
 	IconWidget->SetEnabled(false);
 
@@ -304,6 +338,23 @@ TSharedRef<ITableRow> SBABlueprintActionMenu::CreateItemWidget(TSharedPtr<FBAAct
 		];
 }
 
+const FBAActionMenuItemIcon& SBABlueprintActionMenu::GetItemIcon(TSharedPtr<FBAActionMenuItem> Item) const
+{
+	if (!Item->Icon.IsSet())
+	{
+		static const FSlateBrush* NoBrush = FAppStyle::GetBrush(TEXT("NoBrush"));
+
+		FBAActionMenuItemIcon& Icon = Item->Icon.Emplace();
+		Icon.IconBrush = NoBrush;
+		Icon.SecondaryBrush = NoBrush;
+		Icon.ToolTipText = Item->Action->GetTooltipDescription();
+
+		GetPaletteItemIcon(Item->Action, GraphHandler->GetBlueprint(), Icon.IconBrush, Icon.IconColor, Icon.ToolTipText, Icon.DocLink, Icon.DocExcerpt, Icon.SecondaryBrush, Icon.SecondaryIconColor);
+	}
+
+	return Item->Icon.GetValue();
+}
+
 void SBABlueprintActionMenu::SelectItem(TSharedPtr<FBAActionMenuItem> Item)
 {
 	TSharedPtr<SGraphEditor> GraphEditor = GraphHandler->GetGraphEditor();
@@ -320,15 +371,10 @@ void SBABlueprintActionMenu::SelectItem(TSharedPtr<FBAActionMenuItem> Item)
 
 void SBABlueprintActionMenu::OnContextSensitiveChanged(ECheckBoxState NewState)
 {
-	if (NewState == ECheckBoxState::Checked)
-	{
-		FilteredList->GenerateItems();
-		bContextSensitive = true;
-	}
-	else
-	{
-		bContextSensitive = false;
-	}
+	bContextSensitive = NewState == ECheckBoxState::Checked;
+
+	FilteredList->ItemsSource = GetActionItems();
+	FilteredList->GenerateItems();
 }
 
 #endif
\ No newline at end of file
@@ -1,6 +1,8 @@
 ﻿#include "BlueprintAssistWidgets/BADebugMenu.h"
 
 #include "BlueprintAssistGraphHandler.h"
+#include "BlueprintAssistTabHandler.h"
+#include "BlueprintAssistWidgetQuery.h"
 #include "SGraphPanel.h"
 #include "BlueprintAssistMisc/BAMiscUtils.h"
 #include "Components/VerticalBox.h"
@@ -145,6 +147,90 @@ void SBADebugMenu::Construct(const FArguments& InArgs)
 					}
 				}
 
+				return FReply::Handled();
+			})
+		]
+		+ SVerticalBox::Slot().AutoHeight()
+		[
+			SNew(SButton)
+			.Text(INVTEXT("Log node size change data memory"))
+			.OnClicked_Lambda([]()
+			{
+				if (auto GH = FBAUtils::GetCurrentGraphHandler())
+				{
+					SIZE_T HashedSize = 0;
+					SIZE_T UncompactedSize = 0;
+					int32 NumNodes = 0;
+
+					for (UEdGraphNode* Node : GH->GetFocusedEdGraph()->Nodes)
+					{
+						if (const FBANodeSizeChangeData* ChangeData = GH->GetNodeSizeChangeDataMap().Find(Node->NodeGuid))
+						{
+							HashedSize += ChangeData->GetAllocatedSize();
+							UncompactedSize += FBANodeSizeChangeData::EstimateUncompactedSize(Node);
+							NumNodes += 1;
+						}
+					}
+
+					if (NumNodes > 0)
+					{
+						const double Per1000 = 1000.0 / NumNodes;
+						UE_LOG(LogBlueprintAssist, Log, TEXT("Node size change data for %d nodes: %llu bytes (uncompacted estimate %llu bytes)"),
+							NumNodes, static_cast<uint64>(HashedSize), static_cast<uint64>(UncompactedSize));
+						UE_LOG(LogBlueprintAssist, Log, TEXT("\tPer 1000 nodes: %.1f KB, saved %.1f KB"),
+							HashedSize * Per1000 / 1024.0, (static_cast<double>(UncompactedSize) - HashedSize) * Per1000 / 1024.0);
+					}
+				}
+
+				return FReply::Handled();
+			})
+		]
+		+ SVerticalBox::Slot().AutoHeight()
+		[
+			SNew(SButton)
+			.Text(INVTEXT("Log graph handler memory"))
+			.OnClicked_Lambda([]()
+			{
+				FBATabHandler::Get().LogGraphHandlerStats();
+				return FReply::Handled();
+			})
+		]
+		+ SVerticalBox::Slot().AutoHeight()
+		[
+			SNew(SButton)
+			.Text(INVTEXT("Benchmark widget queries"))
+			.OnClicked_Lambda([]()
+			{
+				// the queries made when handling a key down event in the graph
+				TSharedPtr<SWindow> Window = FSlateApplication::Get().GetActiveTopLevelWindow();
+				TSharedPtr<SWidget> FocusedWidget = FSlateApplication::Get().GetKeyboardFocusedWidget();
+				if (!Window || !FocusedWidget)
+				{
+					return FReply::Handled();
+				}
+
+				constexpr int32 NumIterations = 1000;
+				FBAWidgetQuery& WidgetQuery = FBAWidgetQuery::Get();
+
+				const auto Benchmark = [&](const TCHAR* Name, TFunctionRef<void()> Func)
+				{
+					const double StartTime = FPlatformTime::Seconds();
+					for (int32 i = 0; i < NumIterations; ++i)
+					{
+						Func();
+					}
+
+					const double MicroSeconds = (FPlatformTime::Seconds() - StartTime) * 1000000.0 / NumIterations;
+					UE_LOG(LogBlueprintAssist, Log, TEXT("\t%s: %.2f us"), Name, MicroSeconds);
+				};
+
+				UE_LOG(LogBlueprintAssist, Log, TEXT("Widget queries (%d iterations, focused %s):"), NumIterations, *FocusedWidget->GetTypeAsString());
+				Benchmark(TEXT("FindParent SGraphPin"), [&]() { WidgetQuery.FindParent(FocusedWidget, "SGraphPin", true); });
+				Benchmark(TEXT("IsUserInputWidget"), [&]() { FBAUtils::IsUserInputWidget(FocusedWidget); });
+				Benchmark(TEXT("FindChild SEditableText (uncached)"), [&]() { WidgetQuery.FindChildUncached(Window, "SEditableText"); });
+				Benchmark(TEXT("FindChild SEditableText (cached)"), [&]() { WidgetQuery.FindChild(Window, "SEditableText"); });
+				UE_LOG(LogBlueprintAssist, Log, TEXT("\tCache hits %d misses %d"), WidgetQuery.GetNumCacheHits(), WidgetQuery.GetNumCacheMisses());
+
 				return FReply::Handled();
 			})
 		]
@@ -1,11 +1,13 @@
 ﻿#include "BlueprintAssistWidgets/BlueprintAssistGraphOverlay.h"
 
 #include "BlueprintAssistCache.h"
+#include "BlueprintAssistGlobals.h"
 #include "BlueprintAssistGraphHandler.h"
 #include "BlueprintAssistSettings_EditorFeatures.h"
 #include "BlueprintAssistWidgets/SBASizeProgress.h"
 #include "BlueprintAssistStyle.h"
 #include "BlueprintAssistUtils.h"
+#include "EdGraphNode_Comment.h"
 #include "SGraphPanel.h"
 #include "EdGraph/EdGraph.h"
 
@@ -30,6 +32,11 @@ void SBlueprintAssistGraphOverlay::Construct(const FArguments& InArgs, TSharedPt
 	];
 }
 
+SBlueprintAssistGraphOverlay::~SBlueprintAssistGraphOverlay()
+{
+	ExitLevelOfDetail();
+}
+
 int32 SBlueprintAssistGraphOverlay::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
 {
 	if (!SizeProgressWidget->IsSnapshotValid())
@@ -45,6 +52,16 @@ int32 SBlueprintAssistGraphOverlay::OnPaint(const FPaintArgs& Args, const FGeome
 		return OutgoingLayer;
 	}
 
+	// the node widgets are collapsed, so draw the level of detail even if our graph is not the focused graph
+	if (bLevelOfDetailActive && OwnerGraphHandler)
+	{
+		if (TSharedPtr<SGraphPanel> OwnerGraphPanel = OwnerGraphHandler->GetGraphPanel())
+		{
+			VisibleGraphBounds = CalculateVisibleGraphBounds(AllottedGeometry, MyCullingRect, OwnerGraphPanel);
+			DrawLevelOfDetail(OutDrawElements, AllottedGeometry, LayerId, OwnerGraphPanel);
+		}
+	}
+
 	// do nothing if the current graph handler is not our owner graph handler (or is null)
 	TSharedPtr<FBAGraphHandler> CurrentGraphHandler = FBAUtils::GetCurrentGraphHandler();
 	if (!CurrentGraphHandler || CurrentGraphHandler != OwnerGraphHandler)
@@ -58,82 +75,80 @@ int32 SBlueprintAssistGraphOverlay::OnPaint(const FPaintArgs& Args, const FGeome
 		return OutgoingLayer;
 	}
 
-	// highlight pins
-	for (auto Kvp : PinsToHighlight)
-	{
-		FBAGraphPinHandle PinHandle = Kvp.Key;
-		FLinearColor Color = Kvp.Value;
+	// everything below is culled against the visible area in graph space, so the cost depends on what is on screen
+	VisibleGraphBounds = CalculateVisibleGraphBounds(AllottedGeometry, MyCullingRect, GraphPanel);
 
-		if (UEdGraphPin* Pin = PinHandle.GetPin(false))
+	// collapsed node widgets are not arranged, so skip anything drawn using the widget geometry
+	if (!bLevelOfDetailActive)
+	{
+		// highlight pins
+		for (const auto& Kvp : PinsToHighlight)
 		{
-			if (TSharedPtr<SGraphPin> GraphPin = FBAUtils::GetGraphPin(GraphPanel, Pin))
+			FBAGraphPinHandle PinHandle = Kvp.Key;
+			const FLinearColor& Color = Kvp.Value;
+
+			if (UEdGraphPin* Pin = PinHandle.GetPin(false))
 			{
-				if (FBAUtils::IsPinVisible(GraphPin->GetPinObj()))
+				// skip searching for the pin widget if the owning node is off screen
+				if (!IsGraphRectVisible(FBAUtils::GetNodeBounds(Pin->GetOwningNode())))
 				{
-					const FSlateRect PinBounds = FBAUtils::GetPinBounds(GraphPin);
-					if (GraphPanel->IsRectVisible(PinBounds.GetBottomRight(), PinBounds.GetTopLeft()))
+					continue;
+				}
+
+				if (TSharedPtr<SGraphPin> GraphPin = FBAUtils::GetGraphPin(GraphPanel, Pin))
+				{
+					if (FBAUtils::IsPinVisible(GraphPin->GetPinObj()))
 					{
-						const FPaintGeometry PaintGeometry = GraphPin->GetPaintSpaceGeometry().ToPaintGeometry();
-
-						// Draw a border around the pin
-						FSlateDrawElement::MakeBox(
-							OutDrawElements,
-							OutgoingLayer,
-							PaintGeometry,
-							CachedBorderBrush,
-							ESlateDrawEffect::None,
-							Color
-						);
+						const FSlateRect PinBounds = FBAUtils::GetPinBounds(GraphPin);
+						if (IsGraphRectVisible(PinBounds))
+						{
+							const FPaintGeometry PaintGeometry = GraphPin->GetPaintSpaceGeometry().ToPaintGeometry();
+
+							// Draw a border around the pin
+							FSlateDrawElement::MakeBox(
+								OutDrawElements,
+								OutgoingLayer,
+								PaintGeometry,
+								CachedBorderBrush,
+								ESlateDrawEffect::None,
+								Color
+							);
+						}
 					}
 				}
 			}
 		}
-	}
 
-	if (CurrentNodeToDraw.IsValid())
-	{
-		if (TSharedPtr<SGraphNode> GraphNode = FBAUtils::GetGraphNode(GraphPanel, CurrentNodeToDraw.Get()))
+		if (CurrentNodeToDraw.IsValid())
 		{
-			const FSlateRect NodeBounds = FBAUtils::GetNodeBounds(GraphNode);
-			if (GraphPanel->IsRectVisible(NodeBounds.GetBottomRight(), NodeBounds.GetTopLeft()))
+			if (TSharedPtr<SGraphNode> GraphNode = FBAUtils::GetGraphNode(GraphPanel, CurrentNodeToDraw.Get()))
 			{
-				const FPaintGeometry PaintGeometry = GraphNode->GetPaintSpaceGeometry().ToPaintGeometry();
-
-				// Draw a border around the pin
-				FSlateDrawElement::MakeBox(
-					OutDrawElements,
-					OutgoingLayer,
-					PaintGeometry,
-					CachedBorderBrush,
-					ESlateDrawEffect::None,
-					FLinearColor(1, 1, 0, 0.25f)
-				);
+				const FSlateRect NodeBounds = FBAUtils::GetNodeBounds(GraphNode);
+				if (IsGraphRectVisible(NodeBounds))
+				{
+					const FPaintGeometry PaintGeometry = GraphNode->GetPaintSpaceGeometry().ToPaintGeometry();
+
+					// Draw a border around the pin
+					FSlateDrawElement::MakeBox(
+						OutDrawElements,
+						OutgoingLayer,
+						PaintGeometry,
+						CachedBorderBrush,
+						ESlateDrawEffect::None,
+						FLinearColor(1, 1, 0, 0.25f)
+					);
+				}
 			}
 		}
 	}
 
 	// draw lines
-	for (const FBAGraphOverlayLineParams& ToDraw : LinesToDraw)
-	{
-		const FVector2D Start = FBAUtils::GraphCoordToPanelCoord(GraphPanel, ToDraw.Start);
-		const FVector2D End = FBAUtils::GraphCoordToPanelCoord(GraphPanel, ToDraw.End);
-		TArray<FVector2D> LinePoints = { Start, End };
-
-		FSlateDrawElement::MakeLines(
-			OutDrawElements,
-			LayerId,
-			AllottedGeometry.ToPaintGeometry(),
-			LinePoints,
-			ESlateDrawEffect::None,
-			ToDraw.Color,
-			true,
-			5.0f);
-	}
+	DrawLineBatch(OutDrawElements, AllottedGeometry, LayerId, GraphPanel);
 
 	// draw bounds
 	for (const FBAGraphOverlayBounds& ToDraw : BoundsToDraw)
 	{
-		if (GraphPanel->IsRectVisible(ToDraw.Bounds.GetBottomRight(), ToDraw.Bounds.GetTopLeft()))
+		if (IsGraphRectVisible(ToDraw.Bounds))
 		{
 			const FVector2D TL = FBAUtils::GraphCoordToPanelCoord(GraphPanel, ToDraw.Bounds.GetTopLeft());
 			const FVector2D TR = FBAUtils::GraphCoordToPanelCoord(GraphPanel, ToDraw.Bounds.GetTopRight());
@@ -155,24 +170,38 @@ int32 SBlueprintAssistGraphOverlay::OnPaint(const FPaintArgs& Args, const FGeome
 
 	DrawNodeGroups(OutDrawElements, AllottedGeometry, OutgoingLayer, GraphPanel);
 
+	if (bLevelOfDetailActive)
+	{
+		return OutgoingLayer;
+	}
+
 	// draw locked nodes
-	for (auto Node : CurrentGraphHandler->GetFocusedEdGraph()->Nodes)
+	const static FVector2D ImageSize = FVector2D(16, 16);
+	for (const TWeakObjectPtr<UEdGraphNode>& LockedNode : CurrentGraphHandler->LockedNodes)
 	{
-		if (CurrentGraphHandler->GetNodeData(Node).bLocked)
+		UEdGraphNode* Node = LockedNode.Get();
+		if (!Node)
 		{
-			TSharedPtr<SGraphNode> GraphNode = FBAUtils::GetGraphNode(GraphPanel, Node);
-			if (GraphNode)
-			{
-				const static FVector2D ImageSize = FVector2D(16, 16);
-				DrawIconOnNode(OutDrawElements, OutgoingLayer, GraphNode, GraphPanel, CachedLockBrush, ImageSize, FVector2D(0, 1.0f));
-			}
+			continue;
+		}
+
+		// the icon is drawn on the corner of the node, so extend the bounds by the icon size
+		if (!IsGraphRectVisible(FBAUtils::GetNodeBounds(Node).ExtendBy(FMargin(ImageSize.X, ImageSize.Y))))
+		{
+			continue;
+		}
+
+		TSharedPtr<SGraphNode> GraphNode = FBAUtils::GetGraphNode(GraphPanel, Node);
+		if (GraphNode)
+		{
+			DrawIconOnNode(OutDrawElements, OutgoingLayer, GraphNode, GraphPanel, CachedLockBrush, ImageSize, FVector2D(0, 1.0f));
 		}
 	}
 
 	for (auto& Elem : TextToDraw)
 	{
 		const FBAGraphOverlayTextParams& Param = Elem.Value;
-		if (Param.Widget.IsValid())
+		if (Param.Widget.IsValid() && IsGraphRectVisible(Param.WidgetBounds))
 		{
 			const FSlateFontInfo FontInfo = FSlateFontInfo(FCoreStyle::GetDefaultFont(), 11);
 			DrawWidgetAsBox(OutDrawElements, OutgoingLayer - 1, GraphPanel, Param.Widget.Pin(), Param.WidgetBounds, FLinearColor::Black);
@@ -185,6 +214,8 @@ int32 SBlueprintAssistGraphOverlay::OnPaint(const FPaintArgs& Args, const FGeome
 
 void SBlueprintAssistGraphOverlay::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
 {
+	UpdateLevelOfDetail();
+
 	for (int i = LinesToDraw.Num() - 1; i >= 0; --i)
 	{
 		LinesToDraw[i].TimeRemaining -= InDeltaTime;
@@ -247,7 +278,7 @@ void SBlueprintAssistGraphOverlay::DrawWidgetAsBox(
 	const FSlateRect& WidgetBounds,
 	const FLinearColor& Color) const
 {
-	if (!GraphPanel->IsRectVisible(WidgetBounds.GetBottomRight(), WidgetBounds.GetTopLeft()))
+	if (!IsGraphRectVisible(WidgetBounds))
 	{
 		return;
 	}
@@ -273,16 +304,16 @@ void SBlueprintAssistGraphOverlay::DrawBoundsAsLines(
 	const FLinearColor& Color,
 	float LineWidth) const
 {
+	if (!IsGraphRectVisible(Bounds))
+	{
+		return;
+	}
+
 	const FVector2D TL = FBAUtils::GraphCoordToPanelCoord(GraphPanel, Bounds.GetTopLeft());
 	const FVector2D TR = FBAUtils::GraphCoordToPanelCoord(GraphPanel, Bounds.GetTopRight());
 	const FVector2D BL = FBAUtils::GraphCoordToPanelCoord(GraphPanel, Bounds.GetBottomLeft());
 	const FVector2D BR = FBAUtils::GraphCoordToPanelCoord(GraphPanel, Bounds.GetBottomRight());
 
-	if (!GraphPanel->IsRectVisible(Bounds.GetBottomRight(), Bounds.GetTopLeft()))
-	{
-		return;
-	}
-
 	TArray<FVector2D> LinePoints = { TL, TR, BR, BL, TL };
 
 	FSlateDrawElement::MakeLines(
@@ -308,7 +339,7 @@ void SBlueprintAssistGraphOverlay::DrawIconOnNode(
 	const FSlateRect NodeBounds = FBAUtils::GetNodeBounds(GraphNode);
 	const FSlateRect ImageBounds = FSlateRect::FromPointAndExtent(NodeBounds.GetBottomLeft(), IconSize);
 
-	if (GraphPanel->IsRectVisible(ImageBounds.GetBottomRight(), ImageBounds.GetTopLeft()))
+	if (IsGraphRectVisible(ImageBounds))
 	{
 		FVector2D Offset = IconSize * -0.5f + NodeBounds.GetSize() * IconOffset;
 
@@ -338,26 +369,41 @@ void SBlueprintAssistGraphOverlay::DrawNodeGroups(
 	TSharedPtr<FBAGraphHandler> CurrentGraphHandler = FBAUtils::GetCurrentGraphHandler();
 	const UBASettings_EditorFeatures* BASettings_Features = GetDefault<UBASettings_EditorFeatures>();
 
-	// draw fill for groups of the selected nodes
-	if (BASettings_Features->bDrawNodeGroupFill)
+	TSet<FGuid> SelectedNodeGroups;
+	for (UEdGraphNode* SelectedNode : CurrentGraphHandler->GetSelectedNodes())
 	{
-		TSet<FGuid> NodeGroups;
-		for (UEdGraphNode* EdGraphNode : CurrentGraphHandler->GetSelectedNodes())
+		const FBANodeData& NodeData = CurrentGraphHandler->GetNodeData(SelectedNode);
+		if (NodeData.NodeGroup.IsValid())
 		{
-			const FBANodeData& NodeData = CurrentGraphHandler->GetNodeData(EdGraphNode);
-			if (NodeData.NodeGroup.IsValid())
-			{
-				NodeGroups.Add(NodeData.NodeGroup);
-			}
+			SelectedNodeGroups.Add(NodeData.NodeGroup);
 		}
+	}
 
-		for (const FGuid& Group : NodeGroups)
+	// draw fill for groups of the selected nodes (uses the node widget geometry, which is not updated while collapsed)
+	if (BASettings_Features->bDrawNodeGroupFill && !bLevelOfDetailActive)
+	{
+		for (const FGuid& Group : SelectedNodeGroups)
 		{
-			for (UEdGraphNode* Node : CurrentGraphHandler->GetNodeGroup(Group))
+			if (const TSet<TWeakObjectPtr<UEdGraphNode>>* Nodes = CurrentGraphHandler->NodeGroups.Find(Group))
 			{
-				if (TSharedPtr<SGraphNode> GraphNode = CurrentGraphHandler->GetGraphNode(Node))
+				for (const TWeakObjectPtr<UEdGraphNode>& WeakNode : *Nodes)
 				{
-					DrawWidgetAsBox(OutDrawElements, OutgoingLayer, GraphPanel, GraphNode, FBAUtils::GetNodeBounds(GraphNode), BASettings_Features->NodeGroupFillColor);
+					UEdGraphNode* Node = WeakNode.Get();
+					if (!Node)
+					{
+						continue;
+					}
+
+					const FSlateRect NodeBounds = FBAUtils::GetNodeBounds(Node);
+					if (!IsGraphRectVisible(NodeBounds))
+					{
+						continue;
+					}
+
+					if (TSharedPtr<SGraphNode> GraphNode = CurrentGraphHandler->GetGraphNode(Node))
+					{
+						DrawWidgetAsBox(OutDrawElements, OutgoingLayer, GraphPanel, GraphNode, NodeBounds, BASettings_Features->NodeGroupFillColor);
+					}
 				}
 			}
 		}
@@ -365,33 +411,354 @@ void SBlueprintAssistGraphOverlay::DrawNodeGroups(
 
 	if (BASettings_Features->bDrawNodeGroupOutline)
 	{
-		TSet<FGuid> NodeGroups;
-		if (BASettings_Features->bOnlyDrawGroupOutlineWhenSelected)
+		const TMap<FGuid, TSet<TWeakObjectPtr<UEdGraphNode>>>& NodeGroups = CurrentGraphHandler->NodeGroups;
+
+		// remove the bounds of groups which no longer exist
+		if (NodeGroupBoundsCache.Num() > NodeGroups.Num())
 		{
-			for (UEdGraphNode* SelectedNode : CurrentGraphHandler->GetSelectedNodes())
+			for (auto It = NodeGroupBoundsCache.CreateIterator(); It; ++It)
 			{
-				const FBANodeData& NodeData = CurrentGraphHandler->GetNodeData(SelectedNode);
-				if (NodeData.NodeGroup.IsValid())
+				if (!NodeGroups.Contains(It.Key()))
 				{
-					NodeGroups.Add(NodeData.NodeGroup);
+					It.RemoveCurrent();
 				}
 			}
 		}
-		else
+
+		const FMargin& Margin = BASettings_Features->NodeGroupOutlineMargin;
+
+		for (const auto& Elem : NodeGroups)
 		{
-			CurrentGraphHandler->NodeGroups.GetKeys(NodeGroups);
+			if (BASettings_Features->bOnlyDrawGroupOutlineWhenSelected && !SelectedNodeGroups.Contains(Elem.Key))
+			{
+				continue;
+			}
+
+			// the bounds are only recalculated after a member node moves or changes size
+			FSlateRect* GroupBounds = NodeGroupBoundsCache.Find(Elem.Key);
+			if (!GroupBounds)
+			{
+				GroupBounds = &NodeGroupBoundsCache.Add(Elem.Key, CalculateNodeGroupBounds(Elem.Value));
+			}
+
+			if (GroupBounds->IsValid() && IsGraphRectVisible(GroupBounds->ExtendBy(Margin)))
+			{
+				DrawBoundsAsLines(OutDrawElements, AllottedGeometry, OutgoingLayer, GraphPanel, GroupBounds->ExtendBy(Margin), BASettings_Features->NodeGroupOutlineColor, BASettings_Features->NodeGroupOutlineWidth);
+			}
 		}
+	}
+}
 
-		for (const FGuid& NodeGroup : NodeGroups)
+void SBlueprintAssistGraphOverlay::ExitLevelOfDetail()
+{
+	if (!bLevelOfDetailActive)
+	{
+		return;
+	}
+
+	for (const FBAGraphOverlayLODHiddenWidget& HiddenWidget : LODHiddenNodeWidgets)
+	{
+		if (TSharedPtr<SWidget> Widget = HiddenWidget.Widget.Pin())
 		{
-			TSet<UEdGraphNode*> Nodes = CurrentGraphHandler->GetNodeGroup(NodeGroup);
-			if (Nodes.Num() > 0)
+			// something else changed the visibility while collapsed, keep their value
+			if (Widget->GetVisibility() == EVisibility::Collapsed)
 			{
-				FSlateRect AllBounds = FBAUtils::GetNodeArrayBounds(Nodes.Array()).ExtendBy(BASettings_Features->NodeGroupOutlineMargin);
-				DrawBoundsAsLines(OutDrawElements, AllottedGeometry, OutgoingLayer, GraphPanel, AllBounds, BASettings_Features->NodeGroupOutlineColor, BASettings_Features->NodeGroupOutlineWidth);
+				Widget->SetVisibility(HiddenWidget.Visibility);
 			}
 		}
 	}
+
+	bLevelOfDetailActive = false;
+	bLowestLevelOfDetail = false;
+	LODHiddenNodeWidgets.Empty();
+	LODNodeEntries.Empty();
+	LODCommentEntries.Empty();
+	LODNumPanelChildren = INDEX_NONE;
+	LODNumGraphNodes = INDEX_NONE;
+}
+
+void SBlueprintAssistGraphOverlay::InvalidateNodeBounds(UEdGraphNode* Node)
+{
+	bLODBoundsDirty = true;
+
+	if (!OwnerGraphHandler || NodeGroupBoundsCache.Num() == 0)
+	{
+		return;
+	}
+
+	InvalidateNodeGroupBounds(OwnerGraphHandler->GetNodeData(Node).NodeGroup);
+}
+
+void SBlueprintAssistGraphOverlay::InvalidateNodeGroupBounds(const FGuid& NodeGroup)
+{
+	if (NodeGroup.IsValid())
+	{
+		NodeGroupBoundsCache.Remove(NodeGroup);
+	}
+}
+
+void SBlueprintAssistGraphOverlay::InvalidateAllNodeBounds()
+{
+	NodeGroupBoundsCache.Reset();
+	bLODBoundsDirty = true;
+}
+
+void SBlueprintAssistGraphOverlay::UpdateLevelOfDetail()
+{
+	const UBASettings_EditorFeatures& Settings = UBASettings_EditorFeatures::Get();
+
+	TSharedPtr<SGraphPanel> GraphPanel = OwnerGraphHandler ? OwnerGraphHandler->GetGraphPanel() : nullptr;
+	UEdGraph* Graph = OwnerGraphHandler ? OwnerGraphHandler->GetFocusedEdGraph() : nullptr;
+
+	// caching node sizes zooms the graph in, but also check the size progress in case the view is restored early
+	const float ZoomAmount = GraphPanel ? GraphPanel->GetZoomAmount() : 1.0f;
+	if (!Settings.bEnableLevelOfDetail || !GraphPanel || !Graph || SizeProgressWidget->bIsVisible || ZoomAmount >= Settings.LevelOfDetailZoomThreshold)
+	{
+		ExitLevelOfDetail();
+		return;
+	}
+
+	bLowestLevelOfDetail = ZoomAmount < Settings.LevelOfDetailZoomThreshold * 0.5f;
+
+	// also hide any node widgets created since entering level of detail
+	FChildren* Children = GraphPanel->GetChildren();
+	if (!bLevelOfDetailActive || (Children && Children->Num() != LODNumPanelChildren))
+	{
+		HideNodeWidgets(GraphPanel);
+	}
+
+	if (!bLevelOfDetailActive || Graph->Nodes.Num() != LODNumGraphNodes)
+	{
+		RebuildLevelOfDetail();
+	}
+	else if (bLODBoundsDirty)
+	{
+		RefreshLevelOfDetailBounds();
+	}
+
+	bLevelOfDetailActive = true;
+}
+
+void SBlueprintAssistGraphOverlay::HideNodeWidgets(TSharedPtr<SGraphPanel> GraphPanel)
+{
+	FChildren* Children = GraphPanel->GetChildren();
+	if (!Children)
+	{
+		return;
+	}
+
+	for (int i = 0; i < Children->Num(); ++i)
+	{
+		TSharedRef<SWidget> Child = Children->GetChildAt(i);
+
+		// only hide widgets which are visible and save their visibility, so we restore exactly what we changed
+		const EVisibility Visibility = Child->GetVisibility();
+		if (Visibility.IsVisible())
+		{
+			LODHiddenNodeWidgets.Add({ Child, Visibility });
+			Child->SetVisibility(EVisibility::Collapsed);
+		}
+	}
+
+	LODNumPanelChildren = Children->Num();
+}
+
+void SBlueprintAssistGraphOverlay::RebuildLevelOfDetail()
+{
+	LODNodeEntries.Reset();
+	LODCommentEntries.Reset();
+
+	UEdGraph* Graph = OwnerGraphHandler->GetFocusedEdGraph();
+	LODNumGraphNodes = Graph->Nodes.Num();
+
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (!Node)
+		{
+			continue;
+		}
+
+		FBAGraphOverlayLODEntry Entry;
+		Entry.Node = Node;
+
+		if (UEdGraphNode_Comment* Comment = Cast<UEdGraphNode_Comment>(Node))
+		{
+			Entry.Color = Comment->CommentColor;
+			LODCommentEntries.Add(Entry);
+		}
+		else
+		{
+			Entry.Color = Node->GetNodeTitleColor();
+			LODNodeEntries.Add(Entry);
+		}
+	}
+
+	RefreshLevelOfDetailBounds();
+}
+
+void SBlueprintAssistGraphOverlay::RefreshLevelOfDetailBounds()
+{
+	bLODBoundsDirty = false;
+
+	TSet<UEdGraphNode*> NodesInsideComments;
+
+	for (FBAGraphOverlayLODEntry& Entry : LODCommentEntries)
+	{
+		if (UEdGraphNode_Comment* Comment = Cast<UEdGraphNode_Comment>(Entry.Node.Get()))
+		{
+			// the cached bounds of a comment only covers the title bar, so use the comment size
+			Entry.Bounds = FSlateRect::FromPointAndExtent(FVector2D(Comment->NodePosX, Comment->NodePosY), FVector2D(Comment->NodeWidth, Comment->NodeHeight));
+			NodesInsideComments.Append(FBAUtils::GetNodesUnderComment(Comment));
+		}
+	}
+
+	for (FBAGraphOverlayLODEntry& Entry : LODNodeEntries)
+	{
+		if (UEdGraphNode* Node = Entry.Node.Get())
+		{
+			Entry.Bounds = OwnerGraphHandler->GetCachedNodeBounds(Node, false);
+			Entry.bInsideComment = NodesInsideComments.Contains(Node);
+		}
+	}
+}
+
+void SBlueprintAssistGraphOverlay::DrawLevelOfDetail(
+	FSlateWindowElementList& OutDrawElements,
+	const FGeometry& AllottedGeometry,
+	const int32 OutgoingLayer,
+	TSharedPtr<SGraphPanel> GraphPanel) const
+{
+	const FSlateBrush* WhiteBrush = BA_STYLE_CLASS::Get().GetBrush("WhiteBrush");
+	const float ZoomAmount = GraphPanel->GetZoomAmount();
+	const float NodeOpacity = UBASettings_EditorFeatures::Get().LevelOfDetailNodeOpacity;
+
+	const auto DrawEntry = [&](const FBAGraphOverlayLODEntry& Entry, const float Opacity)
+	{
+		if (!Entry.Node.IsValid() || !IsGraphRectVisible(Entry.Bounds))
+		{
+			return;
+		}
+
+		const FVector2D Offset = FBAUtils::GraphCoordToPanelCoord(GraphPanel, Entry.Bounds.GetTopLeft());
+		const FVector2D Size = Entry.Bounds.GetSize() * ZoomAmount;
+
+#if BA_UE_VERSION_OR_LATER(5, 2)
+		const FPaintGeometry PaintGeometry = AllottedGeometry.ToPaintGeometry(Size, FSlateLayoutTransform(Offset));
+#else
+		const FPaintGeometry PaintGeometry = AllottedGeometry.ToPaintGeometry(Offset, Size);
+#endif
+
+		FSlateDrawElement::MakeBox(
+			OutDrawElements,
+			OutgoingLayer,
+			PaintGeometry,
+			WhiteBrush,
+			ESlateDrawEffect::None,
+			Entry.Color.CopyWithNewOpacity(Opacity)
+		);
+	};
+
+	// at the lowest level of detail the comments are drawn opaque, as they stand in for the nodes inside them
+	const float CommentOpacity = bLowestLevelOfDetail ? NodeOpacity : NodeOpacity * 0.4f;
+	for (const FBAGraphOverlayLODEntry& Entry : LODCommentEntries)
+	{
+		DrawEntry(Entry, CommentOpacity);
+	}
+
+	for (const FBAGraphOverlayLODEntry& Entry : LODNodeEntries)
+	{
+		if (bLowestLevelOfDetail && Entry.bInsideComment)
+		{
+			continue;
+		}
+
+		DrawEntry(Entry, NodeOpacity);
+	}
+}
+
+FSlateRect SBlueprintAssistGraphOverlay::CalculateVisibleGraphBounds(const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, TSharedPtr<SGraphPanel> GraphPanel)
+{
+	return FSlateRect(
+		FBAUtils::PanelCoordToGraphCoord(GraphPanel, AllottedGeometry.AbsoluteToLocal(MyCullingRect.GetTopLeft())),
+		FBAUtils::PanelCoordToGraphCoord(GraphPanel, AllottedGeometry.AbsoluteToLocal(MyCullingRect.GetBottomRight())));
+}
+
+bool SBlueprintAssistGraphOverlay::IsGraphRectVisible(const FSlateRect& GraphBounds) const
+{
+	return FSlateRect::DoRectanglesIntersect(GraphBounds, VisibleGraphBounds);
+}
+
+FSlateRect SBlueprintAssistGraphOverlay::CalculateNodeGroupBounds(const TSet<TWeakObjectPtr<UEdGraphNode>>& Nodes) const
+{
+	TOptional<FSlateRect> Bounds;
+	for (const TWeakObjectPtr<UEdGraphNode>& WeakNode : Nodes)
+	{
+		if (UEdGraphNode* Node = WeakNode.Get())
+		{
+			const FSlateRect NodeBounds = FBAUtils::GetNodeBounds(Node);
+			Bounds = Bounds.IsSet() ? Bounds.GetValue().Expand(NodeBounds) : NodeBounds;
+		}
+	}
+
+	return Bounds.Get(FSlateRect());
+}
+
+void SBlueprintAssistGraphOverlay::DrawLineBatch(
+	FSlateWindowElementList& OutDrawElements,
+	const FGeometry& AllottedGeometry,
+	const int32 OutgoingLayer,
+	TSharedPtr<SGraphPanel> GraphPanel) const
+{
+	TArray<FVector2D> LinePoints;
+	FLinearColor BatchColor;
+	FVector2D BatchEnd;
+
+	const auto FlushBatch = [&]()
+	{
+		if (LinePoints.Num() >= 2)
+		{
+			FSlateDrawElement::MakeLines(
+				OutDrawElements,
+				OutgoingLayer,
+				AllottedGeometry.ToPaintGeometry(),
+				LinePoints,
+				ESlateDrawEffect::None,
+				BatchColor,
+				true,
+				5.0f);
+		}
+
+		LinePoints.Reset();
+	};
+
+	for (const FBAGraphOverlayLineParams& ToDraw : LinesToDraw)
+	{
+		const FSlateRect LineBounds(
+			FMath::Min(ToDraw.Start.X, ToDraw.End.X),
+			FMath::Min(ToDraw.Start.Y, ToDraw.End.Y),
+			FMath::Max(ToDraw.Start.X, ToDraw.End.X),
+			FMath::Max(ToDraw.Start.Y, ToDraw.End.Y));
+
+		if (!IsGraphRectVisible(LineBounds))
+		{
+			FlushBatch();
+			continue;
+		}
+
+		// continue the current polyline if this line starts where the last one ended
+		const bool bContinuesBatch = LinePoints.Num() > 0 && ToDraw.Color == BatchColor && ToDraw.Start == BatchEnd;
+		if (!bContinuesBatch)
+		{
+			FlushBatch();
+			BatchColor = ToDraw.Color;
+			LinePoints.Add(FBAUtils::GraphCoordToPanelCoord(GraphPanel, ToDraw.Start));
+		}
+
+		LinePoints.Add(FBAUtils::GraphCoordToPanelCoord(GraphPanel, ToDraw.End));
+		BatchEnd = ToDraw.End;
+	}
+
+	FlushBatch();
 }
 
 void SBlueprintAssistGraphOverlay::DrawTextOverWidget(
@@ -404,7 +771,7 @@ void SBlueprintAssistGraphOverlay::DrawTextOverWidget(
 	FSlateFontInfo Font,
 	const FLinearColor& Color) const
 {
-	if (!GraphPanel->IsRectVisible(WidgetBounds.GetBottomRight(), WidgetBounds.GetTopLeft()))
+	if (!IsGraphRectVisible(WidgetBounds))
 	{
 		return;
 	}
@@ -2,11 +2,9 @@
 
 #include "BlueprintAssistWidgets/BlueprintAssistOpenFileMenu.h"
 
+#include "BlueprintAssistAssetIndex.h"
 #include "Editor.h"
 #include "SlateOptMacros.h"
-#include "AssetRegistry/IAssetRegistry.h"
-#include "Modules/ModuleManager.h"
-#include "Stats/StatsMisc.h"
 #include "Subsystems/AssetEditorSubsystem.h"
 
 BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
@@ -16,7 +14,8 @@ void SBAOpenFileMenu::Construct(const FArguments& InArgs)
 	ChildSlot
 	[
 		SNew(SBAFilteredList<TSharedPtr<FBAFileItem>>)
-		.InitListItems(this, &SBAOpenFileMenu::InitListItems)
+		.ItemsSource(FBAAssetIndex::Get().GetItems())
+		.SearchIndex(FBAAssetIndex::Get().GetSearchIndex())
 		.OnGenerateRow(this, &SBAOpenFileMenu::CreateItemWidget)
 		.OnSelectItem(this, &SBAOpenFileMenu::SelectItem)
 		.WidgetSize(GetWidgetSize())
@@ -26,28 +25,6 @@ void SBAOpenFileMenu::Construct(const FArguments& InArgs)
 
 END_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
-void SBAOpenFileMenu::InitListItems(TArray<TSharedPtr<FBAFileItem>>& Items)
-{
-	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
-
-	TArray<FAssetData> OutAssetData;
-
-	double ThisTime = 0;
-	{
-		SCOPE_SECONDS_COUNTER(ThisTime);
-		AssetRegistry.GetAllAssets(OutAssetData, false);
-	}
-	UE_LOG(LogTemp, Warning, TEXT("Get all assets took %.2f"), ThisTime);
-
-	for (FAssetData& AssetData : OutAssetData)
-	{
-		if (!AssetData.IsRedirector() && AssetData.IsUAsset())
-		{
-			Items.Add(MakeShared<FBAFileItem>(AssetData.AssetName.ToString()));
-		}
-	}
-}
-
 TSharedRef<ITableRow> SBAOpenFileMenu::CreateItemWidget(TSharedPtr<FBAFileItem> Item, const TSharedRef<STableViewBase>& OwnerTable) const
 {
 	const FText ItemText = FText::FromString(Item->FilePath);
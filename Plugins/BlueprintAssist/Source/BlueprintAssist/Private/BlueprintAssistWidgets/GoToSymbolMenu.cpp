@@ -2,15 +2,20 @@
 
 #include "BlueprintAssistWidgets/GoToSymbolMenu.h"
 
+#include "BlueprintAssistCache.h"
 #include "BlueprintAssistGraphHandler.h"
+#include "BlueprintAssistSymbolIndex.h"
 #include "BlueprintAssistUtils.h"
 #include "BlueprintEditor.h"
+#include "Editor.h"
 #include "K2Node_CustomEvent.h"
 #include "K2Node_Event.h"
+#include "SMyBlueprint.h"
 #include "BlueprintAssistMisc/BAMiscUtils.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
 #include "Kismet2/KismetEditorUtilities.h"
+#include "Subsystems/AssetEditorSubsystem.h"
 #include "Widgets/Images/SImage.h"
 #include "Widgets/Input/SSearchBox.h"
 #include "Widgets/Views/STableRow.h"
@@ -82,6 +87,9 @@ void SGoToSymbolMenu::InitListItems(TArray<TSharedPtr<FGoToSymbolStruct>>& Items
 		// add the graph itself
 		Items.Add(MakeShareable(new FGoToSymbolStruct(nullptr, Graph)));
 	}
+
+	// symbols of the other blueprints come from the index, our own symbols are listed above
+	FBASymbolIndex::Get().GetItems(Blueprint->GetOutermost()->GetFName(), Items);
 }
 
 TSharedRef<ITableRow> SGoToSymbolMenu::CreateItemWidget(TSharedPtr<FGoToSymbolStruct> Item, const TSharedRef<STableViewBase>& OwnerTable) const
@@ -89,15 +97,23 @@ TSharedRef<ITableRow> SGoToSymbolMenu::CreateItemWidget(TSharedPtr<FGoToSymbolSt
 	FLinearColor IconColor = FLinearColor::White;
 
 	const FSlateBrush* ContextIcon
-		= Item->EventNode != nullptr
+		= Item->IsIndexedSymbol()
+		? GetIndexedSymbolIcon(*Item->IndexedSymbol)
+		: Item->EventNode != nullptr
 		? Item->EventNode->GetIconAndTint(IconColor).GetIcon()
 		: FBlueprintEditor::GetGlyphForGraph(Item->Graph);
 
 	FString ItemDetails = Item->GetTypeDescription();
-	if (Item->EventNode)
+	if (Item->EventNode || (Item->IsIndexedSymbol() && Item->IndexedSymbol->Type == EBASymbolType::Event))
+	{
+		ItemDetails += " | ";
+		ItemDetails += Item->GetGraphName();
+	}
+
+	if (Item->IsIndexedSymbol())
 	{
 		ItemDetails += " | ";
-		ItemDetails += FBAUtils::GetGraphName(Item->Graph);
+		ItemDetails += Item->BlueprintPath.GetAssetName();
 	}
 
 	return
@@ -129,6 +145,12 @@ TSharedRef<ITableRow> SGoToSymbolMenu::CreateItemWidget(TSharedPtr<FGoToSymbolSt
 
 void SGoToSymbolMenu::SelectItem(TSharedPtr<FGoToSymbolStruct> Item)
 {
+	if (Item->IsIndexedSymbol())
+	{
+		SelectIndexedItem(Item);
+		return;
+	}
+
 	const EGraphType GraphType = FBAUtils::GetGraphType(Item->Graph);
 
 	if (GraphType == GT_Ubergraph)
@@ -153,11 +175,108 @@ void SGoToSymbolMenu::SelectItem(TSharedPtr<FGoToSymbolStruct> Item)
 	FKismetEditorUtilities::BringKismetToFocusAttentionOnObject(Item->Graph, false);
 }
 
+void SGoToSymbolMenu::SelectIndexedItem(TSharedPtr<FGoToSymbolStruct> Item)
+{
+	UBlueprint* Blueprint = Cast<UBlueprint>(Item->BlueprintPath.TryLoad());
+	if (!Blueprint)
+	{
+		UE_LOG(LogBlueprintAssist, Warning, TEXT("Failed to load blueprint %s for symbol %s"), *Item->BlueprintPath.ToString(), *Item->ToString());
+		FBASymbolIndex::Get().RemovePackage(FName(*Item->BlueprintPath.GetLongPackageName()));
+		return;
+	}
+
+	// the cached symbols may be out of date if the blueprint changed outside the editor
+	FBASymbolIndex::Get().UpdateBlueprint(Blueprint);
+
+	const FBASymbolData& Symbol = *Item->IndexedSymbol;
+
+	if (Symbol.Type == EBASymbolType::Variable)
+	{
+		FKismetEditorUtilities::BringKismetToFocusAttentionOnObject(Blueprint, false);
+
+		if (UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>())
+		{
+			if (IAssetEditorInstance* AssetEditor = AssetEditorSubsystem->FindEditorForAsset(Blueprint, false))
+			{
+				FAssetEditorToolkit* AssetEditorToolkit = static_cast<FAssetEditorToolkit*>(AssetEditor);
+				if (AssetEditorToolkit->IsBlueprintEditor())
+				{
+					FBlueprintEditor* BlueprintEditor = static_cast<FBlueprintEditor*>(AssetEditorToolkit);
+					if (TSharedPtr<SMyBlueprint> MyBlueprint = BlueprintEditor->GetMyBlueprintWidget())
+					{
+						MyBlueprint->SelectItemByName(FName(*Symbol.Name), ESelectInfo::OnKeyPress);
+					}
+				}
+			}
+		}
+
+		return;
+	}
+
+	TArray<UEdGraph*> BlueprintGraphs;
+	Blueprint->GetAllGraphs(BlueprintGraphs);
+
+	UEdGraph** FoundGraph = BlueprintGraphs.FindByPredicate([&Symbol](UEdGraph* Graph)
+	{
+		return Graph && Graph->GetFName() == Symbol.GraphName;
+	});
+
+	if (!FoundGraph)
+	{
+		FKismetEditorUtilities::BringKismetToFocusAttentionOnObject(Blueprint, false);
+		return;
+	}
+
+	if (Symbol.Type == EBASymbolType::Event)
+	{
+		UEdGraphNode** FoundNode = (*FoundGraph)->Nodes.FindByPredicate([&Symbol](UEdGraphNode* Node)
+		{
+			return Node && Node->NodeGuid == Symbol.Guid;
+		});
+
+		if (FoundNode)
+		{
+			FKismetEditorUtilities::BringKismetToFocusAttentionOnObject(*FoundNode, false);
+			return;
+		}
+	}
+
+	FKismetEditorUtilities::BringKismetToFocusAttentionOnObject(*FoundGraph, false);
+}
+
+const FSlateBrush* SGoToSymbolMenu::GetIndexedSymbolIcon(const FBASymbolData& Symbol)
+{
+	switch (Symbol.Type)
+	{
+		case EBASymbolType::Event:
+			return BA_STYLE_CLASS::Get().GetBrush("GraphEditor.Event_16x");
+		case EBASymbolType::Variable:
+			return BA_STYLE_CLASS::Get().GetBrush("Kismet.AllClasses.VariableIcon");
+		default:
+			break;
+	}
+
+	switch (Symbol.GraphType)
+	{
+		case GT_Function:
+			return BA_STYLE_CLASS::Get().GetBrush("GraphEditor.Function_16x");
+		case GT_Macro:
+			return BA_STYLE_CLASS::Get().GetBrush("GraphEditor.Macro_16x");
+		default:
+			return BA_STYLE_CLASS::Get().GetBrush("GraphEditor.EventGraph_16x");
+	}
+}
+
 /*****************/
 /* FSymbolStruct */
 /*****************/
 FString FGoToSymbolStruct::ToString() const
 {
+	if (IndexedSymbol)
+	{
+		return IndexedSymbol->Name;
+	}
+
 	if (EventNode)
 	{
 		return FBAUtils::GetNodeName(EventNode);
@@ -168,6 +287,17 @@ FString FGoToSymbolStruct::ToString() const
 
 FString FGoToSymbolStruct::GetSearchText() const
 {
+	if (IndexedSymbol)
+	{
+		FString SearchText = GetTypeDescription() + IndexedSymbol->Name + BlueprintPath.GetAssetName();
+		if (IndexedSymbol->Type == EBASymbolType::Event)
+		{
+			SearchText += IndexedSymbol->GraphName.ToString();
+		}
+
+		return SearchText;
+	}
+
 	FString SearchText = FBAUtils::GetGraphName(Graph) + GetTypeDescription();
 	if (EventNode)
 	{
@@ -179,7 +309,25 @@ FString FGoToSymbolStruct::GetSearchText() const
 
 FString FGoToSymbolStruct::GetTypeDescription() const
 {
+	if (IndexedSymbol)
+	{
+		switch (IndexedSymbol->Type)
+		{
+			case EBASymbolType::Event:
+				return FString("Event");
+			case EBASymbolType::Variable:
+				return FString("Variable");
+			default:
+				return FBAUtils::GraphTypeToString(IndexedSymbol->GraphType);
+		}
+	}
+
 	return EventNode != nullptr
 		? FString("Event")
 		: FBAUtils::GraphTypeToString(FBAUtils::GetGraphType(Graph));
 }
+
+FString FGoToSymbolStruct::GetGraphName() const
+{
+	return IndexedSymbol ? IndexedSymbol->GraphName.ToString() : FBAUtils::GetGraphName(Graph);
+}
@@ -7,6 +7,7 @@
 #include "BlueprintAssistGraphHandler.h"
 #include "BlueprintAssistInputProcessor.h"
 #include "BlueprintAssistModule.h"
+#include "BlueprintAssistOpenWindowIndex.h"
 #include "BlueprintAssistUtils.h"
 #include "BlueprintEditor.h"
 #include "BlueprintEditorTabs.h"
@@ -85,12 +86,12 @@ FString FOpenTabItem::ToString() const
 
 void FOpenTabItem::SelectItem()
 {
-	if (AlternateTabManager.IsValid())
+	if (TSharedPtr<FTabManager> TabManager = AlternateTabManager.Pin())
 	{
 #if ENGINE_MINOR_VERSION >= 26 || ENGINE_MAJOR_VERSION >= 5
-		AlternateTabManager->TryInvokeTab(TabName);
+		TabManager->TryInvokeTab(TabName);
 #else
-		AlternateTabManager->InvokeTab(TabInfo.TabName);
+		TabManager->InvokeTab(TabInfo.TabName);
 #endif
 	}
 	else
@@ -151,12 +152,14 @@ const FSlateBrush* FOpenSettingItem::GetIcon()
 {
 	if (ContainerName == "Project")
 	{
-		return BA_STYLE_CLASS::Get().GetBrush("ProjectSettings.TabIcon");
+		static const FSlateBrush* ProjectSettingsIcon = BA_STYLE_CLASS::Get().GetBrush("ProjectSettings.TabIcon");
+		return ProjectSettingsIcon;
 	}
 
 	if (ContainerName == "Editor")
 	{
-		return BA_STYLE_CLASS::Get().GetBrush("EditorPreferences.TabIcon");
+		static const FSlateBrush* EditorPreferencesIcon = BA_STYLE_CLASS::Get().GetBrush("EditorPreferences.TabIcon");
+		return EditorPreferencesIcon;
 	}
 
 	return nullptr;
@@ -305,11 +308,10 @@ void SOpenWindowMenu::Construct(const FArguments& InArgs)
 
 void SOpenWindowMenu::InitListItems(TArray<TSharedPtr<FOpenWindowItem_Base>>& Items)
 {
-	AddOpenTabItems(Items);
-	AddOpenSettingsItems(Items);
+	Items.Append(FBAOpenWindowIndex::Get().GetItems());
+	AddEditorTabItems(Items);
 	AddCommandItems(Items);
 	AddActionItems(Items);
-	AddEditorUtilityWidgets(Items);
 
 	// TODO: this nearly works need to figure out how to actually run the action though...
 	// AddToolItems(Items);
@@ -324,8 +326,9 @@ void SOpenWindowMenu::AddOpenTabItems(TArray<TSharedPtr<FOpenWindowItem_Base>>&
 {
 	TArray<FOpenTabItem> TabInfos;
 
-	FLevelEditorModule& LevelEditorModule = FModuleManager::GetModuleChecked<FLevelEditorModule>("LevelEditor");
-	TSharedPtr<FTabManager> LevelEditorTabManager = LevelEditorModule.GetLevelEditorTabManager();
+	// the level editor tabs are skipped below if the level editor has not been created yet
+	FLevelEditorModule* LevelEditorModule = FModuleManager::GetModulePtr<FLevelEditorModule>("LevelEditor");
+	TSharedPtr<FTabManager> LevelEditorTabManager = LevelEditorModule ? LevelEditorModule->GetLevelEditorTabManager() : nullptr;
 
 	// Category General
 	TabInfos.Add(FOpenTabItem("GameplayCueApp", "Profiler.EventGraph.ExpandHotPath16", "GameplayCue Editor"));
@@ -473,6 +476,13 @@ void SOpenWindowMenu::AddOpenTabItems(TArray<TSharedPtr<FOpenWindowItem_Base>>&
 	// TabInfos.Add(FOpenTabItem("MessageLog", FSlateIcon("InsightsStyle", "MessageLog.Icon.Small"), "Message Log"));
 	TabInfos.Add(FOpenTabItem("AutomationWindow", FSlateIcon("InsightsStyle", "AutomationWindow.Icon.Small"), "Automation"));
 
+	AddValidTabItems(TabInfos, Items);
+}
+
+void SOpenWindowMenu::AddEditorTabItems(TArray<TSharedPtr<FOpenWindowItem_Base>>& Items)
+{
+	TArray<FOpenTabItem> TabInfos;
+
 	// Add editor specific tabs
 	if (IAssetEditorInstance* Editor = FBAUtils::GetEditorFromActiveTab())
 	{
@@ -545,12 +555,17 @@ void SOpenWindowMenu::AddOpenTabItems(TArray<TSharedPtr<FOpenWindowItem_Base>>&
 		}
 	}
 
+	AddValidTabItems(TabInfos, Items);
+}
+
+void SOpenWindowMenu::AddValidTabItems(const TArray<FOpenTabItem>& TabInfos, TArray<TSharedPtr<FOpenWindowItem_Base>>& Items)
+{
 	// Skip items which are invalid
 	for (const FOpenTabItem& Item : TabInfos)
 	{
-		if (Item.AlternateTabManager.IsValid())
+		if (TSharedPtr<FTabManager> AlternateTabManager = Item.AlternateTabManager.Pin())
 		{
-			if (!Item.AlternateTabManager->HasTabSpawner(Item.TabName))
+			if (!AlternateTabManager->HasTabSpawner(Item.TabName))
 			{
 				if (UBASettings::HasDebugSetting("OpenWindowMenu"))
 				{
@@ -102,7 +102,8 @@ void SBASizeProgress::ShowOverlay()
 	RenderGraphToBrush();
 	SetVisibility(EVisibility::HitTestInvisible);
 
-	if (OwnerGraphHandler->GetNumberOfPendingNodesToCache() > UBASettings::Get().RequiredNodesToShowOverlayProgressBar)
+	const FBAPendingWorkProgress Progress = OwnerGraphHandler->GetPendingWorkProgress();
+	if (Progress.NumPendingSize + Progress.NumPendingFormatting > UBASettings::Get().RequiredNodesToShowOverlayProgressBar)
 	{
 		ProgressCenterPanel->SetVisibility(EVisibility::Visible);
 	}
@@ -161,10 +162,16 @@ void SBASizeProgress::DrawWidgetToRenderTarget(TSharedPtr<SWidget> Widget)
 
 FText SBASizeProgress::GetCacheProgressText() const
 {
-	return FText::FromString(FString::Printf(TEXT("Caching Node Sizes (%d)"), OwnerGraphHandler->GetNumberOfPendingNodesToCache()));
+	const FBAPendingWorkProgress Progress = OwnerGraphHandler->GetPendingWorkProgress();
+	if (Progress.NumPendingSize == 0 && Progress.NumPendingFormatting > 0)
+	{
+		return FText::FromString(FString::Printf(TEXT("Formatting Nodes (%d)"), Progress.NumPendingFormatting));
+	}
+
+	return FText::FromString(FString::Printf(TEXT("Caching Node Sizes (%d)"), Progress.NumPendingSize));
 }
 
 TOptional<float> SBASizeProgress::GetCachingPercent() const
 {
-	return OwnerGraphHandler->GetPendingNodeSizeProgress();
+	return OwnerGraphHandler->GetPendingWorkProgress().GetSizeProgress();
 }
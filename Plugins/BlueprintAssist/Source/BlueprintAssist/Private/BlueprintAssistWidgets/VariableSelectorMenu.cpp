@@ -2,12 +2,12 @@
 #include "BlueprintAssistWidgets/VariableSelectorMenu.h"
 
 #include "BlueprintAssistUtils.h"
+#include "BlueprintAssistVariableIndex.h"
 #include "BlueprintEditor.h"
 #include "BlueprintEditorSettings.h"
 #include "EdGraphSchema_K2_Actions.h"
 #include "EditorCategoryUtils.h"
 #include "GraphEditorSettings.h"
-#include "K2Node_FunctionEntry.h"
 #include "SKismetInspector.h"
 #include "BlueprintAssistMisc/BAMiscUtils.h"
 #include "Editor/GraphEditor/Public/SGraphActionMenu.h"
@@ -93,53 +93,17 @@ void SVariableSelectorMenu::InitListItems(TArray<TSharedPtr<FVariableSelectorStr
 	UEdGraph* FocusedEdGraph = BPEditor->GetFocusedGraph();
 	UBlueprint* BlueprintObj = BPEditor->GetBlueprintObj();
 
-	const EFieldIteratorFlags::SuperClassFlags FieldIteratorSuperFlag = GetDefault<UBlueprintEditorSettings>()->bShowInheritedVariables
-		? EFieldIteratorFlags::IncludeSuper
-		: EFieldIteratorFlags::ExcludeSuper;
-
-	for (TFieldIterator<BA_PROPERTY> PropertyIt(BlueprintObj->SkeletonGeneratedClass, FieldIteratorSuperFlag); PropertyIt; ++PropertyIt)
-	{
-		BA_PROPERTY* Property = *PropertyIt;
-
-		// Don't show delegate & components, there is special handling for these
-		if (ShouldSkipProperty(Property))
-		{
-			continue;
-		}
-
-		Items.Add(MakeShareable(new FVariableSelectorStruct(Property)));
-	}
-
-	// We want to pull local variables from the top level function graphs
-	UEdGraph* TopLevelGraph = FBlueprintEditorUtils::GetTopLevelGraph(FocusedEdGraph);
-	if (TopLevelGraph)
-	{
-		TArray<UK2Node_FunctionEntry*> FunctionEntryNodes;
-		TopLevelGraph->GetNodesOfClass<UK2Node_FunctionEntry>(FunctionEntryNodes);
-
-		// Search in all FunctionEntry nodes for their local variables
-		for (UK2Node_FunctionEntry* const FunctionEntry : FunctionEntryNodes)
-		{
-			for (const FBPVariableDescription& Variable : FunctionEntry->LocalVariables)
-			{
-				UFunction* Func = BA_FIND_FIELD<UFunction>(BlueprintObj->SkeletonGeneratedClass, TopLevelGraph->GetFName());
-				if (Func)
-				{
-					if (BA_PROPERTY* Property = BA_FIND_PROPERTY<BA_PROPERTY>(Func, Variable.VarName))
-					{
-						Items.Add(MakeShareable(new FVariableSelectorStruct(Property)));
-					}
-				}
-			}
-		}
-	}
+	const bool bIncludeInherited = GetDefault<UBlueprintEditorSettings>()->bShowInheritedVariables;
+	Items.Append(FBAVariableIndex::Get().GetMemberVariables(BlueprintObj, bIncludeInherited));
+	Items.Append(FBAVariableIndex::Get().GetLocalVariables(BlueprintObj, FocusedEdGraph));
 }
 
 TSharedRef<ITableRow> SVariableSelectorMenu::CreateItemWidget(TSharedPtr<FVariableSelectorStruct> Item, const TSharedRef<STableViewBase>& OwnerTable) const
 {
 	FSlateColor PrimaryColor;
 	FSlateColor SecondaryColor;
-	const FSlateBrush* PrimaryIcon = BA_STYLE_CLASS::Get().GetBrush(TEXT("Kismet.AllClasses.VariableIcon"));
+	static const FSlateBrush* VariableIcon = BA_STYLE_CLASS::Get().GetBrush(TEXT("Kismet.AllClasses.VariableIcon"));
+	const FSlateBrush* PrimaryIcon = VariableIcon;
 	const FSlateBrush* SecondaryIcon = nullptr;
 
 	if (Item->bSCSNode)
@@ -151,24 +115,21 @@ TSharedRef<ITableRow> SVariableSelectorMenu::CreateItemWidget(TSharedPtr<FVariab
 
 		PrimaryColor = GetDefault<UGraphEditorSettings>()->ObjectPinTypeColor;
 	}
-	else
+	else if (BA_PROPERTY* Property = Item->GetProperty())
 	{
 #if ENGINE_MINOR_VERSION >= 26 || ENGINE_MAJOR_VERSION >= 5
-		PrimaryIcon = FBlueprintEditor::GetVarIconAndColorFromProperty(Item->Property, PrimaryColor, SecondaryIcon, SecondaryColor);
+		PrimaryIcon = FBlueprintEditor::GetVarIconAndColorFromProperty(Property, PrimaryColor, SecondaryIcon, SecondaryColor);
 #else
-		if (Item->Property)
-		{
-			const UEdGraphSchema_K2* K2Schema = GetDefault<UEdGraphSchema_K2>();
+		const UEdGraphSchema_K2* K2Schema = GetDefault<UEdGraphSchema_K2>();
 
-			FEdGraphPinType PinType;
-			if (K2Schema->ConvertPropertyToPinType(Item->Property, PinType)) // use schema to get the color
-			{
-				PrimaryColor = K2Schema->GetPinTypeColor(PinType);
-				SecondaryColor = K2Schema->GetSecondaryPinTypeColor(PinType);
+		FEdGraphPinType PinType;
+		if (K2Schema->ConvertPropertyToPinType(Property, PinType)) // use schema to get the color
+		{
+			PrimaryColor = K2Schema->GetPinTypeColor(PinType);
+			SecondaryColor = K2Schema->GetSecondaryPinTypeColor(PinType);
 
-				PrimaryIcon = FBlueprintEditorUtils::GetIconFromPin(PinType);
-				SecondaryIcon = FBlueprintEditorUtils::GetSecondaryIconFromPin(PinType);
-			}
+			PrimaryIcon = FBlueprintEditorUtils::GetIconFromPin(PinType);
+			SecondaryIcon = FBlueprintEditorUtils::GetSecondaryIconFromPin(PinType);
 		}
 #endif
 	}
@@ -245,18 +206,18 @@ void SVariableSelectorMenu::SelectItem(TSharedPtr<FVariableSelectorStruct> Item)
 #endif
 		}
 	}
-	else
+	else if (BA_PROPERTY* Property = Item->GetProperty())
 	{
-		SKismetInspector::FShowDetailsOptions Options(FText::FromName(Item->Property->GetFName()));
+		SKismetInspector::FShowDetailsOptions Options(FText::FromName(Property->GetFName()));
 #if ENGINE_MINOR_VERSION >= 25 || ENGINE_MAJOR_VERSION >= 5
-		Inspector->ShowDetailsForSingleObject(Item->Property->GetUPropertyWrapper(), Options);
+		Inspector->ShowDetailsForSingleObject(Property->GetUPropertyWrapper(), Options);
 #else
-		Inspector->ShowDetailsForSingleObject(Item->Property, Options);
+		Inspector->ShowDetailsForSingleObject(Property, Options);
 #endif
 
 		if (ActionMenu.IsValid())
 		{
-			ActionMenu->SelectItemByName(Item->Property->GetFName(), ESelectInfo::OnKeyPress);
+			ActionMenu->SelectItemByName(Property->GetFName(), ESelectInfo::OnKeyPress);
 		}
 	}
 }
@@ -296,8 +257,15 @@ bool SVariableSelectorMenu::ShouldSkipProperty(BA_PROPERTY* Property)
 FVariableSelectorStruct::FVariableSelectorStruct(BA_PROPERTY* InProperty)
 {
 	bSCSNode = false;
-	Property = InProperty;
-	DisplayName = Property->GetName();
+	PropertyOwner = InProperty->GetOwnerStruct();
+	PropertyName = InProperty->GetFName();
+	DisplayName = InProperty->GetName();
+}
+
+BA_PROPERTY* FVariableSelectorStruct::GetProperty() const
+{
+	UStruct* Owner = PropertyOwner.Get();
+	return Owner ? BA_FIND_PROPERTY<BA_PROPERTY>(Owner, PropertyName) : nullptr;
 }
 
 FVariableSelectorStruct::FVariableSelectorStruct(TSharedPtr<BA_SUBOBJECT_EDITOR_TREE_NODE> InNode)
@@ -0,0 +1,93 @@
+// Copyright fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "BlueprintAssistGlobals.h"
+
+#if BA_UE_VERSION_OR_LATER(5, 1)
+
+#include "CoreMinimal.h"
+#include "EdGraph/EdGraphPin.h"
+#include "Modules/ModuleManager.h"
+
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+struct FBAActionMenuItem;
+
+/**
+ * Context the blueprint action menu (SBABlueprintActionMenu) was opened with.
+ * Actions depend on the blueprint, the graph type and the context pin, so menus opened with an equal context share their actions.
+ * The menu filters pin actions against the pin's owning node and its sibling pins, so the pin is keyed by identity as well as type.
+ */
+struct FBAActionMenuContext
+{
+	TWeakObjectPtr<UBlueprint> Blueprint;
+
+	/* Only set for graphs with their own local variables, event graphs of the same blueprint share their actions */
+	TWeakObjectPtr<UEdGraph> Graph;
+	int32 GraphType = 0;
+
+	bool bHasPin = false;
+	TWeakObjectPtr<UEdGraphNode> PinNode;
+	FGuid PinId;
+	FEdGraphPinType PinType;
+	TEnumAsByte<EEdGraphPinDirection> PinDirection = EGPD_Input;
+
+	bool bContextSensitive = true;
+
+	FBAActionMenuContext() = default;
+	FBAActionMenuContext(UEdGraph* InGraph, UEdGraphPin* InPin, bool bInContextSensitive);
+
+	bool operator==(const FBAActionMenuContext& Other) const;
+};
+
+/**
+ * Actions of the blueprint action menu for the most recently used contexts.
+ * Building the actions filters the whole blueprint action database, so repeat opens reuse the actions until a blueprint is
+ * compiled, a module is loaded or the action database changes.
+ */
+class BLUEPRINTASSIST_API FBAActionMenuCache
+{
+public:
+	using FItemArray = TArray<TSharedPtr<FBAActionMenuItem>>;
+
+	static FBAActionMenuCache& Get();
+	static void TearDown();
+
+	void Init();
+
+	void Cleanup();
+
+	/* Cached actions for the context, nullptr if they need to be built */
+	TSharedPtr<const FItemArray> FindItems(const FBAActionMenuContext& Context);
+
+	void AddItems(const FBAActionMenuContext& Context, TSharedRef<const FItemArray> Items);
+
+	void Invalidate();
+
+private:
+	struct FEntry
+	{
+		FBAActionMenuContext Context;
+		TSharedRef<const FItemArray> Items;
+	};
+
+	static constexpr int32 MaxEntries = 8;
+
+	/* Most recently used last */
+	TArray<FEntry> Entries;
+
+	/* The action database is bound on first use, getting it at startup would build the whole database */
+	bool bBoundActionDatabase = false;
+
+	void BindActionDatabase();
+
+	void OnBlueprintCompiled();
+
+	void OnModulesChanged(FName ModuleName, EModuleChangeReason Reason);
+
+	void OnActionDatabaseEntryChanged(UObject* ActionKey);
+};
+
+#endif
@@ -0,0 +1,93 @@
+// Copyright fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FBASearchIndex;
+struct FAssetData;
+struct FBAFileItem;
+struct FBAPendingAssetEvent;
+
+/**
+ * Index of the items listed by the open file menu (SBAOpenFileMenu).
+ * Built once on a background thread after the asset registry has finished loading, then kept up to date from the asset registry events.
+ * Opening the menu only takes a reference to the latest snapshot of the items.
+ */
+class BLUEPRINTASSIST_API FBAAssetIndex
+{
+public:
+	using FItemArray = TArray<TSharedPtr<FBAFileItem>>;
+
+	static FBAAssetIndex& Get();
+	static void TearDown();
+
+	void Init();
+
+	void Cleanup();
+
+	/* Snapshot of all items, builds the index on the game thread if the background build has not finished yet */
+	TSharedRef<const FItemArray> GetItems();
+
+	/* Search index of the items returned by GetItems, only rebuilt after the items change */
+	TSharedRef<FBASearchIndex> GetSearchIndex();
+
+	bool IsBuilt() const { return bBuilt; }
+
+	int32 Num() const { return ItemIndices.Num(); }
+
+private:
+	struct FBuiltItems
+	{
+		/* Object path to the index in ObjectPaths and Items */
+		TMap<FString, int32> Indices;
+		TArray<FString> ObjectPaths;
+		FItemArray Items;
+	};
+
+	TMap<FString, int32> ItemIndices;
+	TArray<FString> ItemObjectPaths;
+
+	/* Menus keep a reference to the items while open, so the array is only copied when changed while a menu still holds it */
+	TSharedPtr<FItemArray> Items;
+
+	/* Menus keep a reference to the search index while open, so a new index is made when the items change */
+	TSharedPtr<FBASearchIndex> SearchIndex;
+
+	bool bBuilt = false;
+	bool bBuildInProgress = false;
+
+	/* Background builds only apply their result if this is still valid and the generation matches */
+	TSharedPtr<int32> BuildToken;
+
+	/* Asset registry events received while the background build is running, replayed in the order they were received */
+	TArray<FBAPendingAssetEvent> PendingEvents;
+
+	void OnFilesLoaded();
+
+	void StartBackgroundBuild();
+
+	static void BuildInBackground(const TArray<FAssetData>& Assets, TWeakPtr<int32> WeakToken, int32 Generation);
+
+	void OnBackgroundBuildFinished(FBuiltItems&& BuiltItems);
+
+	void ApplyBuiltItems(FBuiltItems&& BuiltItems);
+
+	FItemArray& GetMutableItems();
+
+	void OnAssetAdded(const FAssetData& AssetData);
+
+	void OnAssetRemoved(const FAssetData& AssetData);
+
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+	void AddAsset(const FAssetData& AssetData);
+
+	void RemoveAsset(const FString& ObjectPath);
+
+	static bool ShouldIndexAsset(const FAssetData& AssetData);
+
+	static FString GetObjectPath(const FAssetData& AssetData);
+
+	static void BuildItems(const TArray<FAssetData>& Assets, FBuiltItems& OutItems);
+};
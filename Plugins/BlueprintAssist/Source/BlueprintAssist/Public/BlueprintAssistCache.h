@@ -6,9 +6,30 @@
 
 #include "SGraphPin.h"
 #include "BlueprintAssistGlobals.h"
+#include "EdGraph/EdGraphSchema.h"
 
 #include "BlueprintAssistCache.generated.h"
 
+/**
+ * Size shared by every node with the same shape (see FBANodeSizeChangeData::GetNodeShape)
+ */
+USTRUCT()
+struct BLUEPRINTASSIST_API FBANodeShapeData
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	int32 SizeX = 0;
+
+	UPROPERTY()
+	int32 SizeY = 0;
+
+	UPROPERTY()
+	TArray<float> PinOffsets; // offset of each pin, in the order of UEdGraphNode::Pins
+
+	bool Matches(const FBANodeShapeData& Other) const;
+};
+
 USTRUCT()
 struct BLUEPRINTASSIST_API FBANodeData
 {
@@ -32,17 +53,24 @@ struct BLUEPRINTASSIST_API FBANodeData
 	UPROPERTY()
 	TArray<FGuid> NodeGroups;
 
+	UPROPERTY()
+	FGuid Shape; // when valid, the size and pin offsets are read from the shared shape instead of SizeX, SizeY and CachedPins
+
 	void ResetSize()
 	{
 		SizeX = 0;
 		SizeY = 0;
 		CachedPins.Reset();
+		Shape.Invalidate();
 	}
 
-	bool HasSize() const
-	{
-		return SizeX != 0 && SizeY != 0;
-	}
+	bool HasSize() const;
+
+	FVector2D GetSize() const;
+
+	bool FindPinOffset(const UEdGraphPin* Pin, float& OutOffset) const;
+
+	const FBANodeShapeData* FindShape() const;
 
 	void SetSize(const FVector2D& Size)
 	{
@@ -63,6 +91,9 @@ struct BLUEPRINTASSIST_API FBAGraphData
 
 	FBANodeData& GetNodeData(UEdGraphNode* Node);
 
+	/* Copies the shared shape sizes into each node, for storing the graph data without the shape table (package meta data) */
+	void ExpandNodeShapes(UEdGraph* Graph);
+
 	bool bTriedLoadingMetaData = false;
 };
 
@@ -75,6 +106,47 @@ struct BLUEPRINTASSIST_API FBAPackageData
 	TMap<FGuid, FBAGraphData> GraphData; // graph guid -> graph data
 };
 
+UENUM()
+enum class EBASymbolType : uint8
+{
+	Graph,
+	Event,
+	Variable,
+};
+
+USTRUCT()
+struct BLUEPRINTASSIST_API FBASymbolData
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	FString Name;
+
+	UPROPERTY()
+	EBASymbolType Type = EBASymbolType::Graph;
+
+	UPROPERTY()
+	FName GraphName; // graph containing the event, or the graph itself
+
+	UPROPERTY()
+	TEnumAsByte<EGraphType> GraphType = GT_Ubergraph;
+
+	UPROPERTY()
+	FGuid Guid; // event node guid or variable guid
+};
+
+USTRUCT()
+struct BLUEPRINTASSIST_API FBABlueprintSymbolData
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	FString ObjectPath;
+
+	UPROPERTY()
+	TArray<FBASymbolData> Symbols;
+};
+
 USTRUCT()
 struct BLUEPRINTASSIST_API FBACacheData
 {
@@ -83,6 +155,12 @@ struct BLUEPRINTASSIST_API FBACacheData
 	UPROPERTY()
 	TMap<FName, FBAPackageData> PackageData; // package name -> package data
 
+	UPROPERTY()
+	TMap<FName, FBABlueprintSymbolData> BlueprintSymbols; // package name -> symbols
+
+	UPROPERTY()
+	TMap<FGuid, FBANodeShapeData> NodeShapes; // node shape -> shared node size
+
 	UPROPERTY()
 	TArray<FString> BookmarkedFolders;
 
@@ -108,8 +186,18 @@ public:
 
 	void CleanupFiles();
 
+	bool HasLoaded() const { return bHasLoaded; }
+
 	FBAGraphData& GetGraphData(UEdGraph* Graph);
 
+	const FBANodeShapeData* FindNodeShape(const FGuid& Shape) const { return CacheData.NodeShapes.Find(Shape); }
+
+	/* Moves the measured size of the node to the shared size of its shape, unless it differs from the nodes already measured with this shape */
+	void ShareNodeShape(UEdGraphNode* Node, FBANodeData& NodeData);
+
+	/* If a node with the same shape has been measured, use its size so this node does not need to be measured */
+	bool TryApplyNodeShape(UEdGraphNode* Node, FBANodeData& NodeData);
+
 	FString GetProjectSavedCachePath(bool bFullPath = false);
 	FString GetPluginCachePath(bool bFullPath = false);
 	FString GetCachePath(bool bFullPath = false);
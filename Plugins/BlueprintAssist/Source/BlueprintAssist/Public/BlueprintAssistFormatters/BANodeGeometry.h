@@ -0,0 +1,62 @@
+// Copyright fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Layout/SlateRect.h"
+
+class UEdGraph;
+class UEdGraphNode;
+class UEdGraphPin;
+struct FBAGraphData;
+
+/**
+ * Source of the node sizes and pin offsets used by the formatters.
+ * FBAGraphHandler reads the node cache and falls back to the graph widgets, FBACachedNodeGeometry only reads the node cache.
+ * The formatters read all geometry through their graph handler, a headless handler (FBAGraphHandler::MakeHeadless) forwards to the geometry it was made with.
+ */
+class BLUEPRINTASSIST_API IBANodeGeometry
+{
+public:
+	virtual ~IBANodeGeometry() = default;
+
+	/* Size of the node without its comment bubble, returns false if it is unknown */
+	virtual bool GetNodeSize(UEdGraphNode* Node, FVector2D& OutSize) = 0;
+
+	/* Offset of the pin from the top of its node, returns false if it is unknown */
+	virtual bool GetPinOffset(const UEdGraphPin* Pin, float& OutOffset) = 0;
+
+	virtual bool GetCommentBubbleSize(UEdGraphNode* Node, FVector2D& OutSize) { return false; }
+};
+
+/**
+ * Node and pin positions computed from an IBANodeGeometry and the node positions, without any graph widget
+ */
+struct BLUEPRINTASSIST_API FBANodeGeometryUtils
+{
+	static FSlateRect GetNodeBounds(IBANodeGeometry& Geometry, UEdGraphNode* Node, bool bWithCommentBubble = true);
+
+	static float GetPinY(IBANodeGeometry& Geometry, const UEdGraphPin* Pin);
+
+	/* Uses the node left for input pins and the node right for output pins */
+	static FVector2D GetPinPos(IBANodeGeometry& Geometry, const UEdGraphPin* Pin);
+};
+
+/**
+ * Reads the node sizes and pin offsets saved in the cache, for laying out graphs which have no graph panel (e.g. commandlets)
+ */
+class BLUEPRINTASSIST_API FBACachedNodeGeometry final : public IBANodeGeometry
+{
+public:
+	explicit FBACachedNodeGeometry(UEdGraph* InGraph) : Graph(InGraph) { }
+
+	virtual bool GetNodeSize(UEdGraphNode* Node, FVector2D& OutSize) override;
+
+	virtual bool GetPinOffset(const UEdGraphPin* Pin, float& OutOffset) override;
+
+private:
+	TWeakObjectPtr<UEdGraph> Graph;
+
+	/* Looked up on each query since the cache may reallocate its graph data, loads it from the package meta data if it is not cached yet */
+	const FBAGraphData* GetGraphData() const;
+};
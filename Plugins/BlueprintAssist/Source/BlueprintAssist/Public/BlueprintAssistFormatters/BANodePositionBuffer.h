@@ -0,0 +1,44 @@
+// Copyright fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UEdGraph;
+class UEdGraphNode;
+
+/**
+ * Start positions of the graph nodes for one formatting run, stored in flat arrays in graph order.
+ * The formatters move nodes freely while the run is active, on flush every node which moved is modified once
+ * (with its start position restored for the transaction) instead of each pass modifying the nodes it touches.
+ *
+ * Flush before anything else modifies the nodes (e.g. the knot pass relinking pins) so the transaction
+ * never records a moved position as the start position.
+ */
+class BLUEPRINTASSIST_API FBANodePositionBuffer
+{
+public:
+	/* Snapshot the node positions, returns false if a run is already active */
+	bool Begin(UEdGraph* Graph);
+
+	bool IsActive() const { return bActive; }
+
+	/* Modify the nodes which moved since the snapshot, returns the number of nodes modified */
+	int32 Flush();
+
+	/* Flush and end the run */
+	int32 Commit();
+
+	void Reset();
+
+	int32 GetNumNodes() const { return Nodes.Num(); }
+
+private:
+	TArray<TWeakObjectPtr<UEdGraphNode>> Nodes;
+	TArray<FIntPoint> StartPositions;
+
+	// the node has been modified in the current transaction and will not be modified again
+	TBitArray<> Committed;
+
+	bool bActive = false;
+};
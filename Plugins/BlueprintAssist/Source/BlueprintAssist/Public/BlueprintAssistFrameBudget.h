@@ -0,0 +1,33 @@
+// Copyright fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Limits how much time deferred graph work (node size caching, pending formatting) can take in a single frame.
+ * Work which does not fit in the budget is continued on the next tick.
+ */
+class BLUEPRINTASSIST_API FBAFrameBudget
+{
+	double FrameStartTime = 0.0;
+	double BudgetSeconds = 0.0;
+
+public:
+	/* A budget of zero or less is unlimited */
+	void BeginFrame(float BudgetMs);
+
+	bool HasTimeRemaining() const;
+};
+
+/**
+ * Progress of the deferred work queued on a graph handler
+ */
+struct BLUEPRINTASSIST_API FBAPendingWorkProgress
+{
+	int32 NumPendingSize = 0;
+	int32 InitialPendingSize = 0;
+	int32 NumPendingFormatting = 0;
+
+	float GetSizeProgress() const;
+};
@@ -4,7 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "BlueprintAssistDelayedDelegate.h"
+#include "BlueprintAssistFrameBudget.h"
+#include "BlueprintAssistHitTestIndex.h"
+#include "BlueprintAssistNodeLookupCache.h"
 #include "BlueprintAssistNodeSizeChangeData.h"
+#include "BlueprintAssistFormatters/BANodeGeometry.h"
+#include "BlueprintAssistFormatters/BANodePositionBuffer.h"
 #include "BlueprintAssistFormatters/GraphFormatterTypes.h"
 
 class SBlueprintAssistGraphOverlay;
@@ -18,13 +23,19 @@ DECLARE_MULTICAST_DELEGATE_TwoParams(FOnNodeFormatted, UEdGraphNode*, const FFor
 
 class BLUEPRINTASSIST_API FBAGraphHandler
 	: public TSharedFromThis<FBAGraphHandler>
+	, public IBANodeGeometry
 {
 public:
 	FOnNodeFormatted OnNodeFormatted;
 
 	FBAGraphHandler(TWeakPtr<SDockTab> InTab, TWeakPtr<SGraphEditor> InGraphEditor);
 
-	~FBAGraphHandler();
+	/* Handler for a graph which is not open in a graph editor (e.g. commandlets), the node sizes and pin offsets only come from InGeometry */
+	static TSharedRef<FBAGraphHandler> MakeHeadless(UEdGraph* InGraph, TSharedRef<IBANodeGeometry> InGeometry);
+
+	virtual ~FBAGraphHandler() override;
+
+	bool IsHeadless() const { return HeadlessGeometry.IsValid(); }
 
 	void InitGraphHandler();
 
@@ -34,6 +45,22 @@ public:
 
 	void OnLoseFocus();
 
+	/* Free the per-graph caches (formatters, hit test index), used when this handler's tab is in the background. The node hashes and comment bubble sizes are kept since unchanged nodes are not re-measured */
+	void ReleaseCaches();
+
+	bool HasReleasedCaches() const { return bReleasedCaches; }
+
+	/* Approximate memory used by this handler's per-graph caches */
+	SIZE_T GetAllocatedSize() const;
+
+	double GetLastFocusTime() const { return LastFocusTime; }
+
+	FBAHitTestIndex& GetHitTestIndex() { return HitTestIndex; }
+
+	FBANodeLookupCache& GetNodeLookupCache() { return NodeLookupCache; }
+
+	FBANodePositionBuffer& GetNodePositionBuffer() { return NodePositionBuffer; }
+
 	void Cleanup();
 
 	void Tick(float DeltaTime);
@@ -82,6 +109,9 @@ public:
 
 	void SmartFormatAll();
 
+	/* Format the columns gathered by FormatAllEvents */
+	void RunFormatAll();
+
 	void FormatColumn(TArray<TSharedPtr<FFormatterInterface>>& CurrentColumn, float ColumnX);
 
 	void SetSelectedPin(UEdGraphPin* Pin, bool bLerpIntoView = false);
@@ -92,7 +122,11 @@ public:
 	const FVector2D& GetTargetLerpLocation() const { return TargetLerpLocation; }
 	bool IsLerpingViewport() const { return bLerpViewport; }
 
-	TSharedPtr<FFormatterInterface> FormatNodes(UEdGraphNode* Node, bool bUsingFormatAll = false);
+	/* InRootNode skips resolving the root node when the caller already has it */
+	TSharedPtr<FFormatterInterface> FormatNodes(UEdGraphNode* Node, bool bUsingFormatAll = false, UEdGraphNode* InRootNode = nullptr);
+
+	/* Modify the nodes moved by the formatting run once and end the run, see FBANodePositionBuffer */
+	void CommitNodePositions();
 
 	/**
 	 * Cancel active node size and formatting processes, also clear any active related notifications and transactions
@@ -133,6 +167,9 @@ public:
 
 	void FormatAllEvents();
 
+	/* Format all events now instead of on the next tick once the node sizes are cached, used by headless handlers */
+	void FormatAllEventsImmediate();
+
 	void ApplyGlobalCommentBubblePinned();
 
 	void ApplyCommentBubblePinned(UEdGraphNode* Node);
@@ -141,6 +178,11 @@ public:
 
 	float GetPendingNodeSizeProgress() const;
 
+	/* Number of queued nodes which shared their root node with another queued node, so their tree was only formatted once */
+	int32 GetNumRedundantFormatsAvoided() const { return NumRedundantFormatsAvoided; }
+
+	FBAPendingWorkProgress GetPendingWorkProgress() const;
+
 	void ClearFormatters();
 
 	bool FilterSelectiveFormatting(UEdGraphNode* Node, const TArray<UEdGraphNode*>& NodesToFormat);
@@ -167,7 +209,18 @@ public:
 	FBAGraphData& GetGraphData();
 	FBANodeData& GetNodeData(UEdGraphNode* Node);
 
+	// ~ IBANodeGeometry, reads the node cache then falls back to the graph panel widgets (or the headless geometry)
+	virtual bool GetNodeSize(UEdGraphNode* Node, FVector2D& OutSize) override;
+	virtual bool GetPinOffset(const UEdGraphPin* Pin, float& OutOffset) override;
+	virtual bool GetCommentBubbleSize(UEdGraphNode* Node, FVector2D& OutSize) override;
+	// ~ IBANodeGeometry
+
+	const TMap<FGuid, FBANodeSizeChangeData>& GetNodeSizeChangeDataMap() const { return NodeSizeChangeDataMap; }
+
 	TMap<FGuid, TSet<TWeakObjectPtr<UEdGraphNode>>> NodeGroups;
+
+	/* Nodes with FBANodeData::bLocked set, so the overlay doesn't check every node of the graph when drawing the lock icons */
+	TSet<TWeakObjectPtr<UEdGraphNode>> LockedNodes;
 	TSet<UEdGraphNode*> GetNodeGroup(const FGuid& GroupID); 
 	void AddToNodeGroup(FGuid GroupID, UEdGraphNode* Node);
 	void ClearNodeGroup(UEdGraphNode* Node);
@@ -179,7 +232,10 @@ public:
 	void UngroupNodes(const TSet<UEdGraphNode*>& NodeSet);
 
 private:
+	FBAGraphHandler(UEdGraph* InGraph, TSharedRef<IBANodeGeometry> InGeometry);
+
 	TSharedPtr<SBlueprintAssistGraphOverlay> GraphOverlay;
+	TSharedPtr<IBANodeGeometry> HeadlessGeometry;
 	TWeakObjectPtr<UEdGraphNode> NodeToReplace = nullptr;
 
 	TWeakPtr<SGraphPanel> CachedGraphPanel;
@@ -207,6 +263,12 @@ private:
 	// update node size
 	float NodeSizeTimeout = 0.f;
 	TSet<TWeakObjectPtr<UEdGraphNode>> PendingFormatting;
+	int32 NumRedundantFormatsAvoided = 0;
+	bool bReleasedCaches = false;
+	double LastFocusTime = 0.0;
+	FBAHitTestIndex HitTestIndex;
+	FBANodeLookupCache NodeLookupCache;
+	FBANodePositionBuffer NodePositionBuffer;
 	TWeakObjectPtr<UEdGraphNode> FocusedNode = nullptr;
 	bool bFullyZoomed = false;
 	FVector2D ViewCache;
@@ -226,6 +288,8 @@ private:
 	int32 InitialPendingSize = 0;
 	TArray<TWeakObjectPtr<UEdGraphNode>> PendingSize;
 
+	FBAFrameBudget FrameBudget;
+
 	TArray<TArray<TWeakObjectPtr<UEdGraphNode>>> FormatAllColumns;
 	TMap<TWeakObjectPtr<UEdGraphNode>, TSharedPtr<FFormatterInterface>> FormatterMap;
 
@@ -241,6 +305,11 @@ private:
 
 	void OnGraphInitializedDelayed();
 
+	void InitNodeSizeChangeData();
+
+	/* Compare the nodes against the node hashes kept while the caches were released, changed nodes and nodes without a hash are re-measured */
+	void RefreshNodeSizeChangeData();
+
 	TMap<FGuid, FBANodeSizeChangeData> NodeSizeChangeDataMap;
 
 	TWeakObjectPtr<UEdGraphNode> ZoomToTargetPostFormatting;
@@ -279,8 +348,14 @@ private:
 
 	void OnObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event);
 
+	/* Nodes call Modify while being dragged, before the drag is transacted */
+	void OnObjectModified(UObject* Object);
+
 	bool CacheNodeSize(UEdGraphNode* Node);
 
+	/* Use the cached size of an identical node instead of measuring the node */
+	bool TryApplyNodeShape(UEdGraphNode* Node);
+
 	bool UpdateNodeSizesChanges(const TArray<UEdGraphNode*>& Nodes);
 
 	void AutoLerpToNewlyCreatedNode(UEdGraphNode* Node);
@@ -0,0 +1,149 @@
+// Copyright fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdGraph/EdGraphPin.h"
+#include "Layout/SlateRect.h"
+#include "Logging/TokenizedMessage.h"
+
+class IBANodeGeometry;
+class UEdGraph;
+class UEdGraphNode;
+
+struct BLUEPRINTASSIST_API FBAGraphIssue
+{
+	EMessageSeverity::Type Severity = EMessageSeverity::Info;
+
+	FName Rule;
+
+	FString Message;
+
+	TWeakObjectPtr<UEdGraphNode> Node;
+};
+
+struct BLUEPRINTASSIST_API FBALintPin
+{
+	int32 NodeIndex = INDEX_NONE;
+
+	EEdGraphPinDirection Direction = EGPD_Input;
+
+	bool bExec = false;
+
+	FVector2D Position = FVector2D::ZeroVector;
+
+	/* Indices of the linked pins in the snapshot */
+	TArray<int32> LinkedTo;
+};
+
+struct BLUEPRINTASSIST_API FBALintNode
+{
+	TWeakObjectPtr<UEdGraphNode> Node;
+
+	FGuid Guid;
+
+	FString Name;
+
+	/* Includes the comment bubble */
+	FSlateRect Bounds;
+
+	/* False if the node size is not cached, the bounds then use a default size */
+	bool bHasSize = false;
+
+	bool bKnot = false;
+
+	bool bComment = false;
+
+	bool bImpure = false;
+
+	bool bEvent = false;
+
+	bool bVariableGet = false;
+
+	/* Instance of a loop macro from the StandardMacros library, its inputs are read on every iteration */
+	bool bForLoopMacro = false;
+
+	bool bInsideComment = false;
+
+	TArray<int32> Pins;
+};
+
+/**
+ * Immutable copy of a graph taken on the game thread, read by the lint rules on worker threads
+ */
+struct BLUEPRINTASSIST_API FBALintGraphSnapshot
+{
+	FString GraphName;
+
+	bool bHasComments = false;
+
+	TArray<FBALintNode> Nodes;
+
+	TArray<FBALintPin> Pins;
+
+	/* Copy of UBASettings_Advanced::LintLongLinkSpan, the settings must not be read from worker threads */
+	float LongLinkSpan = 0;
+
+	void Build(UEdGraph* Graph, IBANodeGeometry& Geometry);
+};
+
+class BLUEPRINTASSIST_API IBAGraphLintRule
+{
+public:
+	virtual ~IBAGraphLintRule() = default;
+
+	/* Name used by UBASettings_Advanced::DisabledLintRules */
+	virtual FName GetName() const = 0;
+
+	/* Called from worker threads, must only read the snapshot */
+	virtual void Lint(const FBALintGraphSnapshot& Graph, TArray<FBAGraphIssue>& OutIssues) const = 0;
+};
+
+struct BLUEPRINTASSIST_API FBAGraphLintResult
+{
+	TArray<FBAGraphIssue> Issues;
+
+	double Seconds = 0;
+
+	/* The graph had not changed since it was last linted */
+	bool bCached = false;
+};
+
+/**
+ * Runs the registered lint rules over graphs. Snapshots of the graphs are taken on the game thread, then each graph is linted in parallel.
+ * The result of each graph is cached by a hash of its content, so an unchanged graph is not linted again.
+ */
+class BLUEPRINTASSIST_API FBAGraphLint
+{
+public:
+	static FBAGraphLint& Get();
+	static void TearDown();
+
+	FBAGraphLint();
+
+	void Cleanup();
+
+	void RegisterRule(TSharedRef<IBAGraphLintRule> Rule);
+
+	void UnregisterRule(FName RuleName);
+
+	void LintGraphs(const TArray<UEdGraph*>& Graphs, TArray<FBAGraphLintResult>& OutResults);
+
+	/* Adds the issues to the blueprint assist message log, opening it if there are any errors */
+	static void ReportIssues(const TArray<FBAGraphIssue>& Issues);
+
+private:
+	struct FCachedResult
+	{
+		uint32 Hash = 0;
+		TArray<FBAGraphIssue> Issues;
+	};
+
+	TArray<TSharedRef<IBAGraphLintRule>> Rules;
+
+	TMap<TWeakObjectPtr<UEdGraph>, FCachedResult> CachedResults;
+
+	TArray<TSharedRef<IBAGraphLintRule>> GetEnabledRules() const;
+
+	static uint32 GetGraphHash(UEdGraph* Graph, IBANodeGeometry& Geometry);
+};
@@ -0,0 +1,76 @@
+// Copyright fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class SGraphNode;
+class SGraphPanel;
+class SGraphPin;
+
+/**
+ * Grid of node and wire bounds used to find the hovered node and pin without checking every node in the graph.
+ * Rebuilt lazily when marked dirty (graph changed, nodes transacted, node sizes cached) or when the zoom changes.
+ * Candidates are always tested against the current widget bounds, so a stale grid can miss nodes but never returns a wrong one.
+ */
+class BLUEPRINTASSIST_API FBAHitTestIndex
+{
+public:
+	void MarkDirty() { bDirty = true; }
+
+	void Reset();
+
+	/* Regular nodes take priority over comment nodes */
+	TSharedPtr<SGraphNode> FindNodeAt(TSharedPtr<SGraphPanel> GraphPanel, const FVector2D& GraphCoord);
+
+	/* Checks the pins of the regular nodes under the cursor, then the pins at both ends of the wires under the cursor (a hovered wire marks these pins as hovered) */
+	TSharedPtr<SGraphPin> FindHoveredPin(TSharedPtr<SGraphPanel> GraphPanel, const FVector2D& GraphCoord, bool bUseDirectlyHovered);
+
+	int32 GetNumRebuilds() const { return NumRebuilds; }
+
+private:
+	struct FEntry
+	{
+		TWeakPtr<SGraphNode> GraphNode;
+		FSlateRect Bounds;
+	};
+
+	struct FWireEntry
+	{
+		TWeakPtr<SGraphPin> OutputPin;
+		TWeakPtr<SGraphPin> InputPin;
+		FSlateRect Bounds;
+	};
+
+	static constexpr float CellSize = 512.0f;
+
+	// regular nodes in graph order, the grid cells store indices into this array
+	TArray<FEntry> Entries;
+	TMap<FIntPoint, TArray<int32>> Grid;
+
+	// wires between the pins of regular nodes, bounds are padded for the spline tangents
+	TArray<FWireEntry> WireEntries;
+	TMap<FIntPoint, TArray<int32>> WireGrid;
+
+	// comment nodes can span a large part of the graph so they are not stored in the grid
+	TArray<FEntry> CommentEntries;
+
+	TWeakPtr<SGraphPanel> CachedPanel;
+	float CachedZoom = 0.f;
+	int32 CachedNumNodes = INDEX_NONE;
+	double LastBuildTime = 0.0;
+	bool bDirty = true;
+	int32 NumRebuilds = 0;
+
+	void RebuildIfNeeded(TSharedPtr<SGraphPanel> GraphPanel);
+
+	void Rebuild(TSharedPtr<SGraphPanel> GraphPanel);
+
+	void AddWires(TSharedPtr<SGraphPanel> GraphPanel, const TMap<UEdGraphNode*, int32>& EntryIndices);
+
+	static void AddToGrid(TMap<FIntPoint, TArray<int32>>& InGrid, const FSlateRect& Bounds, int32 Index);
+
+	void GetRegularNodesAt(const FVector2D& GraphCoord, TArray<TSharedPtr<SGraphNode>, TInlineAllocator<4>>& OutNodes) const;
+
+	static FIntPoint GetCell(const FVector2D& GraphCoord);
+};
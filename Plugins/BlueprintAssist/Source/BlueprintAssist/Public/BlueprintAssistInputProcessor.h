@@ -68,7 +68,12 @@ public:
 
 	void UpdateGroupMovement();
 	void GroupMoveSelectedNodes(const FVector2D& Delta);
-	void GroupMoveNodes(const FVector2D& Delta, TSet<UEdGraphNode*>& Nodes);
+
+	/* Apply the drag delta accumulated from mouse move events since the last tick */
+	void ApplyPendingDragDelta();
+
+	/* Clear the nodes cached for the current group drag */
+	void ResetGroupDrag();
 
 	FBANodeMovementTransaction DragNodeTransaction;
 
@@ -96,6 +101,24 @@ private:
 
 	FBAInputProcessorState ProcessorState;
 
+	/* Mouse move events only accumulate the drag delta, nodes are moved once per tick */
+	FVector2D PendingDragDelta = FVector2D::ZeroVector;
+
+	/* Nodes moved along with the anchor node, gathered once and reused until the selection or movement mode changes */
+	TArray<TWeakObjectPtr<UEdGraphNode>> GroupDragNodes;
+	uint32 GroupDragKey = 0;
+
+	/* Nodes already recorded in the drag transaction, so each node is only modified once per drag */
+	TSet<TWeakObjectPtr<UEdGraphNode>> GroupDragModifiedNodes;
+
+	void CacheGroupDragNodes(const TSet<UEdGraphNode*>& Nodes, const TSet<UEdGraphNode*>& SelectedNodes);
+
+	void ModifyForGroupDrag(UEdGraphNode* Node);
+
+	/* Commands with an active chord, looked up lazily per chord and cleared when the user changes a binding */
+	TMap<FInputChord, TArray<TSharedPtr<FUICommandInfo>, TInlineAllocator<2>>> ChordDispatchTable;
+	FDelegateHandle OnUserDefinedChordChangedHandle;
+
 	FBAInputProcessor();
 
 #if ENGINE_MINOR_VERSION >= 26 || ENGINE_MAJOR_VERSION >= 5
@@ -109,4 +132,13 @@ private:
 	void OnWindowFocusChanged(bool bIsFocused);
 
 	bool ProcessCommandBindings(TSharedPtr<FUICommandList> CommandList, const FKeyEvent& KeyEvent);
+
+	FInputChord GetInputChord(const FKeyEvent& KeyEvent) const;
+
+	const TArray<TSharedPtr<FUICommandInfo>, TInlineAllocator<2>>& GetCommandsForChord(const FInputChord& Chord);
+
+	/* If false, none of our command lists can process this key event so any context checks for them can be skipped */
+	bool HasCommandsForKeyEvent(const FKeyEvent& KeyEvent);
+
+	void OnUserDefinedChordChanged(const FUICommandInfo& CommandInfo);
 };
@@ -0,0 +1,139 @@
+// Copyright fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BAGraphMaintenanceCommandlet.generated.h"
+
+class UBlueprint;
+class UEdGraph;
+
+USTRUCT()
+struct BLUEPRINTASSIST_API FBAGraphMaintenanceIssue
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	FString Severity;
+
+	UPROPERTY()
+	FString Rule;
+
+	UPROPERTY()
+	FString Graph;
+
+	UPROPERTY()
+	FString Message;
+};
+
+USTRUCT()
+struct BLUEPRINTASSIST_API FBAGraphMaintenanceAssetReport
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	FString AssetPath;
+
+	UPROPERTY()
+	bool bLoaded = false;
+
+	UPROPERTY()
+	bool bSaved = false;
+
+	UPROPERTY()
+	int32 NumGraphs = 0;
+
+	UPROPERTY()
+	int32 NumRemovedNodes = 0;
+
+	UPROPERTY()
+	int32 NumFormattedGraphs = 0;
+
+	/* Graphs not formatted because some of their nodes have no cached size */
+	UPROPERTY()
+	int32 NumUnsizedGraphs = 0;
+
+	UPROPERTY()
+	double LoadSeconds = 0;
+
+	UPROPERTY()
+	double LintSeconds = 0;
+
+	UPROPERTY()
+	double CleanupSeconds = 0;
+
+	UPROPERTY()
+	double FormatSeconds = 0;
+
+	UPROPERTY()
+	double SaveSeconds = 0;
+
+	UPROPERTY()
+	TArray<FBAGraphMaintenanceIssue> Issues;
+};
+
+USTRUCT()
+struct BLUEPRINTASSIST_API FBAGraphMaintenanceReport
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY()
+	int32 NumAssets = 0;
+
+	UPROPERTY()
+	int32 NumIssues = 0;
+
+	UPROPERTY()
+	int32 NumErrors = 0;
+
+	UPROPERTY()
+	int32 NumSaved = 0;
+
+	UPROPERTY()
+	int32 NumRemovedNodes = 0;
+
+	UPROPERTY()
+	int32 NumFormattedGraphs = 0;
+
+	UPROPERTY()
+	int32 NumUnsizedGraphs = 0;
+
+	UPROPERTY()
+	double TotalSeconds = 0;
+
+	UPROPERTY()
+	TArray<FBAGraphMaintenanceAssetReport> Assets;
+};
+
+/**
+ * Runs the graph lint rules (see FBAGraphLint) over every blueprint in a set of content paths
+ * and writes a json report with per-asset timings. Returns 1 if any error was found.
+ *
+ * -run=BAGraphMaintenance [-Paths=/Game/A+/Game/B] [-Report=File.json] [-BatchSize=64] [-Cleanup] [-Format] [-Save]
+ *
+ * -Cleanup deletes unlinked reroute nodes, -Save saves the blueprints modified by the cleanup or formatting.
+ * -Format runs format all on each blueprint graph through a headless FBAGraphHandler, the node sizes and pin offsets
+ * are read from the node cache (FBACachedNodeGeometry) so graphs with nodes which were never measured in the editor are skipped.
+ * Packages are loaded and saved on the game thread in batches, the graphs of each batch are linted in parallel.
+ */
+UCLASS()
+class BLUEPRINTASSIST_API UBAGraphMaintenanceCommandlet final : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBAGraphMaintenanceCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	void ProcessBatch(const TArray<FSoftObjectPath>& AssetPaths, bool bCleanup, bool bFormat, bool bSave, FBAGraphMaintenanceReport& Report);
+
+	static int32 CleanupGraph(UEdGraph* Graph);
+
+	/* Returns true if the formatting moved or added nodes, bOutMissingSizes is set if it was skipped for nodes without a cached size */
+	static bool FormatGraph(UEdGraph* Graph, bool& bOutMissingSizes);
+
+	static FString GetDefaultReportPath();
+};
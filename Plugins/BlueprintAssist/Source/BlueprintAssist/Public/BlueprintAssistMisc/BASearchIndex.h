@@ -0,0 +1,81 @@
+// Copyright fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Search engine for the filtered list menus (see SBAFilteredList).
+ * Items are referred to by the order they were added. Their search text is stored lowercase in a single buffer,
+ * with a character mask for quick rejection and a trigram index (built on the first search) to find candidates.
+ * A query which extends the previous query only checks the previous matches.
+ * Indexes of long lived item lists (see FBAAssetIndex::GetSearchIndex) are shared with the list so the trigrams are only built once.
+ */
+class BLUEPRINTASSIST_API FBASearchIndex
+{
+public:
+	void Reset(int32 NumItems = 0);
+
+	/* Spaces are removed from the search text, the key search text is used to rank exact matches first */
+	void AddItem(const FString& SearchText, const FString& KeySearchText);
+
+	int32 Num() const { return Entries.Num(); }
+
+	/*
+	 * Every space separated term must be contained in the search text. If nothing matches, only the best MaxSortedResults items containing the query as a subsequence are returned instead.
+	 * The best MaxSortedResults are sorted by score (exact key match, then prefix match, then shortest key), the remaining matches keep their item order.
+	 */
+	void Search(const FString& Query, TArray<int32>& OutResults, int32 MaxSortedResults = 256);
+
+private:
+	struct FEntry
+	{
+		int32 SearchOffset = 0;
+		int32 SearchLen = 0;
+		int32 KeyOffset = 0;
+		int32 KeyLen = 0;
+		uint64 CharMask = 0;
+	};
+
+	struct FScoredItem
+	{
+		int32 Index;
+		int32 Score;
+	};
+
+	static constexpr int32 NumTrigramBuckets = 1 << 16;
+
+	TArray<FEntry> Entries;
+
+	/* Lowercase search and key text of every item, each null terminated */
+	TArray<TCHAR> Chars;
+
+	/* Items containing each trigram bucket, stored contiguously in item order */
+	TArray<int32> TrigramOffsets;
+	TArray<int32> TrigramItems;
+	bool bTrigramsBuilt = false;
+
+	FString PreviousQuery;
+	TArray<int32> PreviousMatches;
+
+	/* Items containing the previous fallback query as a subsequence, a longer query can only match a subset of them */
+	FString PreviousSubsequenceQuery;
+	TArray<int32> PreviousSubsequenceMatches;
+
+	void BuildTrigrams();
+
+	TArrayView<const int32> GetTrigramCandidates(const TArray<FString>& Terms);
+
+	void SelectBest(TArray<FScoredItem>& Scored, TArray<int32>& OutResults, int32 MaxSortedResults, bool bDiscardUnsorted) const;
+
+	const TCHAR* GetSearchText(const FEntry& Entry) const { return &Chars[Entry.SearchOffset]; }
+
+	const TCHAR* GetKeyText(const FEntry& Entry) const { return &Chars[Entry.KeyOffset]; }
+
+	/* Number of characters skipped when matching the query as a subsequence, INDEX_NONE if it does not match */
+	static int32 GetSubsequenceGaps(const TCHAR* Text, const FString& Query);
+
+	static uint64 GetCharBit(TCHAR Char) { return 1ull << (static_cast<uint32>(Char) & 63); }
+
+	static uint32 GetTrigramBucket(const TCHAR* Chars);
+};
@@ -0,0 +1,103 @@
+// Copyright fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+
+UE_TRACE_CHANNEL_EXTERN(BlueprintAssistInputChannel, BLUEPRINTASSIST_API);
+
+enum class EBAInputHandler : uint8
+{
+	KeyDown,
+	MouseButtonDown,
+	MouseMove,
+	Num
+};
+
+/**
+ * Latency histogram with power of two buckets in microseconds, percentiles are approximate (upper bound of the bucket)
+ */
+struct BLUEPRINTASSIST_API FBALatencyHistogram
+{
+	static constexpr int32 NumBuckets = 24;
+
+	uint32 Buckets[NumBuckets] = {};
+	uint32 Count = 0;
+	double TotalMicroseconds = 0.0;
+	double MaxMicroseconds = 0.0;
+
+	void Add(double Microseconds);
+
+	double GetPercentile(float Percentile) const;
+
+	double GetAverage() const { return Count > 0 ? TotalMicroseconds / Count : 0.0; }
+};
+
+/**
+ * Records how long the input processor handlers take, since they run before slate for every input event in the editor.
+ * Recording is off by default so the handlers don't pay for the timing, use "BlueprintAssist.InputLatency start" / "stop".
+ * Use the console command "BlueprintAssist.InputLatency" to print the report, or "BlueprintAssist.InputLatency reset".
+ * Handlers are also traced on the "BlueprintAssistInput" Insights channel.
+ */
+class BLUEPRINTASSIST_API FBAInputLatencyTracker
+{
+public:
+	static FBAInputLatencyTracker& Get();
+
+	void Record(EBAInputHandler Handler, double Microseconds, FName DispatchedCommand);
+
+	bool IsRecording() const { return bRecording; }
+
+	void SetRecording(bool bInRecording) { bRecording = bInRecording; }
+
+	/* Called when a command is executed by the handler currently being measured */
+	void SetDispatchedCommand(FName CommandName) { CurrentCommand = CommandName; }
+
+	FName ConsumeDispatchedCommand();
+
+	const FBALatencyHistogram& GetHistogram(EBAInputHandler Handler) const { return Histograms[static_cast<int32>(Handler)]; }
+
+	/* Number of recorded handler calls which dispatched the command */
+	int32 GetDispatchCount(FName CommandName) const
+	{
+		const TPair<int32, double>* Entry = CommandLatency.Find(CommandName);
+		return Entry ? Entry->Key : 0;
+	}
+
+	void LogReport() const;
+
+	void Reset();
+
+	static const TCHAR* GetHandlerName(EBAInputHandler Handler);
+
+private:
+	FBALatencyHistogram Histograms[static_cast<int32>(EBAInputHandler::Num)];
+
+	// number of times each command was dispatched and the worst latency of the handler which dispatched it
+	TMap<FName, TPair<int32, double>> CommandLatency;
+
+	FName CurrentCommand;
+
+	bool bRecording = false;
+};
+
+/**
+ * Measures the enclosing input handler while the tracker is recording
+ */
+struct BLUEPRINTASSIST_API FBAScopedInputLatency
+{
+	explicit FBAScopedInputLatency(EBAInputHandler InHandler);
+
+	~FBAScopedInputLatency();
+
+private:
+	EBAInputHandler Handler;
+	double StartTime = 0.0;
+	bool bRecording;
+};
+
+#define BA_SCOPED_INPUT_LATENCY(Handler) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(TEXT("FBAInputProcessor::" #Handler), BlueprintAssistInputChannel); \
+	FBAScopedInputLatency BAScopedInputLatency(EBAInputHandler::Handler);
@@ -0,0 +1,37 @@
+// Copyright fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UEdGraph;
+class UEdGraphNode;
+class UEdGraphPin;
+
+/**
+ * Maps node guids to nodes for a single graph, used to resolve pin handles without scanning the whole graph.
+ * Only nodes are cached, pins are searched on the owning node since reconstructing a node replaces its pins.
+ */
+class BLUEPRINTASSIST_API FBANodeLookupCache
+{
+public:
+	void Init(UEdGraph* InGraph);
+
+	void Reset();
+
+	void MarkDirty() { bDirty = true; }
+
+	bool IsForGraph(const UEdGraph* InGraph) const { return InGraph != nullptr && Graph.Get() == InGraph; }
+
+	UEdGraphNode* FindNode(const FGuid& NodeGuid);
+
+	UEdGraphPin* FindPin(const FGuid& NodeGuid, const FGuid& PinId);
+
+private:
+	TWeakObjectPtr<UEdGraph> Graph;
+	TMap<FGuid, TWeakObjectPtr<UEdGraphNode>> NodesByGuid;
+	int32 CachedNumNodes = INDEX_NONE;
+	bool bDirty = true;
+
+	void Rebuild();
+};
@@ -10,24 +10,29 @@ class UEdGraphNode;
 
 struct FBAPinChangeData
 {
-	bool bPinLinked;
-	bool bPinHidden;
-	FString PinValue;
-	FText PinTextValue;
-	FText PinLabel;
-	FString PinObject;
+	/* Rolling hash of all the pin values which can change the size of the pin */
+	static uint64 HashPin(UEdGraphPin* Pin, uint64 Seed = 0);
 
-	FBAPinChangeData() = default;
+	/* Same as HashPin without the pin id, so identical pins on different nodes have the same hash */
+	static uint64 HashPinValues(UEdGraphPin* Pin, uint64 Seed = 0);
 
-	void UpdatePin(UEdGraphPin* Pin);
+	/* Human-readable version of the values used in HashPin, only used in verbose mode */
+	static FString DescribePin(UEdGraphPin* Pin);
 
-	bool HasPinChanged(UEdGraphPin* Pin);
+	static FString GetPinDefaultObjectName(UEdGraphPin* Pin);
 
-	FString GetPinDefaultObjectName(UEdGraphPin* Pin) const;
-
-	FText GetPinLabel(UEdGraphPin* Pin) const;
+	static FText GetPinLabel(UEdGraphPin* Pin);
 };
 
+/**
+ * Only allocated when the debug setting "NodeSizeChangeData" is enabled (see UBASettings::BlueprintAssistDebug).
+ * Stores the values which were hashed so we can log the cause of a node being re-measured.
+ */
+struct FBANodeSizeChangeDebugData
+{
+	TMap<FGuid, FString> PinDescriptions;
+	FString NodeDescription;
+};
 
 /**
  * @brief Node size can change by:
@@ -41,18 +46,15 @@ struct FBAPinChangeData
  *		- Comment bubble text
  *		- Node enabled state
  *		- Delegate signature pin at the bottom
+ *
+ * Instead of storing a copy of each of these values we only store a 64-bit content hash for the pins and the node.
  */
 class FBANodeSizeChangeData
 {
-	TMap<FGuid, FBAPinChangeData> PinChangeData;
-	bool bCommentBubblePinned;
-	bool bCommentBubbleVisible;
-	FString CommentBubbleValue;
-	FString NodeTitle;
-	bool AdvancedPinDisplay;
-	ENodeEnabledState NodeEnabledState;
-	FName DelegateFunctionName;
-	FString PropertyAccessTextPath;
+	uint64 PinsHash = 0;
+	uint64 NodeHash = 0;
+
+	TSharedPtr<FBANodeSizeChangeDebugData> DebugData;
 
 public:
 	FBANodeSizeChangeData(UEdGraphNode* Node);
@@ -61,5 +63,31 @@ public:
 
 	bool HasNodeChanged(UEdGraphNode* Node);
 
-	FString GetPropertyAccessTextPath(UEdGraphNode* Node);
-};
\ No newline at end of file
+	SIZE_T GetAllocatedSize() const;
+
+	/* Free the verbose descriptions, the hashes are kept so changes can still be detected */
+	void ReleaseDebugData() { DebugData.Reset(); }
+
+	static uint64 HashPins(UEdGraphNode* Node);
+
+	static uint64 HashNode(UEdGraphNode* Node);
+
+	static FString DescribeNode(UEdGraphNode* Node);
+
+	/**
+	 * Signature of every value which can change the size of the node and its pin offsets: class, title, pins, pin types and values.
+	 * Nodes with the same shape have the same size (see FBACache::ShareNodeShape).
+	 * Invalid for comments and resizable nodes, which are sized by the user.
+	 */
+	static FGuid GetNodeShape(UEdGraphNode* Node);
+
+	static FString GetPropertyAccessTextPath(UEdGraphNode* Node);
+
+	/* Approximate memory used by the old representation (a copy of each value), used to report memory savings */
+	static SIZE_T EstimateUncompactedSize(UEdGraphNode* Node);
+
+	static bool IsVerbose();
+
+private:
+	void LogChanges(UEdGraphNode* Node) const;
+};
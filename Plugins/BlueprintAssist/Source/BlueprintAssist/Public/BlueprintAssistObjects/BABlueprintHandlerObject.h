@@ -10,6 +10,7 @@
 class UEdGraph;
 class UK2Node_EditablePinBase;
 struct FKismetUserDeclaredFunctionMetadata;
+
 /**
  * 
  */
@@ -51,8 +52,6 @@ public:
 
 	void OnBlueprintCompiled(UBlueprint* Blueprint);
 
-	void DetectGraphIssues(UEdGraph* Graph);
-
 private:
 	UPROPERTY()
 	TWeakObjectPtr<UBlueprint> BlueprintPtr;
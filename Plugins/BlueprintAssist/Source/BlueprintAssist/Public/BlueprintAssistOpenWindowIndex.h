@@ -0,0 +1,70 @@
+// Copyright fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintAssistDelayedDelegate.h"
+#include "Modules/ModuleManager.h"
+
+struct FAssetData;
+struct FOpenWindowItem_Base;
+class ISettingsContainer;
+class ISettingsSection;
+
+/**
+ * Index of the tab, settings and editor utility items listed by the open window menu (SOpenWindowMenu).
+ * Built a few ticks after the level editor is created and rebuilt (after a delay, so bursts of changes only rebuild once) when a module
+ * is loaded, a settings section is registered or an editor utility widget is added or removed.
+ * Command and asset editor tab items depend on the focused editor so they are still gathered when the menu opens.
+ */
+class BLUEPRINTASSIST_API FBAOpenWindowIndex
+{
+public:
+	using FItemArray = TArray<TSharedPtr<FOpenWindowItem_Base>>;
+
+	static FBAOpenWindowIndex& Get();
+	static void TearDown();
+
+	void Init();
+
+	void Cleanup();
+
+	void Tick();
+
+	/* Builds the index immediately if it is out of date */
+	const FItemArray& GetItems();
+
+	void MarkDirty();
+
+private:
+	FItemArray Items;
+	bool bDirty = true;
+
+	FBADelayedDelegate DelayedRebuild;
+
+	/* Rebuilding loads modules for some tabs, ignore those module changes */
+	bool bRebuilding = false;
+
+	/* Settings containers we have bound to, containers can be added at any time so they are gathered on each rebuild */
+	TArray<TWeakPtr<ISettingsContainer>> BoundSettingsContainers;
+
+	void Rebuild();
+
+	void ScheduleRebuild(int32 DelayTicks);
+
+	void OnDelayedRebuild();
+
+	void BindSettingsContainers();
+
+	void UnbindSettingsContainers();
+
+	void OnModulesChanged(FName ModuleName, EModuleChangeReason Reason);
+
+	void OnSettingsCategoryModified(const FName& CategoryName);
+
+	void OnSettingsSectionRemoved(const TSharedRef<ISettingsSection>& Section);
+
+	void OnAssetAddedOrRemoved(const FAssetData& AssetData);
+
+	static bool IsEditorUtilityWidgetAsset(const FAssetData& AssetData);
+};
@@ -35,6 +35,10 @@ public:
 	UPROPERTY(EditAnywhere, config, Category = "Cache")
 	bool bPrettyPrintCacheJSON;
 
+	/* Nodes with the same class, title, pins and pin values share one cached size. Newly placed nodes with a known shape are not measured. */
+	UPROPERTY(EditAnywhere, config, Category = "Cache")
+	bool bShareNodeSizesBetweenIdenticalNodes;
+
 	/* Use a custom blueprint action menu for creating nodes (very prototype, not supported in 5.0 or earlier) */
 	UPROPERTY(EditAnywhere, config, Category = "Misc|Experimental")
 	bool bUseCustomBlueprintActionMenu;
@@ -43,6 +47,26 @@ public:
 	UPROPERTY(EditAnywhere, config, Category = "Misc|Experimental")
 	bool bForceRefreshGraphAfterFormatting;
 
+	/* Max milliseconds per frame spent caching node sizes and formatting pending nodes, remaining work continues next frame. 0 is unlimited. */
+	UPROPERTY(EditAnywhere, config, Category = "Performance", meta = (ClampMin = 0, UIMin = 0, Units = "Milliseconds"))
+	float DeferredWorkFrameBudget;
+
+	/* Max memory (in KB) used by the caches of graph handlers for background tabs. When exceeded, the least recently focused tabs release their caches and rebuild them when focused again. 0 is unlimited. */
+	UPROPERTY(EditAnywhere, config, Category = "Performance", meta = (ClampMin = 0, UIMin = 0, Units = "Kilobytes"))
+	int32 BackgroundGraphHandlerMemoryBudget;
+
+	/* Tab and window focus changes are detected through slate events, this is the interval (in seconds) of the fallback check for changes which don't send an event */
+	UPROPERTY(EditAnywhere, config, Category = "Performance", meta = (ClampMin = 0, UIMin = 0, Units = "Seconds"))
+	float TabFocusFallbackPollInterval;
+
+	/* Lint rules which are skipped when checking graphs (Knots, DeadNodes, PureNodeInLoop, OverlappingNodes, NodesOutsideComments, LongLinkSpans) */
+	UPROPERTY(EditAnywhere, config, Category = "Graph Lint")
+	TSet<FName> DisabledLintRules;
+
+	/* Links longer than this are reported by the LongLinkSpans lint rule. 0 disables the rule. */
+	UPROPERTY(EditAnywhere, config, Category = "Graph Lint", meta = (ClampMin = 0, UIMin = 0))
+	float LintLongLinkSpan;
+
 	FORCEINLINE static const UBASettings_Advanced& Get() { return *GetDefault<UBASettings_Advanced>(); }
 	FORCEINLINE static UBASettings_Advanced& GetMutable() { return *GetMutableDefault<UBASettings_Advanced>(); }
 };
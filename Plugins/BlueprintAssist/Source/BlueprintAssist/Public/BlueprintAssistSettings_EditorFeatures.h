@@ -71,6 +71,25 @@ public:
 	UPROPERTY(EditAnywhere, Config, Category = NodeGroup, meta=(EditCondition="bDrawNodeGroupFill", EditConditionHides))
 	FLinearColor NodeGroupFillColor;
 
+	////////////////////////////////////////////////////////////
+	/// Level of detail
+	////////////////////////////////////////////////////////////
+
+	/*
+	 * When zoomed out past the threshold, hide the node widgets and draw a simple rectangle for each node and comment instead.
+	 * Useful for very large graphs where painting every node makes the editor slow.
+	 */
+	UPROPERTY(EditAnywhere, Config, Category = LevelOfDetail)
+	bool bEnableLevelOfDetail;
+
+	/* Zoom amount below which nodes are drawn as rectangles. Below half of this, nodes inside comments are only drawn as their comment. */
+	UPROPERTY(EditAnywhere, Config, Category = LevelOfDetail, meta=(EditCondition="bEnableLevelOfDetail", EditConditionHides, ClampMin = 0, ClampMax = 1, UIMin = 0, UIMax = 1))
+	float LevelOfDetailZoomThreshold;
+
+	/* Opacity of the rectangles drawn for each node, which use the node title color */
+	UPROPERTY(EditAnywhere, Config, Category = LevelOfDetail, meta=(EditCondition="bEnableLevelOfDetail", EditConditionHides, ClampMin = 0, ClampMax = 1, UIMin = 0, UIMax = 1))
+	float LevelOfDetailNodeOpacity;
+
 	////////////////////////////////////////////////////////////
 	//// Mouse Features
 	////////////////////////////////////////////////////////////
@@ -0,0 +1,83 @@
+// Copyright fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BlueprintAssistGlobals.h"
+
+#if BA_UE_VERSION_OR_LATER(5, 0)
+#include "UObject/ObjectSaveContext.h"
+#endif
+
+#if !BA_UE_VERSION_OR_LATER(5, 4)
+#include "UObject/Object.h"
+#endif
+
+class FAssetRegistryTagsContext;
+class UBlueprint;
+struct FAssetData;
+struct FBASymbolData;
+struct FGoToSymbolStruct;
+
+/**
+ * Symbols (events, graphs and variables) of every blueprint, listed by the go to symbol menu (SGoToSymbolMenu).
+ * The symbols of a blueprint are gathered whenever it is saved, and from every blueprint already in memory when the index is first used,
+ * then stored in the blueprint assist cache so blueprints never have to be loaded to find their symbols.
+ * Saved blueprints also store their symbols in a hidden asset registry tag, so blueprints never opened on this machine
+ * (e.g. saved by someone else) are indexed from the asset registry.
+ */
+class BLUEPRINTASSIST_API FBASymbolIndex
+{
+public:
+	using FItemArray = TArray<TSharedPtr<FGoToSymbolStruct>>;
+
+	static FBASymbolIndex& Get();
+	static void TearDown();
+
+	void Init();
+
+	void Cleanup();
+
+	/* Appends the symbols of every indexed blueprint except the given package */
+	void GetItems(FName ExcludedPackageName, FItemArray& OutItems);
+
+	void UpdateBlueprint(UBlueprint* Blueprint);
+
+	void RemovePackage(FName PackageName);
+
+	static void GatherSymbols(UBlueprint* Blueprint, TArray<FBASymbolData>& OutSymbols);
+
+private:
+	/* Items made from the cached symbols, built on first use */
+	TMap<FName, FItemArray> ItemsByPackage;
+	bool bItemsBuilt = false;
+	bool bBuiltAfterCacheLoaded = false;
+
+	void BuildItems();
+
+	void BuildPackageItems(FName PackageName);
+
+	/* Read the symbols tag of every blueprint in the asset registry, except the packages already gathered from memory */
+	void SeedFromAssetRegistry(const TSet<FName>& GatheredPackages);
+
+	static bool ShouldIndexBlueprint(const UBlueprint* Blueprint);
+
+	/* The symbols tag of a blueprint, from the symbols gathered when it was saved */
+	static bool GetSymbolsTagValue(const UObject* Object, FString& OutValue);
+
+#if BA_UE_VERSION_OR_LATER(5, 4)
+	void OnGetExtraObjectTags(FAssetRegistryTagsContext Context);
+#else
+	void OnGetExtraObjectTags(const UObject* Object, TArray<UObject::FAssetRegistryTag>& OutTags);
+#endif
+
+#if BA_UE_VERSION_OR_LATER(5, 0)
+	void OnObjectPreSave(UObject* Object, FObjectPreSaveContext Context);
+#else
+	void OnObjectSaved(UObject* Object);
+#endif
+
+	void OnAssetRemoved(const FAssetData& AssetData);
+
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+};
@@ -11,6 +11,9 @@ class SDockTab;
 class SWindow;
 class SGraphEditor;
 class SWidget;
+class FWeakWidgetPath;
+class FWidgetPath;
+struct FFocusEvent;
 
 /**
  * Manages tabs and their associated GraphHandlers
@@ -37,6 +40,9 @@ public:
 
 	bool ProcessTab(TSharedPtr<SDockTab> Tab);
 
+	/* Log the cache footprint of each graph handler */
+	void LogGraphHandlerStats() const;
+
 private:
 	TWeakPtr<FBAGraphHandler> ActiveGraphHandler;
 	TMap<TWeakPtr<SDockTab>, TSharedRef<FBAGraphHandler>> GraphHandlerMap;
@@ -45,6 +51,12 @@ private:
 
 	FDelegateHandle OnTabForegroundedDelegateHandle;
 	FDelegateHandle OnActiveTabChangedDelegateHandle;
+	FDelegateHandle OnFocusChangingDelegateHandle;
+	FDelegateHandle OnApplicationActivationStateChangedDelegateHandle;
+
+	// set by the tab and focus events, checked on the next tick
+	bool bFocusDirty = true;
+	float TimeSinceFallbackPoll = 0.f;
 
 	FTimerHandle ProcessTabsTimerHandle;
 	TSet<TWeakPtr<SDockTab>> TabsToProcess;
@@ -63,8 +75,17 @@ private:
 
 	void CheckActiveTabContentChanged();
 
+	void OnFocusChanging(const FFocusEvent& FocusEvent, const FWeakWidgetPath& OldFocusedWidgetPath, const TSharedPtr<SWidget>& OldFocusedWidget, const FWidgetPath& NewFocusedWidgetPath, const TSharedPtr<SWidget>& NewFocusedWidget);
+
+	void OnApplicationActivationStateChanged(bool bIsActive);
+
+	bool IsActiveGraphHandlerValid() const;
+
 	void RemoveInvalidTabs();
 
+	/* Release the caches of the least recently focused graph handlers until the background handlers fit in the memory budget */
+	void EnforceMemoryBudget();
+
 	TSharedPtr<SDockTab> GetChildTabWithGraphEditor(TSharedPtr<SWidget> Widget) const;
 
 	void ProcessTabs();
@@ -23,12 +23,15 @@ class SGraphNode;
 class SWindow;
 class FEdGraphFormatter;
 class FBAGraphHandler;
+class FBANodeLookupCache;
 class FBlueprintEditor;
 struct FPinLink;
 
-#define CAST_SLATE_WIDGET(Widget, WidgetClass) FBAUtils::CastWidgetByTypeName<WidgetClass>(Widget, #WidgetClass, false)
-#define FIND_PARENT_WIDGET(Widget, WidgetClass) FBAUtils::CastWidgetByTypeName<WidgetClass>(FBAUtils::GetParentWidgetOfType(Widget, #WidgetClass), #WidgetClass, false)
-#define FIND_CHILD_WIDGET(Widget, WidgetClass) FBAUtils::GetChildWidgetCasted<WidgetClass>(Widget, #WidgetClass)
+// the widget type name is only converted to an FName once per call site
+#define BA_WIDGET_TYPE_NAME(WidgetClass) ([]() -> const FName& { static const FName TypeName(TEXT(#WidgetClass)); return TypeName; }())
+#define CAST_SLATE_WIDGET(Widget, WidgetClass) FBAUtils::CastWidgetByTypeName<WidgetClass>(Widget, BA_WIDGET_TYPE_NAME(WidgetClass), false)
+#define FIND_PARENT_WIDGET(Widget, WidgetClass) FBAUtils::CastWidgetByTypeName<WidgetClass>(FBAUtils::GetParentWidgetOfType(Widget, BA_WIDGET_TYPE_NAME(WidgetClass)), BA_WIDGET_TYPE_NAME(WidgetClass), false)
+#define FIND_CHILD_WIDGET(Widget, WidgetClass) FBAUtils::GetChildWidgetCasted<WidgetClass>(Widget, BA_WIDGET_TYPE_NAME(WidgetClass))
 
 UENUM()
 enum class EBARoundingMethod : uint8
@@ -342,7 +345,7 @@ struct BLUEPRINTASSIST_API FBAUtils
 
 	static bool IsWidgetOfType(
 		TSharedPtr<SWidget> Widget,
-		const FString& WidgetTypeName,
+		const FName& WidgetTypeName,
 		bool bCheckContains = false);
 
 	static bool IsWidgetOfTypeFast(TSharedPtr<SWidget> Widget, const FName& WidgetTypeName);
@@ -351,7 +354,7 @@ struct BLUEPRINTASSIST_API FBAUtils
 	template <class WidgetClass>
 	static TSharedPtr<WidgetClass> CastWidgetByTypeName(
 		TSharedPtr<SWidget> Widget,
-		const FString& WidgetTypeName,
+		const FName& WidgetTypeName,
 		bool bCheckContains = false)
 	{
 		return IsWidgetOfType(Widget, WidgetTypeName, bCheckContains) ? StaticCastSharedPtr<WidgetClass>(Widget) : nullptr;
@@ -359,7 +362,7 @@ struct BLUEPRINTASSIST_API FBAUtils
 
 	static TSharedPtr<SWidget> GetChildWidget(
 		TSharedPtr<SWidget> Widget,
-		const FString& WidgetClassName,
+		const FName& WidgetClassName,
 		bool bCheckContains = false);
 
 	static TSharedPtr<SWidget> GetChildWidgetByTypes(
@@ -383,7 +386,7 @@ struct BLUEPRINTASSIST_API FBAUtils
 	template <class WidgetClass> 
 	static TSharedPtr<WidgetClass> GetChildWidgetCasted(
 		TSharedPtr<SWidget> Widget,
-		const FString& WidgetClassName,
+		const FName& WidgetClassName,
 		bool bCheckContains = false)
 	{
 		if (TSharedPtr<SWidget> ChildWidget = GetChildWidget(Widget, WidgetClassName, bCheckContains))
@@ -396,7 +399,7 @@ struct BLUEPRINTASSIST_API FBAUtils
 
 	static void GetChildWidgets(
 		TSharedPtr<SWidget> Widget,
-		const FString& WidgetClassName,
+		const FName& WidgetClassName,
 		TArray<TSharedPtr<SWidget>>& OutWidgets,
 		bool bCheckContains = false);
 
@@ -408,7 +411,7 @@ struct BLUEPRINTASSIST_API FBAUtils
 	template <class WidgetClass>
 	static void GetChildWidgetsCasted(
 		TSharedPtr<SWidget> Widget,
-		const FString& WidgetClassName,
+		const FName& WidgetClassName,
 		TArray<TSharedPtr<WidgetClass>>& OutWidgets,
 		bool bCheckContains = false)
 	{
@@ -425,7 +428,7 @@ struct BLUEPRINTASSIST_API FBAUtils
 
 	static TSharedPtr<SWidget> GetParentWidgetOfType(
 		TSharedPtr<SWidget> Widget,
-		const FString& ParentType,
+		const FName& ParentType,
 		bool bCheckContains = false);
 
 	static TSharedPtr<SWidget> ScanParentContainersForTypes(
@@ -519,6 +522,9 @@ struct BLUEPRINTASSIST_API FBAUtils
 
 	static UEdGraphNode* GetNodeFromGraph(const UEdGraph* Graph, const FGuid& NodeGuid);
 
+	/* The guid lookup cache of the active graph handler, if it is for this graph */
+	static FBANodeLookupCache* FindNodeLookupCache(const UEdGraph* Graph);
+
 	static bool IsExtraRootNode(UEdGraphNode* Node);
 
 	static void SwapNodes(UEdGraphNode* NodeA, UEdGraphNode* NodeB);
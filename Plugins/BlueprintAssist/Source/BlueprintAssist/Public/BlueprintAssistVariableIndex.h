@@ -0,0 +1,55 @@
+// Copyright fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+
+class UBlueprint;
+class UEdGraph;
+struct FVariableSelectorStruct;
+
+/**
+ * Variables listed by the variable selector menu (SVariableSelectorMenu), gathered once per blueprint skeleton class.
+ * Member variables are gathered when first requested, local variables per function graph when that graph is first requested.
+ * Everything is cleared when any blueprint is changed or compiled, since that can regenerate the properties of its children too.
+ * The items refer to their property by owner and name (see FVariableSelectorStruct::GetProperty), so a regenerated property is never read through a stale pointer.
+ */
+class BLUEPRINTASSIST_API FBAVariableIndex
+{
+public:
+	using FItemArray = TArray<TSharedPtr<FVariableSelectorStruct>>;
+
+	static FBAVariableIndex& Get();
+	static void TearDown();
+
+	void Init();
+
+	void Cleanup();
+
+	const FItemArray& GetMemberVariables(UBlueprint* Blueprint, bool bIncludeInherited);
+
+	/* Local variables of the function containing the graph */
+	const FItemArray& GetLocalVariables(UBlueprint* Blueprint, UEdGraph* Graph);
+
+	void Invalidate();
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<UClass> SkeletonClass;
+		TOptional<FItemArray> MemberVariables;
+		TOptional<FItemArray> MemberVariablesWithInherited;
+		TMap<FName, FItemArray> LocalVariablesByGraph;
+	};
+
+	TMap<TWeakObjectPtr<UBlueprint>, FEntry> Entries;
+
+	FItemArray EmptyItems;
+
+	FEntry& FindOrAddEntry(UBlueprint* Blueprint);
+
+	void OnBlueprintChanged(UBlueprint* Blueprint);
+
+	void OnModulesChanged(FName ModuleName, EModuleChangeReason Reason);
+};
@@ -0,0 +1,93 @@
+// Copyright fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class SWidget;
+class SWindow;
+class FWeakWidgetPath;
+class FWidgetPath;
+struct FFocusEvent;
+
+/**
+ * Widget type queries using interned FName types instead of comparing GetTypeAsString.
+ * Child searches are cached per window and reused until that window's generation changes (focus moving in or out of the window).
+ * A cached result is only returned if it is still a descendant of the root, otherwise the root is searched again.
+ * Failed searches are cached with the same window generation, so repeated key presses don't walk the widget tree again until the focus or active tab changes.
+ */
+class BLUEPRINTASSIST_API FBAWidgetQuery
+{
+public:
+	static FBAWidgetQuery& Get();
+	static void TearDown();
+
+	void Init();
+
+	void Cleanup();
+
+	/* Exact type match, or a case-insensitive substring match of the type name (cached per widget type) */
+	bool IsOfType(const TSharedPtr<SWidget>& Widget, FName TypeName, bool bCheckContains = false);
+
+	/* Depth first search of the root and its children, the result (or a failed search) is cached until the generation of the root's window changes, a found widget also has to still be under the root */
+	TSharedPtr<SWidget> FindChild(TSharedPtr<SWidget> Root, FName TypeName, bool bCheckContains = false);
+
+	/* Same as FindChild without using the cache */
+	TSharedPtr<SWidget> FindChildUncached(TSharedPtr<SWidget> Root, FName TypeName, bool bCheckContains = false);
+
+	void FindChildren(TSharedPtr<SWidget> Root, FName TypeName, TArray<TSharedPtr<SWidget>>& OutWidgets, bool bCheckContains = false);
+
+	TSharedPtr<SWidget> FindParent(TSharedPtr<SWidget> Widget, FName TypeName, bool bCheckContains = false);
+
+	void InvalidateWindow(TSharedPtr<SWindow> Window);
+
+	void InvalidateAll();
+
+	int32 GetNumCacheHits() const { return NumCacheHits; }
+	int32 GetNumCacheMisses() const { return NumCacheMisses; }
+
+private:
+	struct FQueryKey
+	{
+		TWeakPtr<SWidget> Root;
+		FName TypeName;
+		bool bCheckContains;
+
+		bool operator==(const FQueryKey& Other) const
+		{
+			return Root == Other.Root && TypeName == Other.TypeName && bCheckContains == Other.bCheckContains;
+		}
+
+		friend uint32 GetTypeHash(const FQueryKey& Key)
+		{
+			return HashCombine(HashCombine(GetTypeHash(Key.Root), GetTypeHash(Key.TypeName)), GetTypeHash(Key.bCheckContains));
+		}
+	};
+
+	struct FQueryResult
+	{
+		TWeakPtr<SWidget> Widget;
+		TWeakPtr<SWindow> Window;
+		uint32 Generation = 0;
+		bool bFound = false;
+	};
+
+	TMap<FQueryKey, FQueryResult> QueryCache;
+	TMap<TWeakPtr<SWindow>, uint32> WindowGenerations;
+	TMap<TPair<FName, FName>, bool> TypeContainsCache;
+
+	uint32 GlobalGeneration = 0;
+	int32 NumCacheHits = 0;
+	int32 NumCacheMisses = 0;
+
+	FDelegateHandle OnFocusChangingDelegateHandle;
+	FDelegateHandle OnActiveTabChangedDelegateHandle;
+
+	uint32 GetGeneration(const TWeakPtr<SWindow>& Window) const;
+
+	bool DoesTypeContain(FName WidgetType, FName TypeName);
+
+	static bool IsDescendantOf(TSharedPtr<SWidget> Widget, const TSharedPtr<SWidget>& Root);
+
+	void OnFocusChanging(const FFocusEvent& FocusEvent, const FWeakWidgetPath& OldFocusedWidgetPath, const TSharedPtr<SWidget>& OldFocusedWidget, const FWidgetPath& NewFocusedWidgetPath, const TSharedPtr<SWidget>& NewFocusedWidget);
+};
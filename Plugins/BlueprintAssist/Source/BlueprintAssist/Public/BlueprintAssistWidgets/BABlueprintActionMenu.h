@@ -10,8 +10,20 @@
 #include "BAFilteredList.h"
 
 class FBAGraphHandler;
+class SToolTip;
 struct FEdGraphSchemaAction;
 
+struct FBAActionMenuItemIcon
+{
+	const FSlateBrush* IconBrush = nullptr;
+	const FSlateBrush* SecondaryBrush = nullptr;
+	FSlateColor IconColor = FSlateColor::UseForeground();
+	FSlateColor SecondaryIconColor = FSlateColor::UseForeground();
+	FText ToolTipText;
+	FString DocLink;
+	FString DocExcerpt;
+};
+
 struct FBAActionMenuItem final : IBAFilteredListItem
 {
 	FBAActionMenuItem(TSharedPtr<FEdGraphSchemaAction> InAction) : Action(InAction) { }
@@ -19,6 +31,12 @@ struct FBAActionMenuItem final : IBAFilteredListItem
 	virtual FString ToString() const override;
 
 	TSharedPtr<FEdGraphSchemaAction> Action;
+
+	/* Resolved the first time a row is made for this item, items are cached between menus (see FBAActionMenuCache) */
+	TOptional<FBAActionMenuItemIcon> Icon;
+
+	/* Documentation tooltips are expensive to make so they are only made when the icon is first hovered */
+	TSharedPtr<SToolTip> ToolTip;
 };
 
 class BLUEPRINTASSIST_API SBABlueprintActionMenu final : public SCompoundWidget
@@ -36,10 +54,16 @@ class BLUEPRINTASSIST_API SBABlueprintActionMenu final : public SCompoundWidget
 
 	void Construct(const FArguments& InArgs);
 
-	void InitListItems(TArray<TSharedPtr<FBAActionMenuItem>>& Items);
+	/* Actions cached for the current context, built if there are none */
+	TSharedRef<const TArray<TSharedPtr<FBAActionMenuItem>>> GetActionItems();
+
+	/* Returns false if the actions could not be built (e.g. while saving or collecting garbage) */
+	bool InitListItems(TArray<TSharedPtr<FBAActionMenuItem>>& Items);
 
 	TSharedRef<ITableRow> CreateItemWidget(TSharedPtr<FBAActionMenuItem> Item, const TSharedRef<STableViewBase>& OwnerTable) const;
 
+	const FBAActionMenuItemIcon& GetItemIcon(TSharedPtr<FBAActionMenuItem> Item) const;
+
 	void SelectItem(TSharedPtr<FBAActionMenuItem> Item);
 
 protected:
@@ -7,6 +7,7 @@
 #include "BlueprintAssistStyle.h"
 #include "BlueprintAssistStyle.h"
 #include "EditorStyleSet.h"
+#include "BlueprintAssistMisc/BASearchIndex.h"
 #include "SlateOptMacros.h"
 #include "Framework/Application/SlateApplication.h"
 #include "Framework/Views/ITypedTableView.h"
@@ -52,6 +53,8 @@ public:
 		SLATE_EVENT(FBAOnSelectItem, OnSelectItem)
 		SLATE_EVENT(FBAOnMarkActiveSuggestion, OnMarkActiveSuggestion)
 		SLATE_EVENT(FBAOnGenerateRow, OnGenerateRow)
+		SLATE_ARGUMENT(TSharedPtr<const TArray<ItemType>>, ItemsSource)
+		SLATE_ARGUMENT(TSharedPtr<FBASearchIndex>, SearchIndex)
 		SLATE_ARGUMENT(FVector2D, WidgetSize)
 		SLATE_ARGUMENT(FString, MenuTitle)
 		SLATE_ARGUMENT(ESelectionMode::Type, SelectionMode)
@@ -70,11 +73,21 @@ public:
 	bool bCloseWhenSelecting = true;
 	FBAInitListItems InitListItems;
 
+	/* Prebuilt items shared with the owner, used instead of InitListItems so opening the menu does not copy the items */
+	TSharedPtr<const TArray<ItemType>> ItemsSource;
+
+	/* Prebuilt search index of the items source, so the owner only builds the index once */
+	TSharedPtr<FBASearchIndex> ItemsSourceSearchIndex;
+
 private:
 	FBAOnSelectItem OnSelectItem;
 	FBAOnMarkActiveSuggestion OnMarkActiveSuggestion;
 	FText FilterText;
 
+	/* The items source search index, or built from the items on the first search and reset whenever the items are regenerated */
+	TSharedPtr<FBASearchIndex> SearchIndex;
+	TArray<int32> SearchResults;
+
 public:
 	BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
 	void Construct(const FArguments& InArgs)
@@ -87,6 +100,8 @@ public:
 		bCloseWhenSelecting = InArgs._CloseWhenSelecting;
 
 		InitListItems = InArgs._InitListItems;
+		ItemsSource = InArgs._ItemsSource;
+		ItemsSourceSearchIndex = InArgs._SearchIndex;
 		GenerateItems(false);
 
 		RegisterActiveTimer(0.f, FWidgetActiveTimerDelegate::CreateSP(this, &SBAFilteredList::SetFocusPostConstruct));
@@ -183,13 +198,22 @@ public:
 	}
 	END_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
+	const TArray<ItemType>& GetAllItems() const
+	{
+		return ItemsSource.IsValid() ? *ItemsSource : AllItems;
+	}
+
 	void GenerateItems(bool bRefreshList = true)
 	{
 		AllItems.Empty();
 
-		InitListItems.Execute(AllItems);
+		if (!ItemsSource.IsValid())
+		{
+			InitListItems.Execute(AllItems);
+		}
 
-		FilteredItems = AllItems;
+		FilteredItems = GetAllItems();
+		SearchIndex = ItemsSource.IsValid() && ItemsSourceSearchIndex.IsValid() ? ItemsSourceSearchIndex : MakeShared<FBASearchIndex>();
 
 		if (bRefreshList && FilteredItemsListView.IsValid())
 		{
@@ -200,59 +224,34 @@ public:
 	void OnFilterTextChanged(const FText& InFilterText)
 	{
 		FilterText = InFilterText;
-		FString FilterString = InFilterText.ToString();
 
 		// Trim and sanitized the filter text (so that it more likely matches the action descriptions)
 		const FString TrimmedFilterString = FText::TrimPrecedingAndTrailing(InFilterText).ToString();
 
-		// Tokenize the search box text into a set of terms; all of them must be present to pass the filter
-		TArray<FString> FilterTerms;
-		TrimmedFilterString.ParseIntoArray(FilterTerms, TEXT(" "), true);
-
-		FilteredItems.Empty();
+		const TArray<ItemType>& Items = GetAllItems();
 
-		const bool bRequiresFiltering = FilterTerms.Num() > 0;
-		for (int32 ItemIndex = 0; ItemIndex < AllItems.Num(); ++ItemIndex)
+		if (TrimmedFilterString.IsEmpty())
 		{
-			ItemType Item = AllItems[ItemIndex];
-
-			// If we're filtering, search check to see if we need to show this action
-			bool bShowAction = true;
-			if (bRequiresFiltering)
-			{
-				FString SearchText = Item->GetSearchText();
-				SearchText.ReplaceInline(TEXT(" "), TEXT(""));
-
-				FString EachTermSanitized;
-				for (int32 FilterIndex = 0; FilterIndex < FilterTerms.Num() && bShowAction; ++FilterIndex)
-				{
-					const bool bMatchesTerm = SearchText.Contains(FilterTerms[FilterIndex]);
-					bShowAction = bShowAction && bMatchesTerm;
-				}
-			}
-
-			if (bShowAction)
-			{
-				FilteredItems.Add(Item);
-			}
+			FilteredItems = Items;
 		}
-
-		if (!TrimmedFilterString.IsEmpty())
+		else
 		{
-			FilteredItems.StableSort([&FilterString](const ItemType ItemA, const ItemType ItemB)
+			if (SearchIndex->Num() != Items.Num())
 			{
-				if (FilterString.Equals(ItemA->GetKeySearchText(), ESearchCase::IgnoreCase))
+				SearchIndex->Reset(Items.Num());
+				for (const ItemType& Item : Items)
 				{
-					return true;
+					SearchIndex->AddItem(Item->GetSearchText(), Item->GetKeySearchText());
 				}
+			}
 
-				if (FilterString.Equals(ItemB->GetKeySearchText(), ESearchCase::IgnoreCase))
-				{
-					return false;
-				}
+			SearchIndex->Search(TrimmedFilterString, SearchResults);
 
-				return ItemA->GetKeySearchText().Len() < ItemB->GetKeySearchText().Len();
-			});
+			FilteredItems.Reset(SearchResults.Num());
+			for (const int32 ItemIndex : SearchResults)
+			{
+				FilteredItems.Add(Items[ItemIndex]);
+			}
 		}
 
 		FilteredItemsListView->RequestListRefresh();
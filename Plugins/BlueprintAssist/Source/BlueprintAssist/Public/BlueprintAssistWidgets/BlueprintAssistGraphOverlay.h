@@ -26,6 +26,24 @@ struct FBAGraphOverlayTextParams
 	TWeakPtr<SWidget> Widget;
 };
 
+struct FBAGraphOverlayLODHiddenWidget
+{
+	TWeakPtr<SWidget> Widget;
+
+	/* Visibility before entering level of detail, restored on exit */
+	EVisibility Visibility;
+};
+
+struct FBAGraphOverlayLODEntry
+{
+	TWeakObjectPtr<UEdGraphNode> Node;
+	FSlateRect Bounds;
+	FLinearColor Color = FLinearColor::White;
+
+	/* Nodes inside a comment are only drawn as their comment at the lowest level of detail */
+	bool bInsideComment = false;
+};
+
 struct FBAGraphOverlayBounds
 {
 	float TimeRemaining = 5.0f;
@@ -53,6 +71,8 @@ class BLUEPRINTASSIST_API SBlueprintAssistGraphOverlay : public SOverlay
 
 	void Construct(const FArguments& InArgs, TSharedPtr<FBAGraphHandler> InOwnerGraphHandler);
 
+	virtual ~SBlueprintAssistGraphOverlay() override;
+
 	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
 	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
 
@@ -110,6 +130,16 @@ class BLUEPRINTASSIST_API SBlueprintAssistGraphOverlay : public SOverlay
 	void ClearAllTextOverWidgets() { TextToDraw.Empty(); }
 	bool IsDrawingTextOverWidgets() const { return TextToDraw.Num() > 0; }
 
+	bool IsLevelOfDetailActive() const { return bLevelOfDetailActive; }
+
+	/* Restore the node widgets hidden by the level of detail mode */
+	void ExitLevelOfDetail();
+
+	/* Called by the graph handler when a node moves or changes size, drops the cached bounds which include the node */
+	void InvalidateNodeBounds(UEdGraphNode* Node);
+	void InvalidateNodeGroupBounds(const FGuid& NodeGroup);
+	void InvalidateAllNodeBounds();
+
 protected:
 	TSharedPtr<FBAGraphHandler> OwnerGraphHandler;
 	TMap<FBAGraphPinHandle, FLinearColor> PinsToHighlight;
@@ -126,6 +156,54 @@ protected:
 	const FSlateBrush* CachedBorderBrush = nullptr;
 	const FSlateBrush* CachedLockBrush = nullptr;
 
+	/* Graph space bounds of the culling rect, updated at the start of each paint */
+	mutable FSlateRect VisibleGraphBounds;
+
+	/* Graph space bounds of each node group, removed when a member node moves (see InvalidateNodeBounds) */
+	mutable TMap<FGuid, FSlateRect> NodeGroupBoundsCache;
+
+	/*
+	 * Level of detail (see UBASettings_EditorFeatures::bEnableLevelOfDetail).
+	 * Node widgets are collapsed, so the panel skips them when painting, and the overlay draws a rectangle per node and comment using the cached node sizes.
+	 */
+	bool bLevelOfDetailActive = false;
+	bool bLowestLevelOfDetail = false;
+	TArray<FBAGraphOverlayLODHiddenWidget> LODHiddenNodeWidgets;
+	int32 LODNumPanelChildren = INDEX_NONE;
+	int32 LODNumGraphNodes = INDEX_NONE;
+	bool bLODBoundsDirty = false;
+	TArray<FBAGraphOverlayLODEntry> LODNodeEntries;
+	TArray<FBAGraphOverlayLODEntry> LODCommentEntries;
+
+	void UpdateLevelOfDetail();
+
+	void HideNodeWidgets(TSharedPtr<SGraphPanel> GraphPanel);
+
+	/* Gather the node colors and bounds, only called when the number of nodes changes */
+	void RebuildLevelOfDetail();
+
+	/* Update the bounds of the gathered nodes, called after a node moves or changes size (see InvalidateNodeBounds) */
+	void RefreshLevelOfDetailBounds();
+
+	void DrawLevelOfDetail(
+		FSlateWindowElementList& OutDrawElements,
+		const FGeometry& AllottedGeometry,
+		const int32 OutgoingLayer,
+		TSharedPtr<SGraphPanel> GraphPanel) const;
+
+	static FSlateRect CalculateVisibleGraphBounds(const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, TSharedPtr<SGraphPanel> GraphPanel);
+
+	bool IsGraphRectVisible(const FSlateRect& GraphBounds) const;
+
+	FSlateRect CalculateNodeGroupBounds(const TSet<TWeakObjectPtr<UEdGraphNode>>& Nodes) const;
+
+	/* Draw graph space lines, joining consecutive segments of the same color into a single polyline */
+	void DrawLineBatch(
+		FSlateWindowElementList& OutDrawElements,
+		const FGeometry& AllottedGeometry,
+		const int32 OutgoingLayer,
+		TSharedPtr<SGraphPanel> GraphPanel) const;
+
 	void DrawWidgetAsBox(
 		FSlateWindowElementList& OutDrawElements,
 		const int32 OutgoingLayer,
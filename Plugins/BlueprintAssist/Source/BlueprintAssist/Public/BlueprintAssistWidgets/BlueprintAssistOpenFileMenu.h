@@ -27,8 +27,6 @@ public:
 
 	void Construct(const FArguments& InArgs);
 
-	void InitListItems(TArray<TSharedPtr<FBAFileItem>>& Items);
-
 	TSharedRef<ITableRow> CreateItemWidget(TSharedPtr<FBAFileItem> Item, const TSharedRef<STableViewBase>& OwnerTable) const;
 
 	void SelectItem(TSharedPtr<FBAFileItem> Item);
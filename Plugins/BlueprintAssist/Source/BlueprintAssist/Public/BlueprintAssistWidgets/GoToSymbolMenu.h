@@ -5,9 +5,11 @@
 #include "CoreMinimal.h"
 
 #include "BAFilteredList.h"
+#include "UObject/SoftObjectPath.h"
 
 class UEdGraph;
 class UEdGraphNode;
+struct FBASymbolData;
 
 struct FGoToSymbolStruct final : IBAFilteredListItem
 {
@@ -22,11 +24,25 @@ struct FGoToSymbolStruct final : IBAFilteredListItem
 		: EventNode(nullptr)
 		, Graph(nullptr) { }
 
+	/* Symbol of another blueprint from the symbol index (see FBASymbolIndex), the blueprint is only loaded when the symbol is selected */
+	FGoToSymbolStruct(const FSoftObjectPath& InBlueprintPath, TSharedPtr<FBASymbolData> InIndexedSymbol)
+		: EventNode(nullptr)
+		, Graph(nullptr)
+		, BlueprintPath(InBlueprintPath)
+		, IndexedSymbol(InIndexedSymbol) { }
+
+	FSoftObjectPath BlueprintPath;
+	TSharedPtr<FBASymbolData> IndexedSymbol;
+
+	bool IsIndexedSymbol() const { return IndexedSymbol.IsValid(); }
+
 	virtual FString ToString() const override;
 
 	virtual FString GetSearchText() const override;
 
 	FString GetTypeDescription() const;
+
+	FString GetGraphName() const;
 };
 
 class BLUEPRINTASSIST_API SGoToSymbolMenu final : public SBorder
@@ -45,4 +61,8 @@ class BLUEPRINTASSIST_API SGoToSymbolMenu final : public SBorder
 	TSharedRef<ITableRow> CreateItemWidget(TSharedPtr<FGoToSymbolStruct> Item, const TSharedRef<STableViewBase>& OwnerTable) const;
 
 	void SelectItem(TSharedPtr<FGoToSymbolStruct> Item);
+
+	void SelectIndexedItem(TSharedPtr<FGoToSymbolStruct> Item);
+
+	static const FSlateBrush* GetIndexedSymbolIcon(const FBASymbolData& Symbol);
 };
@@ -34,7 +34,9 @@ struct FOpenTabItem final : FOpenWindowItem_Base
 	FName TabName;
 	FName TabIconStyle;
 	FName TabDisplayName;
-	TSharedPtr<FTabManager> AlternateTabManager;
+
+	/* Weak since the open window index keeps the items alive longer than the tab manager */
+	TWeakPtr<FTabManager> AlternateTabManager;
 
 	FSlateIcon Icon;
 
@@ -123,6 +125,7 @@ struct FOpenSettingItem final : FOpenWindowItem_Base
 	FName CategoryName;
 	FName SectionName;
 	FString SectionDisplayName;
+	FString DetailsString;
 
 	FOpenSettingItem(const FName& InContainer, const FName& InCategory, const FName& InSection)
 		: ContainerName(InContainer)
@@ -149,7 +152,12 @@ struct FOpenSettingItem final : FOpenWindowItem_Base
 
 	virtual const FString* GetDetailsString() override
 	{
-		return new FString(GetCategoryString());
+		if (DetailsString.IsEmpty())
+		{
+			DetailsString = GetCategoryString();
+		}
+
+		return &DetailsString;
 	}
 
 	bool operator==(const FOpenSettingItem& Other);
@@ -193,11 +201,17 @@ class BLUEPRINTASSIST_API SOpenWindowMenu final : public SCompoundWidget
 
 	void InitListItems(TArray<TSharedPtr<FOpenWindowItem_Base>>& Items);
 
-	void AddOpenTabItems(TArray<TSharedPtr<FOpenWindowItem_Base>>& Items);
+	/* Tab, settings and editor utility items are gathered by FBAOpenWindowIndex */
+	static void AddOpenTabItems(TArray<TSharedPtr<FOpenWindowItem_Base>>& Items);
+
+	/* Tabs of the focused asset editor, gathered when the menu opens */
+	static void AddEditorTabItems(TArray<TSharedPtr<FOpenWindowItem_Base>>& Items);
+
+	static void AddValidTabItems(const TArray<FOpenTabItem>& TabInfos, TArray<TSharedPtr<FOpenWindowItem_Base>>& Items);
 
-	void AddOpenSettingsItems(TArray<TSharedPtr<FOpenWindowItem_Base>>& Items);
+	static void AddOpenSettingsItems(TArray<TSharedPtr<FOpenWindowItem_Base>>& Items);
 
-	void AddEditorUtilityWidgets(TArray<TSharedPtr<FOpenWindowItem_Base>>& Items);
+	static void AddEditorUtilityWidgets(TArray<TSharedPtr<FOpenWindowItem_Base>>& Items);
 
 	void AddCommandItems(TArray<TSharedPtr<FOpenWindowItem_Base>>& Items);
 
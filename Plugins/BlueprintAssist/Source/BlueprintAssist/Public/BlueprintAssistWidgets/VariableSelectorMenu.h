@@ -9,7 +9,10 @@
 
 struct FVariableSelectorStruct : IBAFilteredListItem
 {
-	BA_PROPERTY* Property = nullptr;
+	/* The items are cached by FBAVariableIndex, so store the owner and name and find the property when used, in case it was regenerated */
+	TWeakObjectPtr<UStruct> PropertyOwner;
+	FName PropertyName;
+
 	TSharedPtr<class BA_SUBOBJECT_EDITOR_TREE_NODE> SCSNode;
 
 	bool bSCSNode = false;
@@ -24,6 +27,9 @@ struct FVariableSelectorStruct : IBAFilteredListItem
 
 	FString GetType() const { return bSCSNode ? "Component" : "Variable"; }
 
+	/* nullptr if the owner was destroyed or no longer has the property */
+	BA_PROPERTY* GetProperty() const;
+
 	virtual FString ToString() const override;
 };
 
@@ -46,7 +52,7 @@ class BLUEPRINTASSIST_API SVariableSelectorMenu final : public SCompoundWidget
 
 	void MarkActiveSuggestion(TSharedPtr<FVariableSelectorStruct> Item);
 
-	bool ShouldSkipProperty(BA_PROPERTY* Property);
+	static bool ShouldSkipProperty(BA_PROPERTY* Property);
 
 protected:
 	TSharedPtr<class SGraphActionMenu> ActionMenu;